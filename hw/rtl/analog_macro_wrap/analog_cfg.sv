@@ -5,6 +5,9 @@
 // Author: Jiacong Sun <jiacong.sun@kuleuven.be>
 //
 // Analog cfg module
+// With h_only_i set at dt_cfg_enable_i, only the h row is re-programmed: J memory is not read,
+// the h WWL is pulsed once with h_rdata_i and the module returns to idle after its low phase
+// (cycle_per_wwl_high_i + cycle_per_wwl_low_i + 3 cycles). The J rows keep their content.
 
 `include "common_cells/registers.svh"
 
@@ -27,6 +30,7 @@ module analog_cfg #(
     input  logic bypass_data_conversion_i,
     // data config interface <-> digital
     input  logic dt_cfg_enable_i,
+    input  logic h_only_i,
     output logic j_mem_ren_o,
     output logic [J_ADDRESS_WIDTH-1:0] j_raddr_o,
     input  logic [NUM_SPIN*BITDATA*PARALLELISM-1:0] j_rdata_i,
@@ -63,10 +67,18 @@ module analog_cfg #(
     logic j_mem_ren_p;
     logic bypass_data_conversion_reg;
     logic [NUM_SPIN*BITDATA-1:0] wbl_comb_muxed;
+    logic h_only_q, h_only_done_q;
+    logic at_h_row;
+    logic cfg_finish;
 
-    assign h_ren_o = cfg_busy & (counter_addr_q == HADDR) & (~dt_cfg_finish) & wwl_low_counter_maxed;
-    assign j_mem_ren_p = dt_cfg_enable_dly1 | 
-        (cfg_busy & (counter_addr_q != HADDR) & (wwl_low_counter_maxed) & (j_mux_sel_q == 0));
+    // h-only onloading: the h row is the only row, and it starts right away
+    assign at_h_row = h_only_q | (counter_addr_q == HADDR);
+    assign cfg_finish = h_only_q ? h_only_done_q : dt_cfg_finish;
+
+    assign h_ren_o = cfg_busy & (~cfg_finish) &
+        (h_only_q ? dt_cfg_enable_dly1 : ((counter_addr_q == HADDR) & wwl_low_counter_maxed));
+    assign j_mem_ren_p = (dt_cfg_enable_dly1 & ~h_only_q) |
+        (cfg_busy & (~at_h_row) & (wwl_low_counter_maxed) & (j_mux_sel_q == 0));
     assign j_raddr_o = counter_addr_q[J_ADDRESS_WIDTH-1:0];
     assign wbl_comb = h_ren_n ? h_rdata_i : 
                       j_mem_ren_n ? j_rdata_i[NUM_SPIN*BITDATA-1 : 0] : j_rdata_wbl;
@@ -74,17 +86,17 @@ module analog_cfg #(
     assign j_mux_sel_nxt_delayed = (j_mux_sel_q_delayed == (PARALLELISM-1)) ? 'd0 : j_mux_sel_q_delayed + 1'b1;
     assign dt_cfg_idle_o = !cfg_busy;
     assign cfg_busy_cond = en_i & dt_cfg_enable_i;
-    assign cfg_idle_cond = !en_i | (dt_cfg_finish & wwl_low_counter_maxed);
+    assign cfg_idle_cond = !en_i | (cfg_finish & wwl_low_counter_maxed);
     assign h_wwl_en_cond = en_i & h_ren_n;
     assign h_wwl_idle_cond = !en_i | (h_wwl_o & wwl_high_counter_maxed);
     assign j_one_hot_wwl_nxt = wwl_high_counter_en ? 'd0 : 
                     (counter_addr_q == 'd0 & j_mux_sel_q == 'd0) ? 'd1 : 1 << (counter_addr_q * PARALLELISM + j_mux_sel_q);
     assign j_wwl_en_cond = en_i & (j_mem_ren_n |
-        (wwl_high_counter_maxed & (counter_addr_q != HADDR))
+        (wwl_high_counter_maxed & (~at_h_row))
         | (wwl_low_counter_maxed & (j_mux_sel_q != 'd0)));
     assign j_wwl_idle_cond = cfg_idle_cond;
-    assign wbl_en_cond = en_i & (!dt_cfg_finish) & (j_mem_ren_n | h_ren_n | ((~j_mem_ren_o) & (~h_ren_o) & wwl_low_counter_maxed));
-    assign j_mux_sel_cond = en_i & wwl_high_counter_maxed & (counter_addr_q != HADDR);
+    assign wbl_en_cond = en_i & (!cfg_finish) & (j_mem_ren_n | h_ren_n | ((~j_mem_ren_o) & (~h_ren_o) & wwl_low_counter_maxed));
+    assign j_mux_sel_cond = en_i & wwl_high_counter_maxed & (~at_h_row);
     assign j_mux_sel_delayed_cond = en_i & wwl_low_counter_maxed;
     assign j_mux_sel_idle_cond = !en_i | dt_cfg_enable_i;
     assign wwl_high_counter_en_cond = en_i & (j_mem_ren_n | h_ren_n | (wwl_low_counter_maxed & (j_mux_sel_q != 'd0)));
@@ -105,6 +117,8 @@ module analog_cfg #(
     `FFLARNC(wwl_high_counter_en, 1'b1, wwl_high_counter_en_cond, wwl_high_counter_maxed, 1'b0, clk_i, rst_ni)
     `FFLARNC(wwl_low_counter_en, 1'b1, wwl_low_counter_en_cond, wwl_low_counter_maxed, 1'b0, clk_i, rst_ni)
     `FFL(bypass_data_conversion_reg, bypass_data_conversion_i, cfg_configure_enable_i, 1'b0, clk_i, rst_ni)
+    `FFL(h_only_q, h_only_i, cfg_busy_cond, 1'b0, clk_i, rst_ni)
+    `FFLARNC(h_only_done_q, 1'b1, en_i & h_only_q & h_wwl_o & wwl_high_counter_maxed, !en_i | dt_cfg_enable_i, 1'b0, clk_i, rst_ni)
 
     // Convert wbl_comb to analog macro format
     always_comb begin
@@ -189,7 +203,7 @@ module analog_cfg #(
         .load_i (cfg_configure_enable_i),
         .d_i (cfg_trans_num_i),
         .recount_en_i (dt_cfg_enable_i),
-        .step_en_i (en_i & wwl_high_counter_maxed & ((j_mux_sel_q == (PARALLELISM-1)) | (counter_addr_q == HADDR))),
+        .step_en_i (en_i & (~h_only_q) & wwl_high_counter_maxed & ((j_mux_sel_q == (PARALLELISM-1)) | (counter_addr_q == HADDR))),
         .q_o (counter_addr_q),
         .maxed_o (),
         .overflow_o (dt_cfg_finish)
@@ -43,6 +43,7 @@ module analog_macro_wrap #(
     input  logic [COUNTER_BITWIDTH-1:0] debug_spin_read_num_i,
     // data config interface <-> digital
     input  logic dt_cfg_enable_i,
+    input  logic dt_cfg_h_only_i,
     output logic j_mem_ren_o,
     output logic [J_ADDRESS_WIDTH-1:0] j_raddr_o,
     input  logic [NUM_SPIN*BITDATA*PARALLELISM-1:0] j_rdata_i,
@@ -243,6 +244,7 @@ module analog_macro_wrap #(
         .cfg_trans_num_i          (cfg_trans_num_i                           ),
         // data config interface <-> digital
         .dt_cfg_enable_i          (dt_cfg_enable_i                           ),
+        .h_only_i                 (dt_cfg_h_only_i                           ),
         .j_mem_ren_o              (j_mem_ren_o                               ),
         .j_raddr_o                (j_raddr_o                                 ),
         .j_rdata_i                (j_rdata_i                                 ),
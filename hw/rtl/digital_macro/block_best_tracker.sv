@@ -0,0 +1,95 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// Per-block best solution tracker for block-diagonal packing. With 2^blocks_log2_i independent
+// models packed on the diagonal blocks of J, block b owns the spin vector bits
+// [b*NUM_SPIN/2^n, (b+1)*NUM_SPIN/2^n). For every evaluated spin vector (valid_i), the block
+// energies are compared with the best energy seen so far for each block, and a block that
+// improved copies its own bits of spin_i into best_spin_o. best_spin_o is hence the concatenation
+// of the best spin vector of every block, which the plain energy FIFO cannot provide since it only
+// keeps the best total energy.
+// - every input is registered and applied in the next cycle, the input is never back-pressured,
+// - clear_i (level) invalidates all blocks, blocks_log2_i must only change together with clear_i.
+//
+// Parameters:
+// - NUM_SPIN: width of a spin vector
+// - ENERGY_TOTAL_BIT: bit width of the (signed) energy
+// - NUM_BLOCKS: maximum number of blocks (power of two)
+// - RD_IDX_BIT: bit width of rd_idx_i, indices of NUM_BLOCKS and above read out 0
+//
+// Port definitions:
+// - en_i: enable, inputs on valid_i are ignored when low
+// - clear_i: invalidate the best solution of every block
+// - blocks_log2_i: log2 of the number of blocks in use (clamped to log2(NUM_BLOCKS))
+// - valid_i, block_energy_i, spin_i: evaluated spin vector and its per-block energies
+// - rd_idx_i: block read out on rd_energy_o
+// - best_valid_o: per block, whether a best solution was recorded
+// - best_spin_o: best spin vector bits of every block
+
+`include "common_cells/registers.svh"
+
+module block_best_tracker #(
+    parameter int NUM_SPIN = 256,
+    parameter int ENERGY_TOTAL_BIT = 32,
+    parameter int NUM_BLOCKS = 4,
+    parameter int RD_IDX_BIT = 8,
+    // derived parameters
+    parameter int SPINIDX_BIT = $clog2(NUM_SPIN),
+    parameter int BLOCK_BIT = NUM_BLOCKS > 1 ? $clog2(NUM_BLOCKS) : 1,
+    parameter int BLOCK_LOG2_BIT = $clog2(NUM_BLOCKS) + 1
+)(
+    input logic clk_i,
+    input logic rst_ni,
+    input logic en_i,
+    input logic clear_i,
+    input logic [BLOCK_LOG2_BIT-1:0] blocks_log2_i,
+
+    input logic valid_i,
+    input logic [NUM_BLOCKS-1:0] [ENERGY_TOTAL_BIT-1:0] block_energy_i,
+    input logic [NUM_SPIN-1:0] spin_i,
+
+    input logic [RD_IDX_BIT-1:0] rd_idx_i,
+    output logic signed [ENERGY_TOTAL_BIT-1:0] rd_energy_o,
+    output logic [NUM_BLOCKS-1:0] best_valid_o,
+    output logic [NUM_SPIN-1:0] best_spin_o
+);
+    logic [BLOCK_LOG2_BIT-1:0] blocks_log2;
+    logic in_valid_q;
+    logic [NUM_BLOCKS-1:0] [ENERGY_TOTAL_BIT-1:0] in_energy_q;
+    logic [NUM_SPIN-1:0] in_spin_q;
+    logic [NUM_BLOCKS-1:0] best_valid_q;
+    logic [NUM_BLOCKS-1:0] [ENERGY_TOTAL_BIT-1:0] best_energy_q;
+    logic [NUM_BLOCKS-1:0] update;
+
+    assign blocks_log2 = (blocks_log2_i > $clog2(NUM_BLOCKS)) ? BLOCK_LOG2_BIT'($clog2(NUM_BLOCKS)) : blocks_log2_i;
+
+    // input stage
+    `FFLARNC(in_valid_q, en_i & valid_i, 1'b1, clear_i, 1'b0, clk_i, rst_ni)
+    `FFL(in_energy_q, block_energy_i, en_i & valid_i, '0, clk_i, rst_ni)
+    `FFL(in_spin_q, spin_i, en_i & valid_i, '0, clk_i, rst_ni)
+
+    // per-block comparison, blocks beyond 2^blocks_log2 are not in use
+    for (genvar k = 0; k < NUM_BLOCKS; k++) begin: gen_block
+        logic used;
+        assign used = (k >> blocks_log2) == 0;
+        assign update[k] = in_valid_q & used & (~best_valid_q[k] | ($signed(in_energy_q[k]) < $signed(best_energy_q[k])));
+        `FFLARNC(best_valid_q[k], 1'b1, update[k], clear_i, 1'b0, clk_i, rst_ni)
+        `FFL(best_energy_q[k], in_energy_q[k], update[k], '0, clk_i, rst_ni)
+    end
+
+    // a spin bit follows the update of its block
+    for (genvar j = 0; j < NUM_SPIN; j++) begin: gen_spin_bit
+        logic [BLOCK_BIT-1:0] block;
+        assign block = BLOCK_BIT'(SPINIDX_BIT'(j) >> (SPINIDX_BIT - blocks_log2));
+        `FFL(best_spin_o[j], in_spin_q[j], update[block], 1'b0, clk_i, rst_ni)
+    end
+
+    // readout
+    assign rd_energy_o = (rd_idx_i < NUM_BLOCKS) ? best_energy_q[BLOCK_BIT'(rd_idx_i)] : '0;
+    assign best_valid_o = best_valid_q;
+
+endmodule
@@ -23,9 +23,14 @@ module digital_macro #(
     parameter integer PIPESINTF = 1,
     parameter integer PIPESMID = 1,
     parameter integer PIPESFLIPFILTER = 1,
+    parameter integer PIPESJREAD = 0,
+    parameter integer EM_BATCH = 1,
     // parameters: flip manager
     parameter integer SPIN_DEPTH = 2,
     parameter integer FLIP_ICON_DEPTH = 1024,
+    parameter integer PIPESFLIPENGINE = 0,
+    parameter integer TOPK = 0,
+    parameter integer PACK_BLOCKS = 1,
     // parameters: analog wrap
     parameter integer COUNTER_BITWIDTH = 16,
     parameter integer SYNCHRONIZER_PIPEDEPTH = 3,
@@ -40,11 +45,13 @@ module digital_macro #(
     parameter integer BITH = BITJ,
     parameter integer SPIN_IDX_BIT = $clog2(NUM_SPIN),
     parameter integer FLIP_ICON_ADDR_DEPTH = $clog2(FLIP_ICON_DEPTH),
+    parameter integer SPIN_ADDR_DEPTH = (SPIN_DEPTH > 1) ? $clog2(SPIN_DEPTH) : 1,
     parameter integer DATA_J_BIT = NUM_SPIN * BITJ * PARALLELISM,
     parameter integer DATA_H_BIT = BITH * NUM_SPIN,
     parameter integer J_MEM_ADDR_WIDTH = $clog2(NUM_SPIN / PARALLELISM),
     parameter integer DEBUG_WADDR_UP_LIMIT = FLIP_ICON_DEPTH,
-    parameter integer DEBUG_WADDR_WIDTH = FLIP_ICON_ADDR_DEPTH
+    parameter integer DEBUG_WADDR_WIDTH = FLIP_ICON_ADDR_DEPTH,
+    parameter integer PACK_LOG2_BIT = $clog2(PACK_BLOCKS) + 1
 )(
     input  logic clk_i,
     input  logic rst_ni,
@@ -85,6 +92,7 @@ module digital_macro #(
     input  logic [NUM_SPIN*BITJ-1:0] wbl_floating_i,
     // data loading interface
     input  logic dt_cfg_enable_i, // load enable for the analog macro
+    input  logic dt_cfg_h_only_i, // only re-program the h row (sampled at dt_cfg_enable_i)
     output logic j_mem_ren_o,
     output logic [$clog2(NUM_SPIN / PARALLELISM)-1:0] j_raddr_o,
     input  logic [DATA_J_BIT-1:0] j_rdata_i,
@@ -93,6 +101,14 @@ module digital_macro #(
     output logic dt_cfg_idle_o,
     // runtime interface: flip manager
     input  logic en_comparison_i,
+    input  logic [1:0] accept_mode_i,
+    input  logic [15:0] accept_t_start_i,
+    input  logic [15:0] accept_t_min_i,
+    input  logic [3:0] accept_t_decay_shift_i,
+    input  logic [15:0] accept_t_interval_i,
+    input  logic [31:0] accept_seed_i,
+    output logic [15:0] accept_temp_o,
+    output logic [15:0] accept_uphill_cnt_o,
     input  logic cmpt_en_i,
     output logic cmpt_idle_o,
     input  logic host_readout_i,
@@ -101,6 +117,11 @@ module digital_macro #(
     input  logic [FLIP_ICON_ADDR_DEPTH+1-1:0] icon_last_raddr_plus_one_i,
     input  logic [NUM_SPIN-1:0] flip_rdata_i,
     input  logic flip_disable_i,
+    input  logic ring_en_i,
+    input  logic [31:0] ring_fill_cnt_i,
+    input  logic [31:0] ring_total_i,
+    output logic [31:0] ring_read_cnt_o,
+    output logic ring_stall_o,
     output logic energy_fifo_update_o,
     output logic spin_fifo_update_o,
     output logic [SPIN_DEPTH-1:0] [ENERGY_TOTAL_BIT-1:0] energy_fifo_o,
@@ -126,8 +147,36 @@ module digital_macro #(
     input  logic [NUM_SPIN*BITJ-1:0] wblb_read_i,
     // runtime interface: energy fifo
     input  logic [J_MEM_ADDR_WIDTH-1:0] dgt_addr_upper_bound_i,
+    input  logic [NUM_SPIN/PARALLELISM-1:0] dgt_nz_block_mask_i,
     // interface when ENABLE_FLIP_DETECTION = True
     input  logic enable_flip_detection_i,
+    // runtime interface: batched energy evaluation (EM_BATCH > 1, flip detection off)
+    input  logic em_batch_en_i,
+    input  logic [15:0] em_batch_timeout_i,
+    // runtime interface: top-K solutions buffer (TOPK > 0)
+    input  logic topk_en_i,
+    input  logic topk_clear_i,
+    input  logic [7:0] topk_k_i,
+    input  logic [7:0] topk_rd_idx_i,
+    output logic [7:0] topk_count_o,
+    output logic [ENERGY_TOTAL_BIT-1:0] topk_energy_o,
+    output logic [NUM_SPIN-1:0] topk_spin_o,
+    // runtime interface: block-diagonal packing (PACK_BLOCKS > 1, flip detection off)
+    input  logic pack_en_i,
+    input  logic pack_clear_i,
+    input  logic [3:0] pack_blocks_log2_i,
+    input  logic [7:0] pack_rd_idx_i,
+    output logic [7:0] pack_valid_o,
+    output logic [ENERGY_TOTAL_BIT-1:0] pack_energy_o,
+    output logic [NUM_SPIN-1:0] pack_spin_o,
+    // runtime interface: energy oracle (analog loop and flip detection off)
+    input  logic oracle_en_i,
+    input  logic oracle_spin_valid_i,
+    output logic oracle_spin_ready_o,
+    input  logic [NUM_SPIN-1:0] oracle_spin_i,
+    output logic oracle_energy_valid_o,
+    input  logic oracle_energy_ready_i,
+    output logic [ENERGY_TOTAL_BIT-1:0] oracle_energy_o,
     // debugging interface: analog model write/read
     input  logic debug_j_write_en_i,
     input  logic debug_j_read_en_i,
@@ -164,7 +213,15 @@ module digital_macro #(
     // measurement purposes
     input  logic infinite_icon_loop_en_i,
     input  logic multi_cmpt_mode_en_i,
+    input  logic multi_cmpt_hold_i, // when high, the next computation of multi-cmpt mode waits until it drops
     input  logic [CC_COUNTER_BITWIDTH-1:0] cmpt_max_num_i,
+    // checkpoint and resume
+    input  logic cmpt_pause_i, // when high, the computation stops popping spins and ends early
+    input  logic cmpt_resume_i, // when high, the next computation start restores the state below
+    input  logic [FLIP_ICON_ADDR_DEPTH:0] resume_flip_raddr_i,
+    input  logic [SPIN_DEPTH-1:0][ENERGY_TOTAL_BIT-1:0] resume_energy_i,
+    output logic [FLIP_ICON_ADDR_DEPTH:0] flip_raddr_q_o,
+    output logic [SPIN_ADDR_DEPTH-1:0] spin_fifo_head_o,
     output logic multi_cmpt_mode_idle_o,
     output logic cycle_per_iter_recount_en_o,
     output logic [FLIP_ICON_ADDR_DEPTH-1:0] fm_upstream_handshake_counter_o,
@@ -190,6 +247,11 @@ module digital_macro #(
     logic signed [ENERGY_TOTAL_BIT-1:0] em_energy_baseline_out, em_energy_baseline_in;
     logic [NUM_SPIN-1:0] ff_spin_baseline, ff_spin_baseline_pipe;
     logic [NUM_SPIN-1:0] em_spin_output, fm_spin_input;
+    logic [PACK_BLOCKS-1:0] [ENERGY_TOTAL_BIT-1:0] em_block_energy;
+    logic [PACK_LOG2_BIT-1:0] pack_blocks_log2;
+    logic oracle_sel;
+    logic em_mst_valid_fm;
+    logic em_energy_ready;
     logic flip_manager_spin_ready;
     logic fm_slv_ready;
     logic fm_mst_valid;
@@ -245,6 +307,9 @@ module digital_macro #(
     logic cmpt_idle_posedge;
     logic multi_cmpt_mode_idle_en_cond;
     logic multi_cmpt_mode_idle_reset_cond;
+    logic multi_cmpt_next_req;
+    logic multi_cmpt_next_pending;
+    logic multi_cmpt_next_start;
 
     // control logic
     assign em_upstream_handshake = em_slv_ready & em_upstream_mst_valid;
@@ -252,6 +317,15 @@ module digital_macro #(
     assign em_ef_handshake = em_weight_valid & em_weight_ready;
 
     assign hscaling_expanded = {PARALLELISM{dgt_hscaling_i}};
+    assign pack_blocks_log2 = ~pack_en_i ? '0 :
+        (pack_blocks_log2_i > $clog2(PACK_BLOCKS)) ? PACK_LOG2_BIT'($clog2(PACK_BLOCKS)) : PACK_LOG2_BIT'(pack_blocks_log2_i);
+    // in energy-oracle mode the energy monitor evaluates the spin vectors of oracle_spin_i and its
+    // energies bypass the flip manager
+    assign oracle_sel = oracle_en_i & ~en_analog_loop_i & ~enable_flip_detection_i;
+    assign em_mst_valid_fm = em_mst_valid & ~oracle_sel;
+    assign em_energy_ready = oracle_sel ? oracle_energy_ready_i : fm_slv_ready;
+    assign oracle_energy_valid_o = em_mst_valid & oracle_sel;
+    assign oracle_energy_o = em_energy_output;
     assign cmpt_en_pos_trigger = cmpt_en_i & ~cmpt_en_dly1;
     assign flush_comb = flush_i | fm_pre_config_flush;
     assign em_fifo_flush_comb = flush_comb | (enable_flip_detection_i & ~enable_flip_detection_dly1);
@@ -271,7 +345,11 @@ module digital_macro #(
     assign dt_cfg_enable_posedge   = dt_cfg_enable_i & ~dt_cfg_enable_dly1;
     assign cmpt_idle_posedge = cmpt_idle_o & ~cmpt_idle_dly1;
     assign multi_cmpt_mode_idle_en_cond = multi_cmpt_mode_en_i & cmpt_en_pos_trigger;
-    assign multi_cmpt_mode_idle_reset_cond = (multi_cmpt_idx_maxed | (~multi_cmpt_mode_en_i)) & cmpt_idle_posedge;
+    assign multi_cmpt_mode_idle_reset_cond = (multi_cmpt_idx_maxed | (~multi_cmpt_mode_en_i) | cmpt_pause_i) & cmpt_idle_posedge;
+    // the next computation of multi-cmpt mode is deferred while multi_cmpt_hold_i is high
+    // and not started at all when the computation is paused
+    assign multi_cmpt_next_req = (~multi_cmpt_mode_idle_o) & (~multi_cmpt_idx_maxed) & (~cmpt_pause_i) & cmpt_idle_posedge;
+    assign multi_cmpt_next_start = (multi_cmpt_next_req | multi_cmpt_next_pending) & ~multi_cmpt_hold_i;
 
     assign debug_fm_downstream_handshake_o = fm_downstream_handshake;
     assign debug_aw_downstream_handshake_o = aw_downstream_ready & aw_mst_valid;
@@ -279,7 +357,7 @@ module digital_macro #(
     assign debug_fm_upstream_handshake_o = fm_upstream_handshake;
 
     // data path
-    assign muxed_analog_spin = en_analog_loop_i ? analog_spin : fm_spin_out;
+    assign muxed_analog_spin = en_analog_loop_i ? analog_spin : oracle_sel ? oracle_spin_i : fm_spin_out;
     assign flip_raddr_o = flip_raddr_fm[FLIP_ICON_ADDR_DEPTH-1:0];
     assign debug_fm_spin_out_o = fm_spin_out;
     assign debug_aw_spin_out_o = analog_spin;
@@ -295,6 +373,7 @@ module digital_macro #(
     `FFL(enable_flip_detection_dly1, enable_flip_detection_i, en_ff_i, 1'b0, clk_i, rst_ni)
     `FFL(cmpt_idle_dly1, cmpt_idle_o, en_fm_i, 1'b0, clk_i, rst_ni)
     `FFLARNC(multi_cmpt_mode_idle_o, 1'b0, multi_cmpt_mode_idle_en_cond, multi_cmpt_mode_idle_reset_cond, 1'b1, clk_i, rst_ni)
+    `FFLARNC(multi_cmpt_next_pending, 1'b1, multi_cmpt_next_req, multi_cmpt_next_start | flush_i, 1'b0, clk_i, rst_ni)
 
     generate
         if (ENABLE_FLIP_DETECTION) begin: initialize_flip_filter
@@ -310,9 +389,10 @@ module digital_macro #(
             assign ff_ef_handshake = dgt_weight_ren_ff & dgt_weight_ren_ef;
 
             assign aw_downstream_ready = ff_slv_ready;
-            assign fm_downstream_slv_ready = en_analog_loop_i ? aw_slv_ready : ff_slv_ready;
+            assign fm_downstream_slv_ready = en_analog_loop_i ? aw_slv_ready : ff_slv_ready & ~oracle_sel;
+            assign oracle_spin_ready_o = ff_slv_ready & oracle_sel;
             assign em_upstream_mst_valid = ff_mst_valid;
-            assign ff_upstream_mst_valid = en_analog_loop_i ? aw_mst_valid : fm_mst_valid;
+            assign ff_upstream_mst_valid = en_analog_loop_i ? aw_mst_valid : oracle_sel ? oracle_spin_valid_i : fm_mst_valid;
             assign fm_upstream_handshake = fm_upstream_mst_valid && fm_slv_ready;
             assign weight_info_fifo_push_en = enable_flip_detection_i ? ff_ef_handshake && ~ff_empty : dgt_weight_ren_ef;
 
@@ -332,7 +412,7 @@ module digital_macro #(
                     fm_spin_input = ff_spin_baseline_pipe;
                     ff_empty_downstream_ready = fm_slv_ready;
                 end else begin: energy_monitor_path
-                    fm_upstream_mst_valid = em_mst_valid;
+                    fm_upstream_mst_valid = em_mst_valid_fm;
                     fm_energy_input = em_energy_output;
                     fm_spin_input = em_spin_output;
                     ff_empty_downstream_ready = 1'b0;
@@ -376,7 +456,7 @@ module digital_macro #(
             lagd_fifo_v3 #(
                 .FALL_THROUGH           (1'b0                          ),
                 .DATA_WIDTH             (ENERGY_TOTAL_BIT + PARALLELISM+1+J_MEM_ADDR_WIDTH+1),
-                .DEPTH                  (3                             ), // same as u_em_fifo + memory latency
+                .DEPTH                  (3 + PIPESJREAD + (PIPESJREAD > 0)), // same as u_em_fifo + memory latency
                 .RESET_VALUE            (0                             ),
                 .FLUSH_VALUE            (1                             )
             ) weight_info_fifo (
@@ -392,7 +472,9 @@ module digital_macro #(
                 .data_o                 ({em_energy_baseline_in, em_weight_valid_parallel_fifo, em_raddr_last_one_fifo, ff_raddr_em_fifo, em_double_weight_contri}),
                 .pop_i                  (em_ef_handshake               ),
                 .mem_o                  (                              ),
-                .almost_full_o          (                              )
+                .almost_full_o          (                              ),
+                .mem_load_i             (1'b0                          ),
+                .mem_i                  ('0                            )
             );
 
             flip_filter #(
@@ -410,6 +492,7 @@ module digital_macro #(
                 .enable_flip_detection_i(enable_flip_detection_i       ),
                 .flush_i                (em_fifo_flush_comb            ),
                 .raddr_upper_bound_i    (dgt_addr_upper_bound_i        ),
+                .nz_block_mask_i        (dgt_nz_block_mask_i           ),
                 .energy_baseline_i      (energy_fifo_o                 ),
                 .spin_baseline_i        (spin_fifo_o                   ),
                 .curr_baseline_valid_o  (ff_baseline_valid             ),
@@ -432,10 +515,11 @@ module digital_macro #(
         end
         else begin: energy_monitor_path_only
             assign aw_downstream_ready = em_slv_ready;
-            assign fm_downstream_slv_ready = en_analog_loop_i ? aw_slv_ready : em_slv_ready;
-            assign em_upstream_mst_valid = en_analog_loop_i ? aw_mst_valid : fm_mst_valid;
-            assign fm_upstream_mst_valid = em_mst_valid;
-            assign fm_upstream_handshake = em_mst_valid & fm_slv_ready;
+            assign fm_downstream_slv_ready = en_analog_loop_i ? aw_slv_ready : em_slv_ready & ~oracle_sel;
+            assign oracle_spin_ready_o = em_slv_ready & oracle_sel;
+            assign em_upstream_mst_valid = en_analog_loop_i ? aw_mst_valid : oracle_sel ? oracle_spin_valid_i : fm_mst_valid;
+            assign fm_upstream_mst_valid = em_mst_valid_fm;
+            assign fm_upstream_handshake = em_mst_valid_fm & fm_slv_ready;
 
             assign dgt_weight_ren_o = dgt_weight_ren_ef;
             assign dgt_weight_raddr_o = dgt_weight_raddr_ef;
@@ -478,6 +562,7 @@ module digital_macro #(
     // memory to handshake fifo for weight loading
     mem_to_handshake_fifo #(
         .DEPTH                          (2                                   ),
+        .RDATA_PIPES                    (PIPESJREAD                          ),
         .ADDR_WIDTH                     (J_MEM_ADDR_WIDTH                    ),
         .DATA_WIDTH                     (DATA_J_BIT                          )
     ) u_em_fifo (
@@ -497,7 +582,8 @@ module digital_macro #(
     );
 
     // instantiate energy monitor for h energy calculation
-    energy_monitor #(
+    // (EM_BATCH spin vectors per J sweep when em_batch_en_i is set)
+    energy_monitor_batch #(
         .BITJ                           (BITJ                                ),
         .BITH                           (BITH                                ),
         .SPIN_DEPTH                     (SPIN_DEPTH                          ),
@@ -509,13 +595,18 @@ module digital_macro #(
         .PIPESINTF                      (PIPESINTF                           ),
         .PIPESMID                       (PIPESMID                            ),
         .ENABLE_EXTERNAL_FINISH_SIGNAL  (ENABLE_FLIP_DETECTION               ),
-        .H_IS_NEGATIVE                  (H_IS_NEGATIVE                       )
+        .H_IS_NEGATIVE                  (H_IS_NEGATIVE                       ),
+        .BATCH                          (EM_BATCH                            ),
+        .TIMEOUT_BIT                    (16                                  ),
+        .NUM_BLOCKS                     (PACK_BLOCKS                         )
     ) u_energy_monitor (
         .clk_i                          (clk_i                               ),
         .rst_ni                         (rst_ni                              ),
         .en_i                           (en_em_i                             ),
         .flush_i                        (em_fifo_flush_comb                  ),
         .en_external_counter_i          (enable_flip_detection_i             ),
+        .batch_en_i                     (em_batch_en_i                       ),
+        .batch_timeout_i                (em_batch_timeout_i                  ),
         .config_valid_i                 (config_valid_em_posedge             ),
         .config_counter_i               (config_counter_i                    ),
         .config_ready_o                 (                                    ),
@@ -534,12 +625,14 @@ module digital_macro #(
         .weight_ready_o                 (em_weight_ready                     ),
         .counter_spin_o                 (counter_spin_em                     ),
         .energy_valid_o                 (em_mst_valid                        ),
-        .energy_ready_i                 (fm_slv_ready                        ),
+        .energy_ready_i                 (em_energy_ready                     ),
         .energy_o                       (em_energy_output                    ),
         .energy_baseline_out_o          (em_energy_baseline_out              ),
         .spin_o                         (em_spin_output                      ),
         .baseline_done_o                (em_baseline_done                    ),
-        .busy_o                         (em_busy                             )
+        .busy_o                         (em_busy                             ),
+        .blocks_log2_i                  (pack_blocks_log2                    ),
+        .block_energy_o                 (em_block_energy                     )
     );
 
     // instantiate flip manager's spin config module
@@ -553,7 +646,7 @@ module digital_macro #(
         .en_i                          (en_fm_i                              ),
         .flush_i                       (flush_i                              ),
         .multi_cmpt_start_i            (~multi_cmpt_mode_idle_o              ),
-        .config_start_i                (config_valid_fm_posedge | ((~multi_cmpt_mode_idle_o) & ((~multi_cmpt_idx_maxed)) & cmpt_idle_posedge) ),
+        .config_start_i                (config_valid_fm_posedge | multi_cmpt_next_start ),
         .config_spin_initial_i         (config_spin_initial_i                ),
         .config_spin_initial_skip_i    (config_spin_initial_skip_i           ),
         .fm_flush_o                    (fm_pre_config_flush                  ),
@@ -569,13 +662,23 @@ module digital_macro #(
         .NUM_SPIN                       (NUM_SPIN                            ),
         .SPIN_DEPTH                     (SPIN_DEPTH                          ),
         .ENERGY_TOTAL_BIT               (ENERGY_TOTAL_BIT                    ),
-        .FLIP_ICON_DEPTH                (FLIP_ICON_DEPTH                     )
+        .FLIP_ICON_DEPTH                (FLIP_ICON_DEPTH                     ),
+        .FLIP_PIPES                     (PIPESFLIPENGINE                     )
     ) u_flip_manager (
         .clk_i                          (clk_i                               ),
         .rst_ni                         (rst_ni                              ),
         .en_i                           (en_fm_i                             ),
         .flush_i                        (flush_comb                          ),
         .en_comparison_i                (en_comparison_i                     ),
+        .accept_mode_i                  (accept_mode_i                       ),
+        .accept_t_start_i               (accept_t_start_i                    ),
+        .accept_t_min_i                 (accept_t_min_i                      ),
+        .accept_t_decay_shift_i         (accept_t_decay_shift_i              ),
+        .accept_t_interval_i            (accept_t_interval_i                 ),
+        .accept_seed_i                  (accept_seed_i                       ),
+        .accept_seed_load_i             (cmpt_en_pos_trigger                 ),
+        .accept_temp_o                  (accept_temp_o                       ),
+        .accept_uphill_cnt_o            (accept_uphill_cnt_o                 ),
         .cmpt_en_i                      (cmpt_en_fm                          ),
         .cmpt_idle_o                    (cmpt_idle_o                         ),
         .host_readout_i                 (host_readout_i                      ),
@@ -595,6 +698,17 @@ module digital_macro #(
         .icon_last_raddr_plus_one_i     (icon_last_raddr_plus_one_i          ),
         .flip_rdata_i                   (flip_rdata_i                        ),
         .flip_disable_i                 (flip_disable_i                      ),
+        .pause_i                        (cmpt_pause_i                        ),
+        .resume_i                       (cmpt_resume_i & cmpt_en_pos_trigger ),
+        .resume_flip_raddr_i            (resume_flip_raddr_i                 ),
+        .resume_energy_i                (resume_energy_i                     ),
+        .flip_raddr_q_o                 (flip_raddr_q_o                      ),
+        .spin_fifo_head_o               (spin_fifo_head_o                    ),
+        .ring_en_i                      (ring_en_i                           ),
+        .ring_fill_cnt_i                (ring_fill_cnt_i                     ),
+        .ring_total_i                   (ring_total_i                        ),
+        .ring_read_cnt_o                (ring_read_cnt_o                     ),
+        .ring_stall_o                   (ring_stall_o                        ),
         .energy_fifo_update_o           (energy_fifo_update_o                ),
         .spin_fifo_update_o             (spin_fifo_update_o                  ),
         .energy_fifo_o                  (energy_fifo_o                       ),
@@ -602,6 +716,71 @@ module digital_macro #(
         .infinite_icon_loop_en_i        (infinite_icon_loop_en_i             )
     );
 
+    // instantiate top-K solutions buffer: every (energy, spin) pair taken by the flip manager is
+    // a candidate, the buffer is kept across the computations until topk_clear_i or flush_i
+    if (TOPK > 0) begin: gen_topk_buffer
+        localparam integer TOPK_CNT_BIT = $clog2(TOPK + 1);
+        logic [TOPK_CNT_BIT-1:0] topk_count;
+
+        topk_buffer #(
+            .NUM_SPIN                   (NUM_SPIN                            ),
+            .ENERGY_TOTAL_BIT           (ENERGY_TOTAL_BIT                    ),
+            .K                          (TOPK                                ),
+            .RD_IDX_BIT                 ($bits(topk_rd_idx_i)                )
+        ) u_topk_buffer (
+            .clk_i                      (clk_i                               ),
+            .rst_ni                     (rst_ni                              ),
+            .en_i                       (en_fm_i & topk_en_i                 ),
+            .clear_i                    (flush_i | topk_clear_i              ),
+            .k_i                        ((topk_k_i > TOPK) ? TOPK_CNT_BIT'(TOPK) : TOPK_CNT_BIT'(topk_k_i)),
+            .valid_i                    (fm_upstream_handshake & ~cmpt_idle_o),
+            .energy_i                   (fm_energy_input                     ),
+            .spin_i                     (fm_spin_input                       ),
+            .rd_idx_i                   (topk_rd_idx_i                       ),
+            .rd_energy_o                (topk_energy_o                       ),
+            .rd_spin_o                  (topk_spin_o                         ),
+            .count_o                    (topk_count                          )
+        );
+
+        assign topk_count_o = 8'(topk_count);
+    end else begin: gen_no_topk_buffer
+        assign topk_count_o = '0;
+        assign topk_energy_o = '0;
+        assign topk_spin_o = '0;
+    end
+
+    // instantiate per-block best tracker of block-diagonal packing: every spin vector taken by the
+    // flip manager is a candidate for each of its blocks, kept until pack_clear_i or flush_i
+    if (PACK_BLOCKS > 1) begin: gen_block_best_tracker
+        logic [PACK_BLOCKS-1:0] pack_valid;
+
+        block_best_tracker #(
+            .NUM_SPIN                   (NUM_SPIN                            ),
+            .ENERGY_TOTAL_BIT           (ENERGY_TOTAL_BIT                    ),
+            .NUM_BLOCKS                 (PACK_BLOCKS                         ),
+            .RD_IDX_BIT                 ($bits(pack_rd_idx_i)                )
+        ) u_block_best_tracker (
+            .clk_i                      (clk_i                               ),
+            .rst_ni                     (rst_ni                              ),
+            .en_i                       (en_fm_i & pack_en_i & ~enable_flip_detection_i),
+            .clear_i                    (flush_i | pack_clear_i              ),
+            .blocks_log2_i              (pack_blocks_log2                    ),
+            .valid_i                    (fm_upstream_handshake & ~cmpt_idle_o),
+            .block_energy_i             (em_block_energy                     ),
+            .spin_i                     (fm_spin_input                       ),
+            .rd_idx_i                   (pack_rd_idx_i                       ),
+            .rd_energy_o                (pack_energy_o                       ),
+            .best_valid_o               (pack_valid                          ),
+            .best_spin_o                (pack_spin_o                         )
+        );
+
+        assign pack_valid_o = 8'(pack_valid);
+    end else begin: gen_no_block_best_tracker
+        assign pack_valid_o = '0;
+        assign pack_energy_o = '0;
+        assign pack_spin_o = '0;
+    end
+
     // instantiate analog macro wrapper for analog interface management
     analog_macro_wrap #(
         .NUM_SPIN                       (NUM_SPIN                            ),
@@ -633,6 +812,7 @@ module digital_macro #(
         .debug_cycle_per_spin_read_i    (debug_cycle_per_spin_read_i         ),
         .debug_spin_read_num_i          (debug_spin_read_num_i               ),
         .dt_cfg_enable_i                (dt_cfg_enable_posedge               ),
+        .dt_cfg_h_only_i                (dt_cfg_h_only_i                     ),
         .j_mem_ren_o                    (j_mem_ren_o                         ),
         .j_raddr_o                      (j_raddr_o                           ),
         .j_rdata_i                      (j_rdata_i                           ),
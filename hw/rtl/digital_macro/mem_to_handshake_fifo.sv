@@ -10,7 +10,13 @@
 // Maintains a FIFO to buffer data read from memory and exposes a handshake interface to downstream
 // 
 // Parameters:
-// - DEPTH       : number of entries in the FIFO
+// - DEPTH       : number of entries in the FIFO (with RDATA_PIPES = 0)
+// - RDATA_PIPES : register stages on the memory read data before the FIFO. The FIFO is deepened by
+//                 RDATA_PIPES + 1 entries and the returned reads are counted until popped, so
+//                 that the FIFO never overflows. The read enable only depends on registered
+//                 state (a pop frees its entry one cycle later, covered by the extra entry), so
+//                 data_ready_i has no combinational path to mem_ren_o. 0 keeps the original
+//                 behaviour.
 // - ADDR_WIDTH  : width of usage / address output (derived from DEPTH)
 // - DATA_WIDTH  : bit width of each data entry
 //
@@ -27,16 +33,18 @@
 // - data_o        : data output to downstream
 //
 // Case tested:
-// - None
+// - hw/unit_tests/mem_to_handshake_fifo: RDATA_PIPES = 0, 1, 2 with 2-bit and 4-bit J
 
 `include "common_cells/registers.svh"
 
 module mem_to_handshake_fifo #(
     parameter int DEPTH = 2,
+    parameter int RDATA_PIPES = 0,
     parameter int ADDR_WIDTH = 8,
     parameter int DATA_WIDTH = 1024,
     // DO NOT OVERWRITE THIS PARAMETER
-    parameter int unsigned FIFO_ADDR_DEPTH   = (DEPTH > 1) ? $clog2(DEPTH) : 1
+    parameter int unsigned FIFO_DEPTH        = DEPTH + RDATA_PIPES + (RDATA_PIPES > 0),
+    parameter int unsigned FIFO_ADDR_DEPTH   = (FIFO_DEPTH > 1) ? $clog2(FIFO_DEPTH) : 1
 )(
     input  logic clk_i,
     input  logic rst_ni,
@@ -59,12 +67,49 @@ module mem_to_handshake_fifo #(
     logic fifo_almost_full;
     logic [ADDR_WIDTH-1:0] mem_raddr_q, mem_raddr_n;
     logic fifo_push_en;
+    logic fifo_pop_en;
+    logic [DATA_WIDTH-1:0] fifo_push_data;
 
     // Memory read logic
-    assign mem_ren_o = en_i & ~fifo_almost_full & ~flush_i;
     assign mem_raddr_o = mem_raddr_q;
     assign mem_raddr_n = (mem_raddr_q == addr_upper_bound_i) ? '0 : (mem_raddr_q + 1);
-    assign fifo_push_en = mem_rdata_valid_i;
+    assign fifo_pop_en = data_ready_i & data_valid_o;
+
+    generate
+        if (RDATA_PIPES == 0) begin: gen_rdata_direct
+            // one cycle read latency, covered by the almost full flag
+            assign mem_ren_o = en_i & ~fifo_almost_full & ~flush_i;
+            assign fifo_push_en = mem_rdata_valid_i;
+            assign fifo_push_data = mem_rdata_i;
+        end else begin: gen_rdata_pipe
+            // read data returned by the memory (in the pipe or in the FIFO), same rule as the almost
+            // full flag: the read issued in this cycle is counted when its data returns. Pops of
+            // this cycle are not credited to the read enable yet.
+            localparam int CREDIT_WIDTH = $clog2(FIFO_DEPTH + 1);
+            logic [CREDIT_WIDTH-1:0] credit_q, credit_n;
+            logic [CREDIT_WIDTH:0] credit_rd;
+
+            assign credit_n = credit_q + CREDIT_WIDTH'(mem_rdata_valid_i) - CREDIT_WIDTH'(fifo_pop_en);
+            assign credit_rd = credit_q + (CREDIT_WIDTH+1)'(mem_rdata_valid_i);
+            assign mem_ren_o = en_i & (credit_rd < FIFO_DEPTH) & ~flush_i;
+            `FFLARNC(credit_q, credit_n, 1'b1, flush_i, '0, clk_i, rst_ni)
+
+            bp_pipe #(
+                .DATAW(DATA_WIDTH),
+                .PIPES(RDATA_PIPES)
+            ) u_pipe_rdata (
+                .clk_i(clk_i),
+                .rst_ni(rst_ni),
+                .flush_i(flush_i),
+                .data_i(mem_rdata_i),
+                .data_o(fifo_push_data),
+                .valid_i(mem_rdata_valid_i),
+                .valid_o(fifo_push_en),
+                .ready_i(1'b1),
+                .ready_o()
+            );
+        end
+    endgenerate
 
     // Handshake interface logic
     assign data_valid_o = en_i & ~fifo_empty;
@@ -76,7 +121,7 @@ module mem_to_handshake_fifo #(
     lagd_fifo_v3 #(
         .FALL_THROUGH(1'b0),
         .DATA_WIDTH(DATA_WIDTH),
-        .DEPTH(DEPTH),
+        .DEPTH(FIFO_DEPTH),
         .RESET_VALUE(0),
         .FLUSH_VALUE(1)
     ) data_cache_fifo (
@@ -86,13 +131,15 @@ module mem_to_handshake_fifo #(
         .full_o(fifo_full),
         .empty_o(fifo_empty),
         .usage_o(debug_fifo_usage_o),
-        .data_i(mem_rdata_i),
+        .data_i(fifo_push_data),
         .push_none_i(1'b0),
         .push_i(fifo_push_en),
         .data_o(data_o),
-        .pop_i(data_ready_i & data_valid_o),
+        .pop_i(fifo_pop_en),
         .mem_o(),
-        .almost_full_o(fifo_almost_full)
+        .almost_full_o(fifo_almost_full),
+        .mem_load_i(1'b0),
+        .mem_i('0)
     );
 
 endmodule
\ No newline at end of file
@@ -0,0 +1,103 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// Top-K solutions buffer. Keeps the k_i (<= K) lowest-energy distinct spin vectors seen on the
+// input, sorted by increasing energy (entry 0 is the best one):
+// - every (energy, spin) pair on valid_i is registered and inserted in the next cycle, so one
+//   pair per cycle is accepted and the input is never back-pressured,
+// - a spin vector that is already in the buffer is dropped (duplicate suppression),
+// - a new entry goes after the entries with the same energy, entries pushed beyond k_i are lost,
+// - clear_i (level) empties the buffer, k_i must only change together with clear_i.
+// The buffer is read out through rd_idx_i; count_o is the number of valid entries.
+//
+// Parameters:
+// - NUM_SPIN: width of a spin vector
+// - ENERGY_TOTAL_BIT: bit width of the (signed) energy
+// - K: number of entries
+// - RD_IDX_BIT: bit width of rd_idx_i, indices of K and above read out 0
+//
+// Port definitions:
+// - en_i: enable, pairs on valid_i are ignored when low
+// - clear_i: empty the buffer
+// - k_i: number of entries in use (1 to K)
+// - valid_i, energy_i, spin_i: candidate solution
+// - rd_idx_i: entry to read out on rd_energy_o/rd_spin_o
+// - count_o: number of valid entries (entries 0 to count_o-1)
+
+`include "common_cells/registers.svh"
+
+module topk_buffer #(
+    parameter int NUM_SPIN = 256,
+    parameter int ENERGY_TOTAL_BIT = 32,
+    parameter int K = 8,
+    parameter int RD_IDX_BIT = 8,
+    // derived parameters
+    parameter int IDX_BIT = K > 1 ? $clog2(K) : 1,
+    parameter int CNT_BIT = $clog2(K + 1)
+)(
+    input logic clk_i,
+    input logic rst_ni,
+    input logic en_i,
+    input logic clear_i,
+    input logic [CNT_BIT-1:0] k_i,
+
+    input logic valid_i,
+    input logic signed [ENERGY_TOTAL_BIT-1:0] energy_i,
+    input logic [NUM_SPIN-1:0] spin_i,
+
+    input logic [RD_IDX_BIT-1:0] rd_idx_i,
+    output logic signed [ENERGY_TOTAL_BIT-1:0] rd_energy_o,
+    output logic [NUM_SPIN-1:0] rd_spin_o,
+    output logic [CNT_BIT-1:0] count_o
+);
+    logic in_valid_q;
+    logic signed [ENERGY_TOTAL_BIT-1:0] in_energy_q;
+    logic [NUM_SPIN-1:0] in_spin_q;
+    logic write;
+    logic [K-1:0] entry_valid_q;
+    logic [K-1:0] [ENERGY_TOTAL_BIT-1:0] entry_energy_q;
+    logic [K-1:0] [NUM_SPIN-1:0] entry_spin_q;
+    logic [K-1:0] dup, better, insert;
+
+    // input stage
+    `FFLARNC(in_valid_q, en_i & valid_i, 1'b1, clear_i, 1'b0, clk_i, rst_ni)
+    `FFL(in_energy_q, energy_i, en_i & valid_i, '0, clk_i, rst_ni)
+    `FFL(in_spin_q, spin_i, en_i & valid_i, '0, clk_i, rst_ni)
+
+    // The valid entries form a prefix sorted by energy, so better[] is 0...01...1 and the first
+    // set bit is the insert position. The entries from there on shift up by one.
+    assign write = in_valid_q & ~(|dup);
+
+    for (genvar k = 0; k < K; k++) begin: gen_entry
+        assign dup[k] = entry_valid_q[k] & (entry_spin_q[k] == in_spin_q);
+        assign better[k] = (CNT_BIT'(k) < k_i) & (~entry_valid_q[k] | (in_energy_q < $signed(entry_energy_q[k])));
+        if (k == 0) begin: gen_head
+            assign insert[k] = better[k];
+            `FFLARNC(entry_valid_q[k], 1'b1, write & better[k], clear_i, 1'b0, clk_i, rst_ni)
+            `FFL(entry_energy_q[k], in_energy_q, write & better[k], '0, clk_i, rst_ni)
+            `FFL(entry_spin_q[k], in_spin_q, write & better[k], '0, clk_i, rst_ni)
+        end else begin: gen_tail
+            assign insert[k] = better[k] & ~better[k-1];
+            `FFLARNC(entry_valid_q[k], insert[k] | entry_valid_q[k-1], write & better[k], clear_i, 1'b0, clk_i, rst_ni)
+            `FFL(entry_energy_q[k], insert[k] ? in_energy_q : entry_energy_q[k-1], write & better[k], '0, clk_i, rst_ni)
+            `FFL(entry_spin_q[k], insert[k] ? in_spin_q : entry_spin_q[k-1], write & better[k], '0, clk_i, rst_ni)
+        end
+    end
+
+    // readout
+    // compare the full index, so that an out-of-range read does not alias to an entry
+    assign rd_energy_o = (rd_idx_i < K) ? entry_energy_q[IDX_BIT'(rd_idx_i)] : '0;
+    assign rd_spin_o = (rd_idx_i < K) ? entry_spin_q[IDX_BIT'(rd_idx_i)] : '0;
+
+    always_comb begin
+        count_o = '0;
+        for (int k = 0; k < K; k++) begin
+            count_o = count_o + CNT_BIT'(entry_valid_q[k]);
+        end
+    end
+
+endmodule
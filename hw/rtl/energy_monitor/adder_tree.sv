@@ -6,6 +6,8 @@
 //
 // Module description:
 // Adder tree to sum up N inputs
+// The PIPES register stages are spread evenly over the adder levels (at most one per level), the
+// remaining ones are placed at the output. The latency is PIPES cycles in any case.
 //
 // Parameters:
 // -N: number of inputs
@@ -32,7 +34,18 @@ module adder_tree #(
     output logic signed [OUT_WIDTH-1:0] sum_o
 );
     localparam int STAGES = $clog2(N); // number of stages
+    localparam int TREE_PIPES = (PIPES < STAGES) ? PIPES : STAGES; // pipeline cuts inside the tree
     logic signed [STAGES:0][N-1:0][DATAW+$clog2(N)-1:0] stage_data; // data at each stage
+    logic signed [STAGES:0][N-1:0][DATAW+$clog2(N)-1:0] stage_sum; // adder outputs at each stage
+    logic [STAGES:0] stage_valid; // valid at each stage
+
+    // Whether a pipeline cut is placed after adder level lvl (1..STAGES)
+    function automatic bit is_cut(input int lvl);
+        for (int k = 0; k < TREE_PIPES; k++) begin
+            if (((k + 1) * STAGES) / (TREE_PIPES + 1) + 1 == lvl) return 1'b1;
+        end
+        return 1'b0;
+    endfunction
 
     // Generate variables
     genvar i, j;
@@ -43,12 +56,32 @@ module adder_tree #(
             assign stage_data[0][i] = $signed(data_i[i*DATAW +: DATAW]);
         end
     endgenerate
+    assign stage_valid[0] = data_valid_i;
 
     // Generate adder tree
     generate
         for (i = 0; i < STAGES; i++) begin : gen_stages
             for (j = 0; j < (N >> (i + 1)); j++) begin : gen_adders
-                assign stage_data[i+1][j] = stage_data[i][2*j] + stage_data[i][2*j + 1];
+                assign stage_sum[i+1][j] = stage_data[i][2*j] + stage_data[i][2*j + 1];
+            end
+            if (is_cut(i + 1)) begin : gen_cut
+                bp_pipe #(
+                    .DATAW((N >> (i + 1)) * (DATAW + STAGES)),
+                    .PIPES(1)
+                ) u_pipe_cut (
+                    .clk_i(clk_i),
+                    .rst_ni(rst_ni),
+                    .flush_i(flush_i),
+                    .data_i(stage_sum[i+1][(N >> (i + 1))-1:0]),
+                    .data_o(stage_data[i+1][(N >> (i + 1))-1:0]),
+                    .valid_i(stage_valid[i]),
+                    .valid_o(stage_valid[i+1]),
+                    .ready_i(1'b1),
+                    .ready_o()
+                );
+            end else begin : gen_comb
+                assign stage_data[i+1][(N >> (i + 1))-1:0] = stage_sum[i+1][(N >> (i + 1))-1:0];
+                assign stage_valid[i+1] = stage_valid[i];
             end
         end
     endgenerate
@@ -56,14 +89,14 @@ module adder_tree #(
     // Sum pipeline registers
     bp_pipe #(
         .DATAW(OUT_WIDTH),
-        .PIPES(PIPES)
+        .PIPES(PIPES - TREE_PIPES)
     ) u_pipe_sum (
         .clk_i(clk_i),
         .rst_ni(rst_ni),
         .flush_i(flush_i),
         .data_i(stage_data[STAGES][0]),
         .data_o(sum_o),
-        .valid_i(data_valid_i),
+        .valid_i(stage_valid[STAGES]),
         .valid_o(),
         .ready_i(1'b1),
         .ready_o()
@@ -7,6 +7,13 @@
 // Module description:
 // Energy monitor module.
 //
+// Block-diagonal packing: with NUM_BLOCKS > 1, the energy is also accumulated per block of spins.
+// At runtime, blocks_log2_i = n splits the spins into 2^n equal blocks (spin vector bits
+// [b*NUM_SPIN/2^n, (b+1)*NUM_SPIN/2^n) form block b). Every J row goes to the accumulator of the
+// block of its spin, so if J and h hold independent models on the diagonal blocks, block_energy_o[b]
+// is the energy of model b and the blocks sum up to energy_o. Block energies are only valid with
+// the external counter disabled, and blocks_log2_i must only change while the module is idle.
+//
 // Parameters:
 // - BITJ: bit precision of J
 // - BITH: bit precision of h
@@ -21,6 +28,7 @@
 // - PIPESMID: number of pipeline stages at the middle adder tree interface
 // - ENABLE_EXTERNAL_FINISH_SIGNAL: enable external finish signal for energy computation
 // - H_IS_NEGATIVE: whether h bias is negative
+// - NUM_BLOCKS: maximum number of packed blocks (power of two, NUM_SPIN/NUM_BLOCKS >= PARALLELISM)
 //
 // Port definitions:
 // - clk_i: input clock signal
@@ -51,6 +59,8 @@
 // - spin_o: output spin data
 // - busy_o: module busy signal
 // - baseline_done_o: baseline energy computation done signal
+// - blocks_log2_i: log2 of the number of packed blocks (clamped to log2(NUM_BLOCKS))
+// - block_energy_o: energy of each block, valid together with energy_o (unused blocks are 0)
 //
 // Case tested:
 // - BITJ=4, BITH=4, NUM_SPIN=256, SCALING_BIT=5, LOCAL_ENERGY_BIT=16, ENERGY_TOTAL_BIT=32, PIPESINTF=0/1/2
@@ -80,13 +90,15 @@ module energy_monitor #(
     parameter int PIPESMID = 0,
     parameter bit ENABLE_EXTERNAL_FINISH_SIGNAL = `False,
     parameter bit H_IS_NEGATIVE = `True,
+    parameter int NUM_BLOCKS = 1,
     // derived parameters
     parameter int MULTBIT = BITH + SCALING_BIT,
     parameter int LOCAL_ENERGY_BIT = $clog2(NUM_SPIN) + MULTBIT,
     parameter int DATAJ = NUM_SPIN * BITJ * PARALLELISM,
     parameter int DATAH = BITH * PARALLELISM,
     parameter int DATASCALING = SCALING_BIT * PARALLELISM,
-    parameter int SPINIDX_BIT = $clog2(NUM_SPIN)
+    parameter int SPINIDX_BIT = $clog2(NUM_SPIN),
+    parameter int BLOCK_LOG2_BIT = $clog2(NUM_BLOCKS) + 1
 )(
     input logic clk_i,
     input logic rst_ni,
@@ -121,7 +133,10 @@ module energy_monitor #(
     output logic [NUM_SPIN-1:0] spin_o,
 
     output logic busy_o,
-    output logic baseline_done_o
+    output logic baseline_done_o,
+
+    input logic [BLOCK_LOG2_BIT-1:0] blocks_log2_i,
+    output logic [NUM_BLOCKS-1:0] [ENERGY_TOTAL_BIT-1:0] block_energy_o
 );
     // pipe all input signals
     logic config_valid_pipe;
@@ -466,4 +481,46 @@ module energy_monitor #(
         .valid_o(cmpt_done)
     );
 
+    // Per-block accumulators for block-diagonal packing
+    if (NUM_BLOCKS > 1) begin: gen_block_energy
+        localparam int BLOCK_BIT = $clog2(NUM_BLOCKS);
+        logic [BLOCK_LOG2_BIT-1:0] blocks_log2;
+        logic [SPINIDX_BIT-1:0] block_spin_idx;
+        logic [PIPESMID:0] [BLOCK_BIT-1:0] block_idx_accum;
+
+        // the rows of one weight beat never straddle two blocks (block size >= PARALLELISM)
+        assign blocks_log2 = (blocks_log2_i > BLOCK_BIT) ? BLOCK_LOG2_BIT'(BLOCK_BIT) : blocks_log2_i;
+        assign block_spin_idx = (LITTLE_ENDIAN == `True) ? counter_q : ~counter_q;
+        assign block_idx_accum[0] = BLOCK_BIT'(block_spin_idx >> (SPINIDX_BIT - blocks_log2));
+
+        for (i = 0; i < PIPESMID; i++) begin: gen_block_idx_accum
+            `FFL(block_idx_accum[i+1], block_idx_accum[i], en_i, '0, clk_i, rst_ni);
+        end
+
+        for (i = 0; i < NUM_BLOCKS; i++) begin: gen_block_accumulator
+            logic signed [ENERGY_TOTAL_BIT-1+1:0] block_energy_doubled;
+            logic signed [ENERGY_TOTAL_BIT-1:0] block_energy_positive;
+
+            accumulator #(
+                .IN_WIDTH(LOCAL_ENERGY_BIT + $clog2(PARALLELISM)+1),
+                .ACCUM_WIDTH(ENERGY_TOTAL_BIT+1)
+            ) u_block_accumulator (
+                .clk_i(clk_i),
+                .rst_ni(rst_ni),
+                .en_i(en_i),
+                .clear_i(flush_i | energy_handshake),
+                .valid_i(weight_handshake_accum[PIPESMID] & (block_idx_accum[PIPESMID] == BLOCK_BIT'(i))),
+                .data_i(local_energy_parallel),
+                .accum_o(block_energy_doubled),
+                .overflow_o(),
+                .valid_o()
+            );
+
+            assign block_energy_positive = block_energy_doubled / 2;
+            assign block_energy_o[i] = (H_IS_NEGATIVE == `True) ? -block_energy_positive : block_energy_positive;
+        end
+    end else begin: gen_no_block_energy
+        assign block_energy_o[0] = energy_signed;
+    end
+
 endmodule
@@ -0,0 +1,217 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// J-stationary batched energy monitor. BATCH energy monitors share one weight stream, so that
+// every J row fetched from memory is used for BATCH spin vectors at once:
+// - incoming spins are dealt round-robin to the energy monitors (slot 0, 1, ..., BATCH-1),
+// - a weight beat is only handed over when all energy monitors are ready for it, so each J row
+//   is broadcast to the BATCH spin vectors of one batch (one accumulator per spin vector),
+// - energies are returned in the same round-robin order, i.e. in the order of the spins.
+// If a batch is not complete batch_timeout_i cycles after its last spin (e.g. fewer than BATCH
+// spins are in flight at the end of a computation), the remaining slots are padded with dummy
+// spins whose energies are dropped. The energy throughput is BATCH times the one of
+// energy_monitor for the same J memory bandwidth.
+// Batching only applies when batch_en_i is set and the external counter (flip detection) is
+// off. Otherwise, all transactions go to energy monitor 0 and the module behaves as
+// energy_monitor. batch_en_i must only change while the module is idle (or together with
+// flush_i). With BATCH = 1, the module is an energy_monitor.
+// The per-block energies of block-diagonal packing (NUM_BLOCKS > 1) follow energy_o.
+//
+// Parameters:
+// - BITJ, BITH, SPIN_DEPTH, NUM_SPIN, SCALING_BIT, PARALLELISM, ENERGY_TOTAL_BIT, LITTLE_ENDIAN,
+//   PIPESINTF, PIPESMID, ENABLE_EXTERNAL_FINISH_SIGNAL, H_IS_NEGATIVE, NUM_BLOCKS: see
+//   energy_monitor
+// - BATCH: number of spin vectors evaluated per J sweep (number of energy monitors)
+// - TIMEOUT_BIT: bit width of the batch timeout
+//
+// Port definitions:
+// - same as energy_monitor, plus:
+// - batch_en_i: enable the batched evaluation
+// - batch_timeout_i: cycles to wait for the next spin of an incomplete batch before padding it
+
+`include "common_cells/registers.svh"
+
+`define True 1'b1
+`define False 1'b0
+
+module energy_monitor_batch #(
+    parameter int BITJ = 4,
+    parameter int BITH = 4,
+    parameter int SPIN_DEPTH = 2,
+    parameter int NUM_SPIN = 256,
+    parameter int SCALING_BIT = 4,
+    parameter int PARALLELISM = 4,
+    parameter int ENERGY_TOTAL_BIT = 32,
+    parameter int LITTLE_ENDIAN = `True,
+    parameter int PIPESINTF = 0,
+    parameter int PIPESMID = 0,
+    parameter bit ENABLE_EXTERNAL_FINISH_SIGNAL = `False,
+    parameter bit H_IS_NEGATIVE = `True,
+    parameter int BATCH = 2,
+    parameter int TIMEOUT_BIT = 16,
+    parameter int NUM_BLOCKS = 1,
+    // derived parameters
+    parameter int DATAJ = NUM_SPIN * BITJ * PARALLELISM,
+    parameter int DATAH = BITH * PARALLELISM,
+    parameter int DATASCALING = SCALING_BIT * PARALLELISM,
+    parameter int SPINIDX_BIT = $clog2(NUM_SPIN),
+    parameter int SLOT_BIT = BATCH > 1 ? $clog2(BATCH) : 1,
+    parameter int BLOCK_LOG2_BIT = $clog2(NUM_BLOCKS) + 1
+)(
+    input logic clk_i,
+    input logic rst_ni,
+    input logic en_i,
+    input logic flush_i,
+    input logic en_external_counter_i,
+    input logic batch_en_i,
+    input logic [TIMEOUT_BIT-1:0] batch_timeout_i,
+
+    input logic config_valid_i,
+    input logic [SPINIDX_BIT-1:0] config_counter_i,
+    output logic config_ready_o,
+
+    input logic spin_valid_i,
+    input logic [NUM_SPIN-1:0] spin_i,
+    output logic spin_ready_o,
+
+    input logic weight_valid_i,
+    input logic [PARALLELISM-1:0] weight_valid_parallel_i,
+    input logic [SPINIDX_BIT-1:0] external_counter_q_i,
+    input logic external_finish_i,
+    input logic double_weight_contri_i,
+    input logic [DATAJ-1:0] weight_i,
+    input logic [DATAH-1:0] hbias_i,
+    input logic [DATASCALING-1:0] hscaling_i,
+    input logic signed [ENERGY_TOTAL_BIT-1:0] energy_baseline_in_i,
+    output logic weight_ready_o,
+    output logic [SPINIDX_BIT-1:0] counter_spin_o,
+
+    output logic energy_valid_o,
+    input logic energy_ready_i,
+    output logic signed [ENERGY_TOTAL_BIT-1:0] energy_baseline_out_o,
+    output logic signed [ENERGY_TOTAL_BIT-1:0] energy_o,
+    output logic [NUM_SPIN-1:0] spin_o,
+
+    output logic busy_o,
+    output logic baseline_done_o,
+
+    input logic [BLOCK_LOG2_BIT-1:0] blocks_log2_i,
+    output logic [NUM_BLOCKS-1:0] [ENERGY_TOTAL_BIT-1:0] block_energy_o
+);
+    logic batch_en;
+    logic pad_q;
+    logic timeout;
+    logic slot_in_handshake;
+    logic slot_out_handshake;
+    logic all_weight_ready;
+    logic [SLOT_BIT-1:0] wr_ptr, rd_ptr;
+    logic [TIMEOUT_BIT-1:0] wait_cnt;
+    logic [BATCH-1:0] dummy_q;
+    logic [BATCH-1:0] slot_spin_valid, slot_spin_ready;
+    logic [BATCH-1:0] slot_weight_valid, slot_weight_ready;
+    logic [BATCH-1:0] slot_energy_valid, slot_energy_ready;
+    logic [BATCH-1:0] slot_busy;
+    logic [BATCH-1:0] [NUM_SPIN-1:0] slot_spin_out;
+    logic [BATCH-1:0] [ENERGY_TOTAL_BIT-1:0] slot_energy;
+    logic [BATCH-1:0] [ENERGY_TOTAL_BIT-1:0] slot_energy_baseline_out;
+    logic [BATCH-1:0] [NUM_BLOCKS-1:0] [ENERGY_TOTAL_BIT-1:0] slot_block_energy;
+    logic [BATCH-1:0] [SPINIDX_BIT-1:0] slot_counter_spin;
+    logic [BATCH-1:0] slot_config_ready, slot_baseline_done;
+
+    // control logic
+    assign batch_en = (BATCH > 1) & batch_en_i & ~en_external_counter_i;
+    assign all_weight_ready = &slot_weight_ready;
+    assign slot_in_handshake = slot_spin_valid[wr_ptr] & slot_spin_ready[wr_ptr];
+    assign slot_out_handshake = slot_energy_valid[rd_ptr] & slot_energy_ready[rd_ptr];
+    // pad an incomplete batch once no spin arrived for batch_timeout_i cycles
+    assign timeout = batch_en & ~pad_q & (wr_ptr != '0) & ~spin_valid_i & (wait_cnt == batch_timeout_i);
+
+    `FFLARNC(wr_ptr, (wr_ptr == SLOT_BIT'(BATCH-1)) ? '0 : wr_ptr + 1'b1, batch_en & slot_in_handshake, flush_i, '0, clk_i, rst_ni)
+    `FFLARNC(rd_ptr, (rd_ptr == SLOT_BIT'(BATCH-1)) ? '0 : rd_ptr + 1'b1, batch_en & slot_out_handshake, flush_i, '0, clk_i, rst_ni)
+    `FFLARNC(wait_cnt, wait_cnt + 1'b1, en_i & batch_en, flush_i | slot_in_handshake | pad_q | (wr_ptr == '0), '0, clk_i, rst_ni)
+    `FFLARNC(pad_q, timeout, timeout | (pad_q & slot_in_handshake & (wr_ptr == SLOT_BIT'(BATCH-1))), flush_i, 1'b0, clk_i, rst_ni)
+
+    // spin path: spins are dealt round-robin, dummy (all-zero) spins while padding
+    assign spin_ready_o = ~pad_q & slot_spin_ready[wr_ptr];
+
+    for (genvar k = 0; k < BATCH; k++) begin: gen_slot_ctrl
+        logic dummy_set, dummy_clr;
+        assign slot_spin_valid[k] = (wr_ptr == SLOT_BIT'(k)) & (pad_q ? ~dummy_q[k] : spin_valid_i);
+        assign slot_weight_valid[k] = batch_en ? weight_valid_i & all_weight_ready : weight_valid_i & (k == 0);
+        assign slot_energy_ready[k] = (rd_ptr == SLOT_BIT'(k)) & (dummy_q[k] | energy_ready_i);
+        assign dummy_set = pad_q & slot_spin_valid[k] & slot_spin_ready[k];
+        assign dummy_clr = slot_energy_valid[k] & slot_energy_ready[k];
+        `FFLARNC(dummy_q[k], dummy_set, dummy_set | dummy_clr, flush_i, 1'b0, clk_i, rst_ni)
+    end
+
+    // weight path: a J row is only taken when every energy monitor of the batch takes it
+    assign weight_ready_o = batch_en ? all_weight_ready : slot_weight_ready[0];
+
+    // output path: energies in spin order, dummy results are dropped
+    assign energy_valid_o = slot_energy_valid[rd_ptr] & ~dummy_q[rd_ptr];
+    assign energy_o = slot_energy[rd_ptr];
+    assign spin_o = slot_spin_out[rd_ptr];
+    assign block_energy_o = slot_block_energy[rd_ptr];
+
+    // flip detection related outputs only come from energy monitor 0
+    assign config_ready_o = slot_config_ready[0];
+    assign counter_spin_o = slot_counter_spin[0];
+    assign energy_baseline_out_o = slot_energy_baseline_out[0];
+    assign baseline_done_o = slot_baseline_done[0];
+    assign busy_o = |slot_busy;
+
+    for (genvar k = 0; k < BATCH; k++) begin: gen_energy_monitor
+        energy_monitor #(
+            .BITJ                           (BITJ                              ),
+            .BITH                           (BITH                              ),
+            .SPIN_DEPTH                     (SPIN_DEPTH                        ),
+            .NUM_SPIN                       (NUM_SPIN                          ),
+            .SCALING_BIT                    (SCALING_BIT                       ),
+            .PARALLELISM                    (PARALLELISM                       ),
+            .ENERGY_TOTAL_BIT               (ENERGY_TOTAL_BIT                  ),
+            .LITTLE_ENDIAN                  (LITTLE_ENDIAN                     ),
+            .PIPESINTF                      (PIPESINTF                         ),
+            .PIPESMID                       (PIPESMID                          ),
+            .ENABLE_EXTERNAL_FINISH_SIGNAL  (ENABLE_EXTERNAL_FINISH_SIGNAL     ),
+            .H_IS_NEGATIVE                  (H_IS_NEGATIVE                     ),
+            .NUM_BLOCKS                     (NUM_BLOCKS                        )
+        ) u_energy_monitor (
+            .clk_i                          (clk_i                             ),
+            .rst_ni                         (rst_ni                            ),
+            .en_i                           (en_i                              ),
+            .flush_i                        (flush_i                           ),
+            .en_external_counter_i          (en_external_counter_i             ),
+            .config_valid_i                 (config_valid_i                    ),
+            .config_counter_i               (config_counter_i                  ),
+            .config_ready_o                 (slot_config_ready[k]              ),
+            .spin_valid_i                   (slot_spin_valid[k]                ),
+            .spin_i                         (pad_q ? '0 : spin_i               ),
+            .spin_ready_o                   (slot_spin_ready[k]                ),
+            .weight_valid_i                 (slot_weight_valid[k]              ),
+            .weight_valid_parallel_i        (weight_valid_parallel_i           ),
+            .external_counter_q_i           (external_counter_q_i              ),
+            .external_finish_i              (external_finish_i                 ),
+            .double_weight_contri_i         (double_weight_contri_i            ),
+            .weight_i                       (weight_i                          ),
+            .hbias_i                        (hbias_i                           ),
+            .hscaling_i                     (hscaling_i                        ),
+            .energy_baseline_in_i           (energy_baseline_in_i              ),
+            .weight_ready_o                 (slot_weight_ready[k]              ),
+            .counter_spin_o                 (slot_counter_spin[k]              ),
+            .energy_valid_o                 (slot_energy_valid[k]              ),
+            .energy_ready_i                 (slot_energy_ready[k]              ),
+            .energy_o                       (slot_energy[k]                    ),
+            .energy_baseline_out_o          (slot_energy_baseline_out[k]       ),
+            .spin_o                         (slot_spin_out[k]                  ),
+            .baseline_done_o                (slot_baseline_done[k]             ),
+            .busy_o                         (slot_busy[k]                      ),
+            .blocks_log2_i                  (blocks_log2_i                     ),
+            .block_energy_o                 (slot_block_energy[k]              )
+        );
+    end
+
+endmodule
@@ -5,6 +5,12 @@
 // Author: Jiacong Sun <jiacong.sun@kuleuven.be>
 //
 // flip filter module
+//
+// Zero-block skipping: nz_block_mask_i has one bit per J memory word (PARALLELISM J rows), set
+// when a row of the word or the h of its spins is non-zero. Blocks whose bit is cleared contribute
+// no energy and are never requested from the J memory, so an energy evaluation takes one cycle per
+// flipped non-zero block. A spin vector that only flips spins of zero blocks is handled as an
+// unchanged one (baseline energy). The mask must have at least one bit set.
 
 `include "common_cells/registers.svh"
 
@@ -27,6 +33,7 @@ module flip_filter #(
     input  logic                        flush_i,
     // configuration inputs
     input  logic [ADDR_WIDTH-1      :0] raddr_upper_bound_i,
+    input  logic [NUM_BLOCK-1       :0] nz_block_mask_i,
 
     // baseline energy and spin inputs
     input  wire [SPIN_DEPTH-1:0] [ENERGY_TOTAL_BIT-1:0] energy_baseline_i,
@@ -66,6 +73,7 @@ module flip_filter #(
     logic [$clog2(SPIN_DEPTH)-1:0] baseline_idx;
     logic baseline_idx_maxed;
     logic [NUM_SPIN-1:0] bits_flipped_comb, bits_flipped_comb_muxed, bits_flipped_reg, bits_flipped_merged;
+    logic [NUM_SPIN-1:0] nz_bits_mask, bits_flipped_nz;
     logic busy_en_cond, busy_reset_cond;
     logic raddr_last_one_gen;
     logic busy_reg;
@@ -101,7 +109,7 @@ module flip_filter #(
 
     assign spin_upstream_ready_pipe = !busy_reg & spin_downstream_ready_i;
     assign spin_downstream_valid_o = ~empty_o & spin_upstream_handshake_pipe;
-    assign empty_o = ~(|bits_flipped_merged);
+    assign empty_o = ~(|bits_flipped_nz);
 
     assign curr_baseline_valid = curr_baseline_valid_reg;
     assign curr_baseline_valid_o = curr_baseline_valid;
@@ -117,6 +125,7 @@ module flip_filter #(
     assign spin_downstream_o = spin_upstream_pipe;
     assign raddr_o = raddr_gen;
     assign bits_flipped_merged = spin_upstream_handshake_pipe ? bits_flipped_comb : bits_flipped_reg;
+    assign bits_flipped_nz = bits_flipped_merged & nz_bits_mask;
     assign bits_flipped_comb = (curr_baseline_valid & spin_upstream_handshake_pipe & enable_flip_detection_i) ? (spin_baseline_selected ^ spin_upstream_pipe) : {NUM_SPIN{1'b1}};
     assign bits_flipped_comb_muxed = empty_o ? {NUM_SPIN{1'b1}} : bits_flipped_comb;
     assign bits_unflipped_o = curr_baseline_valid ? ~bits_flipped_merged : {NUM_SPIN{1'b1}};
@@ -134,6 +143,11 @@ module flip_filter #(
         end
     end
 
+    // the mask is indexed by J memory address, spin block i is read at address NUM_BLOCK-1-i unless LITTLE_ENDIAN
+    for (genvar i = 0; i < NUM_BLOCK; i++) begin: gen_nz_bits_mask
+        assign nz_bits_mask[i*PARALLELISM +: PARALLELISM] = {PARALLELISM{nz_block_mask_i[LITTLE_ENDIAN ? i : NUM_BLOCK-1-i]}};
+    end
+
     always_comb begin
         block_bits_flipped_o = {PARALLELISM{1'b1}};
         if (curr_baseline_valid) begin
@@ -204,7 +218,7 @@ module flip_filter #(
         .en_i                   ( en_i                          ),
         .flush_i                ( flush_i                       ),
         .req_valid_i            ( spin_upstream_handshake_pipe  ),
-        .req_i                  ( bits_flipped_merged           ),
+        .req_i                  ( bits_flipped_nz               ),
         .addr_upper_bound_i     ( raddr_upper_bound_i           ),
         .idx_valid_o            ( valid_gen                     ),
         .idx_ready_i            ( raddr_ready_i                 ),
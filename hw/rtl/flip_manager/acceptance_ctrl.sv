@@ -0,0 +1,114 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// Acceptance rule of the energy FIFO maintainer. A new spin vector is accepted when
+// delta = E_new - E_old < threshold_o, where the threshold depends on mode_i:
+// - ACCEPT_GREEDY (0): threshold 0, i.e. only strictly lower energies are accepted,
+// - ACCEPT_THRESHOLD (1): threshold T (threshold accepting),
+// - ACCEPT_METROPOLIS (2): threshold T * (-ln u), u uniform in (0, 1). This accepts an uphill
+//   move with probability P(u < exp(-delta/T)) = exp(-delta/T), the Metropolis rule, without a
+//   division: -ln u is read from a 64-entry lookup table (UQ3.5) indexed by a xorshift32 RNG.
+// The temperature T (in energy units) starts at t_start_i on every computation (restart_i) and
+// cools geometrically: every t_interval_i evaluations (step_i), T <- T - (T >> t_decay_shift_i),
+// floored at t_min_i. t_decay_shift_i = 0 keeps T constant.
+// The threshold is registered together with the state it is derived from, so the comparison
+// itself stays a subtraction and a compare.
+//
+// Parameters:
+// - ENERGY_TOTAL_BIT: bit width of the (signed) energy
+// - TEMP_BIT: bit width of the temperature
+//
+// Ports:
+// - restart_i: start of a computation, reloads T
+// - seed_load_i: reloads the RNG with seed_i (0 is replaced by 1)
+// - step_i: one energy evaluation, advances the RNG and the cooling schedule
+// - threshold_o: acceptance threshold of the next evaluation (>= 0)
+// - temp_o: current temperature
+
+`include "common_cells/registers.svh"
+
+module acceptance_ctrl #(
+    parameter int ENERGY_TOTAL_BIT = 32,
+    parameter int TEMP_BIT = 16
+)(
+    input  logic clk_i,
+    input  logic rst_ni,
+    input  logic restart_i,
+    input  logic seed_load_i,
+    input  logic step_i,
+    input  logic [1:0] mode_i,
+    input  logic [TEMP_BIT-1:0] t_start_i,
+    input  logic [TEMP_BIT-1:0] t_min_i,
+    input  logic [3:0] t_decay_shift_i,
+    input  logic [15:0] t_interval_i,
+    input  logic [31:0] seed_i,
+    output logic signed [ENERGY_TOTAL_BIT:0] threshold_o,
+    output logic [TEMP_BIT-1:0] temp_o
+);
+    localparam logic [1:0] ACCEPT_GREEDY = 2'd0;
+    localparam logic [1:0] ACCEPT_THRESHOLD = 2'd1;
+    localparam logic [1:0] ACCEPT_METROPOLIS = 2'd2;
+
+    // round(-ln((k + 0.5) / 64) * 32)
+    localparam logic [7:0] NEG_LN_LUT [64] = '{
+        8'd155, 8'd120, 8'd104, 8'd93, 8'd85, 8'd79, 8'd73, 8'd69,
+        8'd65, 8'd61, 8'd58, 8'd55, 8'd52, 8'd50, 8'd48, 8'd45,
+        8'd43, 8'd41, 8'd40, 8'd38, 8'd36, 8'd35, 8'd33, 8'd32,
+        8'd31, 8'd29, 8'd28, 8'd27, 8'd26, 8'd25, 8'd24, 8'd23,
+        8'd22, 8'd21, 8'd20, 8'd19, 8'd18, 8'd17, 8'd16, 8'd15,
+        8'd15, 8'd14, 8'd13, 8'd12, 8'd12, 8'd11, 8'd10, 8'd10,
+        8'd9, 8'd8, 8'd8, 8'd7, 8'd6, 8'd6, 8'd5, 8'd5,
+        8'd4, 8'd3, 8'd3, 8'd2, 8'd2, 8'd1, 8'd1, 8'd0
+    };
+
+    logic [TEMP_BIT-1:0] temp_q, temp_d, temp_cooled;
+    logic [15:0] step_cnt_q, step_cnt_d;
+    logic cool;
+    logic [31:0] rng_q, rng_d, rng_x1, rng_x2;
+    logic [TEMP_BIT+7:0] metropolis_thr;
+    logic signed [ENERGY_TOTAL_BIT:0] threshold_d;
+
+    // cooling schedule
+    assign cool = step_i & (t_decay_shift_i != '0) & (step_cnt_q + 1'b1 >= t_interval_i);
+    assign temp_cooled = temp_q - (temp_q >> t_decay_shift_i);
+    assign step_cnt_d = (restart_i | cool) ? '0 : step_cnt_q + 1'b1;
+
+    always_comb begin
+        temp_d = temp_q;
+        if (restart_i) begin
+            temp_d = t_start_i;
+        end else if (cool) begin
+            temp_d = (temp_cooled < t_min_i) ? t_min_i : temp_cooled;
+        end
+    end
+
+    `FFL(temp_q, temp_d, restart_i | cool, '0, clk_i, rst_ni)
+    `FFL(step_cnt_q, step_cnt_d, restart_i | step_i, '0, clk_i, rst_ni)
+
+    // xorshift32 RNG
+    assign rng_x1 = rng_q ^ (rng_q << 13);
+    assign rng_x2 = rng_x1 ^ (rng_x1 >> 17);
+    assign rng_d = seed_load_i ? ((seed_i == '0) ? 32'd1 : seed_i) : rng_x2 ^ (rng_x2 << 5);
+
+    `FFL(rng_q, rng_d, seed_load_i | step_i, 32'd1, clk_i, rst_ni)
+
+    // threshold of the next evaluation, from the next temperature and random number
+    assign metropolis_thr = temp_d * NEG_LN_LUT[rng_d[31:26]];
+
+    always_comb begin
+        case (mode_i)
+            ACCEPT_THRESHOLD: threshold_d = (ENERGY_TOTAL_BIT+1)'(temp_d);
+            ACCEPT_METROPOLIS: threshold_d = (ENERGY_TOTAL_BIT+1)'(metropolis_thr >> 5);
+            default: threshold_d = '0;
+        endcase
+    end
+
+    `FFL(threshold_o, threshold_d, restart_i | seed_load_i | step_i, '0, clk_i, rst_ni)
+
+    assign temp_o = temp_q;
+
+endmodule
@@ -22,8 +22,9 @@
 //   pushed into an internal energy FIFO (energy_fifo).
 // - The combinational head of the FIFO is available as energy_pop.
 // - When a new energy value is presented, the module compares it to the FIFO
-//   head; if energy_i >= energy_pop the module asserts spin_push_none_o to
-//   indicate the energy can satisfy the stored requirement (no spin push needed).
+//   head; if energy_i - energy_pop >= accept_threshold_i the module asserts
+//   spin_push_none_o to indicate the new spin is rejected (no spin push needed).
+//   A threshold of 0 keeps only strictly lower energies (see acceptance_ctrl).
 // - Provides a simple spin handshake:
 //     * Incoming spins are accepted on (spin_valid_i, spin_ready_o) and
 //       captured into an internal spin register when accepted.
@@ -32,11 +33,15 @@
 //     * spin_valid_o indicates a spin available to downstream and is gated by
 //       the energy handshake / internal register state.
 // - flush_i clears FIFO and related registered state.
+// - energy_load_i overwrites the FIFO memory with energy_load_data_i (restore of a
+//   checkpoint); the pointers are left as they are.
 // - debug_fifo_usage_o exposes the FIFO usage count from the energy FIFO.
+// - uphill_accept_o pulses when a new energy is accepted although it is not lower than the
+//   FIFO head (threshold accepting or Metropolis, with a positive threshold).
 //
 // Notes:
 // - The energy FIFO used here is lagd_fifo_v3 instantiated as energy_fifo.
-// - spin_push_none_o is driven by the comparison (energy_i >= energy_pop)
+// - spin_push_none_o is driven by the comparison (energy_i - energy_pop >= accept_threshold_i)
 //   and latched for downstream observation.
 
 `include "common_cells/registers.svh"
@@ -53,6 +58,7 @@ module energy_fifo_maintainer #(
 
     input logic flush_i,
     input logic en_comparison_i,
+    input logic signed [ENERGY_TOTAL_BIT:0] accept_threshold_i,
 
     output logic spin_valid_o,
     output logic [NUM_SPIN-1:0] spin_o,
@@ -64,7 +70,11 @@ module energy_fifo_maintainer #(
     input logic [NUM_SPIN-1:0] spin_i,
     input logic signed [ENERGY_TOTAL_BIT-1:0] energy_i,
 
+    input logic energy_load_i,
+    input logic signed [SPIN_DEPTH-1:0] [ENERGY_TOTAL_BIT-1:0] energy_load_data_i,
+
     output logic [ADDR_DEPTH-1:0] debug_fifo_usage_o,
+    output logic uphill_accept_o,
     output logic signed [SPIN_DEPTH-1:0] [ENERGY_TOTAL_BIT-1:0] energy_fifo_o
 );
 
@@ -75,6 +85,7 @@ module energy_fifo_maintainer #(
     logic fifo_push_comb;
     logic fifo_push_none_comb;
     logic signed [ENERGY_TOTAL_BIT-1:0] energy_pop;
+    logic signed [ENERGY_TOTAL_BIT:0] energy_delta;
     logic energy_handshake;
     logic spin_handshake_n;
     logic [NUM_SPIN-1:0] spin_reg;
@@ -102,18 +113,22 @@ module energy_fifo_maintainer #(
         .data_o(energy_pop),
         .pop_i(fifo_pop_comb),
         .mem_o(energy_fifo_o),
-        .almost_full_o()
+        .almost_full_o(),
+        .mem_load_i(energy_load_i),
+        .mem_i(energy_load_data_i)
     );
 
     // Control logic
     assign energy_ready_o = ~fifo_full & spin_ready_pipe;
     assign energy_handshake = energy_valid_i & energy_ready_o;
     assign fifo_push_comb = energy_handshake;
-    assign fifo_push_none_comb = en_comparison_i & (energy_i >= energy_pop);
+    assign energy_delta = energy_i - energy_pop;
+    assign fifo_push_none_comb = en_comparison_i & (energy_delta >= accept_threshold_i);
     assign fifo_pop_comb = spin_handshake_n;
     assign spin_handshake_n = spin_valid_o & spin_ready_i;
 
     assign spin_push_none_comb = fifo_push_none_comb;
+    assign uphill_accept_o = energy_handshake & en_comparison_i & ~fifo_push_none_comb & (energy_delta >= 0);
 
     // Sequential logic
     `FFLARNC(spin_push_none_o, spin_push_none_comb, energy_handshake, flush_i, 1'b0, clk_i, rst_ni);
@@ -20,6 +20,8 @@
 // - NUM_SPIN               : bit width of each spin vector.
 // - FLIP_ICON_DEPTH        : number of flip-icon entries to read.
 // - FLIP_ICON_ADDR_DEPTH   : address width for flip-icon reads (derived).
+// - PIPES                  : register stages (bp_pipe) after the flip mask, on the path from
+//                            the flip memory read data to flipped_spin_o.
 //
 // Key behaviour:
 // - When en_i is asserted and the input handshake (prev_spin_valid_i & prev_spin_ready_o)
@@ -36,6 +38,14 @@
 //   cmpt_en_i is asserted or a new input spin handshake occurs, provided flush_i
 //   and flip_disable_i are not asserted.
 // - flush_i clears internal registered state and inhibits activity.
+// - flip_raddr_load_i loads flip_raddr_load_value_i into the read address register
+//   (restore of a checkpoint); flip_raddr_q_o exposes the register (icons read).
+// - ring_en_i streams a flip schedule longer than the flip memory: the icons are read
+//   circularly (as with infinite_icon_loop_en_i) while the host refills the memory behind the
+//   read pointer. ring_fill_cnt_i is the number of icons written by the host so far and
+//   ring_read_cnt_o the number of icons read since the last flush. No spin is accepted while
+//   the ring is empty (ring_stall_o if a spin is waiting), and icon_finish_o is asserted once
+//   ring_total_i icons are read.
 //
 // Ports (summary):
 // - clk_i, rst_ni         : clock and async active-low reset
@@ -53,6 +63,10 @@
 // - flip_rdata_i          : read data from flip-icon memory
 // - icon_finish_o         : asserted when final flip-icon entry is read
 // - flip_disable_i  : bypass flipping and inhibit icon reads
+// - flip_raddr_load_i, flip_raddr_load_value_i : read address restore
+// - flip_raddr_q_o        : read address register
+// - ring_en_i, ring_fill_cnt_i, ring_total_i : flip memory ring buffer mode
+// - ring_read_cnt_o, ring_stall_o : icons read, stalled on an empty ring
 //
 // Notes:
 // - Internal state (flipped data, valid flag, read address, and a registered
@@ -65,7 +79,8 @@ module flip_engine #(
     parameter int SPIN_DEPTH = 2,
     parameter int NUM_SPIN = 256,
     parameter int FLIP_ICON_DEPTH = 1024,
-    parameter int FLIP_ICON_ADDR_DEPTH = $clog2(FLIP_ICON_DEPTH)
+    parameter int FLIP_ICON_ADDR_DEPTH = $clog2(FLIP_ICON_DEPTH),
+    parameter int PIPES = 0
 )(
     input logic clk_i,
     input logic rst_ni,
@@ -89,7 +104,17 @@ module flip_engine #(
 
     output logic icon_finish_o,
 
+    input logic flip_raddr_load_i,
+    input logic [FLIP_ICON_ADDR_DEPTH+1-1:0] flip_raddr_load_value_i,
+    output logic [FLIP_ICON_ADDR_DEPTH+1-1:0] flip_raddr_q_o,
+
     input logic flip_disable_i,
+    // flip memory ring buffer
+    input logic ring_en_i,
+    input logic [31:0] ring_fill_cnt_i,
+    input logic [31:0] ring_total_i,
+    output logic [31:0] ring_read_cnt_o,
+    output logic ring_stall_o,
     // for measurement purposes
     input logic infinite_icon_loop_en_i
 );
@@ -111,9 +136,13 @@ module flip_engine #(
     logic flip_disable_reg;
     logic prev_hdsk_cnt_maxed;
     logic flip_disable_reg_flush_cond;
+    logic pipe_ready;
+    logic [NUM_SPIN-1:0] flipped_spin_comb;
+    logic flipped_spin_valid_pipe, flipped_spin_ready_pipe;
+    logic ring_empty, ring_done;
 
     // Data logic
-    assign flipped_spin_o = flip_disable_i ? prev_spin_pipe : (prev_spin_pipe ^ flip_icon);
+    assign flipped_spin_comb = flip_disable_i ? prev_spin_pipe : (prev_spin_pipe ^ flip_icon);
 
     assign flip_raddr_n = (flip_raddr_reg == icon_last_raddr_plus_one_i) ? {{(FLIP_ICON_ADDR_DEPTH){1'b0}}, 1'b1} : flip_raddr_reg + 1'b1;
 
@@ -125,17 +154,23 @@ module flip_engine #(
     assign flip_disable_reg_flush_cond = flush_i | (~flip_disable_i);
 
     assign flip_ren_p = en_i & prev_spin_handshake & (~flush_i) & (~flip_disable_i);
-    assign icon_fifo_empty_comb = (~infinite_icon_loop_en_i) & (flip_raddr_reg == icon_last_raddr_plus_one_i);
+    assign ring_empty = ring_en_i & (~flip_disable_i) & (ring_read_cnt_o == ring_fill_cnt_i);
+    assign ring_done = ring_en_i & (ring_read_cnt_o == ring_total_i);
+    assign prev_spin_ready_o = pipe_ready & (~ring_empty);
+    assign ring_stall_o = ring_empty & prev_spin_valid_i;
+    assign icon_fifo_empty_comb = ring_en_i ? ring_done : (~infinite_icon_loop_en_i) & (flip_raddr_reg == icon_last_raddr_plus_one_i);
     assign flip_ren_o = flip_ren_p;
     assign flip_raddr_o = (flip_raddr_reg == icon_last_raddr_plus_one_i) ? {{(FLIP_ICON_ADDR_DEPTH){1'b0}}, 1'b0} : flip_raddr_reg;
     assign icon_finish_o = flip_disable_reg || (icon_finish_reg || icon_fifo_empty_comb);
+    assign flip_raddr_q_o = flip_raddr_reg;
 
     // Sequential logic
     `FFLARNC(icon_finish_reg, icon_fifo_empty_comb, en_i, flush_i, 'd0, clk_i, rst_ni);
-    `FFLARNC(flip_raddr_reg, flip_raddr_n, en_i & flip_ren_p, flush_i, 'd0, clk_i, rst_ni);
+    `FFLARNC(flip_raddr_reg, flip_raddr_load_i ? flip_raddr_load_value_i : flip_raddr_n, en_i & (flip_ren_p | flip_raddr_load_i), flush_i, 'd0, clk_i, rst_ni);
     `FFLARNC(flip_ren_n, flip_ren_p, en_i & (~flip_disable_i), flush_i, 'd0, clk_i, rst_ni);
     `FFLARNC(flip_disable_reg, 1'b1, en_i & prev_hdsk_cnt_maxed & (prev_spin_handshake), flip_disable_reg_flush_cond, 'd0, clk_i, rst_ni);
     `FFLARNC(flip_rdata_reg, flip_rdata_i, flip_ren_n, flush_i, 'd0, clk_i, rst_ni); // assume read data is valid one cycle after read enable
+    `FFLARNC(ring_read_cnt_o, ring_read_cnt_o + 1'b1, en_i & flip_ren_p, flush_i, 'd0, clk_i, rst_ni);
 
     // counter for completing at least one loop when flip_disable_i is high
     generate
@@ -170,9 +205,25 @@ module flip_engine #(
         .data_i(prev_spin_i),
         .data_o(prev_spin_pipe),
         .valid_i(prev_spin_valid_i),
+        .valid_o(flipped_spin_valid_pipe),
+        .ready_i(flipped_spin_ready_pipe),
+        .ready_o(pipe_ready)
+    );
+
+    // pipeline cuts after the flip mask
+    bp_pipe #(
+        .DATAW(NUM_SPIN),
+        .PIPES(PIPES)
+    ) u_pipe_flipped (
+        .clk_i(clk_i),
+        .rst_ni(rst_ni),
+        .flush_i(flush_i),
+        .data_i(flipped_spin_comb),
+        .data_o(flipped_spin_o),
+        .valid_i(flipped_spin_valid_pipe),
         .valid_o(flipped_spin_valid_o),
         .ready_i(flipped_spin_ready_i),
-        .ready_o(prev_spin_ready_o)
+        .ready_o(flipped_spin_ready_pipe)
     );
 
 endmodule
\ No newline at end of file
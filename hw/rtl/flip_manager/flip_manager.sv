@@ -14,9 +14,22 @@
 // - ENERGY_TOTAL_BIT: bit-width of the total energy value
 // - FLIP_ICON_DEPTH: depth of flip icon memory
 // - FLIP_ICON_ADDR_DEPTH: address width for flip icon memory (usually $clog2(FLIP_ICON_DEPTH))
+// - FLIP_PIPES: register stages after the flip mask in flip_engine (handshaked, 0 = none)
 //
 // Notes:
 // - This module arbitrates between configuration-driven pushes and energy-driven pushes into the spin FIFO.
+// - pause_i stops popping spins from the spin FIFO: the spins in flight return and the computation
+//   ends with a full FIFO, so the spin/energy FIFOs, flip_raddr_q_o and spin_fifo_head_o (slot
+//   popped next) form a checkpoint of the computation.
+// - resume_i (1-cycle pulse, after the initial spins are configured) restores a checkpoint: the
+//   energy FIFO is loaded with resume_energy_i and the flip read address with resume_flip_raddr_i.
+// - accept_mode_i selects the acceptance rule of new spins (greedy, threshold accepting or
+//   Metropolis, see acceptance_ctrl). The temperature restarts at accept_t_start_i on every
+//   computation and the RNG is reseeded with accept_seed_i on accept_seed_load_i.
+//   accept_uphill_cnt_o counts the new spins accepted without a lower energy since the start of
+//   the computation (saturating).
+// - ring_en_i uses the flip memory as a ring buffer of a longer flip schedule, refilled by the
+//   host while the computation runs (see flip_engine). ring_read_cnt_o restarts on flush_i.
 
 `include "common_cells/registers.svh"
 
@@ -25,8 +38,10 @@ module flip_manager #(
     parameter int SPIN_DEPTH = 2,
     parameter int ENERGY_TOTAL_BIT = 32,
     parameter int FLIP_ICON_DEPTH = 1024,
+    parameter int FLIP_PIPES = 0,
     // Do not override
-    parameter int FLIP_ICON_ADDR_DEPTH = $clog2(FLIP_ICON_DEPTH)
+    parameter int FLIP_ICON_ADDR_DEPTH = $clog2(FLIP_ICON_DEPTH),
+    parameter int SPIN_ADDR_DEPTH = (SPIN_DEPTH > 1) ? $clog2(SPIN_DEPTH) : 1
 )(
     input logic clk_i,
     input logic rst_ni,
@@ -34,6 +49,17 @@ module flip_manager #(
     input logic flush_i,
     input logic en_comparison_i,
 
+    // acceptance rule
+    input logic [1:0] accept_mode_i,
+    input logic [15:0] accept_t_start_i,
+    input logic [15:0] accept_t_min_i,
+    input logic [3:0] accept_t_decay_shift_i,
+    input logic [15:0] accept_t_interval_i,
+    input logic [31:0] accept_seed_i,
+    input logic accept_seed_load_i,
+    output logic [15:0] accept_temp_o,
+    output logic [15:0] accept_uphill_cnt_o,
+
     input logic cmpt_en_i,
     output logic cmpt_idle_o,
     input logic host_readout_i,
@@ -59,6 +85,21 @@ module flip_manager #(
 
     input logic flip_disable_i,
 
+    // checkpoint and resume
+    input logic pause_i,
+    input logic resume_i,
+    input logic [FLIP_ICON_ADDR_DEPTH+1-1:0] resume_flip_raddr_i,
+    input logic signed [SPIN_DEPTH-1:0] [ENERGY_TOTAL_BIT-1:0] resume_energy_i,
+    output logic [FLIP_ICON_ADDR_DEPTH+1-1:0] flip_raddr_q_o,
+    output logic [SPIN_ADDR_DEPTH-1:0] spin_fifo_head_o,
+
+    // flip memory ring buffer
+    input logic ring_en_i,
+    input logic [31:0] ring_fill_cnt_i,
+    input logic [31:0] ring_total_i,
+    output logic [31:0] ring_read_cnt_o,
+    output logic ring_stall_o,
+
     // for debugging purposes
     output logic energy_fifo_update_o,
     output logic spin_fifo_update_o,
@@ -89,6 +130,8 @@ module flip_manager #(
     logic spin_fifo_push_handshake;
     logic energy_handshake_dly1;
     logic spin_fifo_push_handshake_dly1;
+    logic signed [ENERGY_TOTAL_BIT:0] accept_threshold;
+    logic accept_uphill;
 
     // control logic
     assign spin_configure_ready_o = spin_maintainer_push_ready & cmpt_idle_o;
@@ -109,6 +152,35 @@ module flip_manager #(
     `FFL(energy_handshake_dly1, energy_handshake, en_i, 1'b0, clk_i, rst_ni);
     `FFL(spin_fifo_push_handshake_dly1, spin_fifo_push_handshake, en_i, 1'b0, clk_i, rst_ni);
 
+    // slot of the spin FIFO that is popped next
+    if (SPIN_DEPTH > 1) begin: gen_spin_fifo_head
+        `FFLARNC(spin_fifo_head_o, (spin_fifo_head_o == SPIN_ADDR_DEPTH'(SPIN_DEPTH-1)) ? '0 : spin_fifo_head_o + 1'b1, spin_pop_valid_p & spin_pop_ready_p, flush_i, '0, clk_i, rst_ni);
+    end else begin: gen_no_spin_fifo_head
+        assign spin_fifo_head_o = '0;
+    end
+
+    // Instantiate acceptance rule: one step per energy evaluation
+    acceptance_ctrl #(
+        .ENERGY_TOTAL_BIT(ENERGY_TOTAL_BIT),
+        .TEMP_BIT(16)
+    ) u_acceptance_ctrl (
+        .clk_i(clk_i),
+        .rst_ni(rst_ni),
+        .restart_i(cmpt_en_i),
+        .seed_load_i(accept_seed_load_i),
+        .step_i(energy_handshake),
+        .mode_i(accept_mode_i),
+        .t_start_i(accept_t_start_i),
+        .t_min_i(accept_t_min_i),
+        .t_decay_shift_i(accept_t_decay_shift_i),
+        .t_interval_i(accept_t_interval_i),
+        .seed_i(accept_seed_i),
+        .threshold_o(accept_threshold),
+        .temp_o(accept_temp_o)
+    );
+
+    `FFLARNC(accept_uphill_cnt_o, accept_uphill_cnt_o + 1'b1, accept_uphill & (accept_uphill_cnt_o != '1), cmpt_en_i, '0, clk_i, rst_ni);
+
     // Instantiate energy maintainer
     energy_fifo_maintainer #(
         .NUM_SPIN(NUM_SPIN),
@@ -120,6 +192,7 @@ module flip_manager #(
         .en_i(en_i),
         .flush_i(flush_i),
         .en_comparison_i(en_comparison_i),
+        .accept_threshold_i(accept_threshold),
         .spin_valid_o(spin_maintainer_push_from_en),
         .spin_o(spin_maintainer_income_from_en),
         .spin_push_none_o(spin_maintainer_push_none_from_en),
@@ -128,7 +201,10 @@ module flip_manager #(
         .energy_ready_o(energy_ready_o),
         .spin_i(spin_i),
         .energy_i(energy_i),
+        .energy_load_i(resume_i),
+        .energy_load_data_i(resume_energy_i),
         .debug_fifo_usage_o(),
+        .uphill_accept_o(accept_uphill),
         .energy_fifo_o(energy_fifo_o)
     );
 
@@ -142,7 +218,7 @@ module flip_manager #(
         .en_i(en_i),
         .flush_i(flush_i),
         .cmpt_en_i(cmpt_en_i),
-        .icon_finish_i(icon_finish),
+        .icon_finish_i(icon_finish | pause_i),
         .host_readout_i(host_readout_i),
         .spin_push_valid_i(spin_maintainer_push_valid),
         .spin_push_i(spin_maintainer_income),
@@ -161,7 +237,8 @@ module flip_manager #(
         .SPIN_DEPTH(SPIN_DEPTH),
         .NUM_SPIN(NUM_SPIN),
         .FLIP_ICON_DEPTH(FLIP_ICON_DEPTH),
-        .FLIP_ICON_ADDR_DEPTH(FLIP_ICON_ADDR_DEPTH)
+        .FLIP_ICON_ADDR_DEPTH(FLIP_ICON_ADDR_DEPTH),
+        .PIPES(FLIP_PIPES)
     ) u_flip_engine (
         .clk_i(clk_i),
         .rst_ni(rst_ni),
@@ -179,7 +256,15 @@ module flip_manager #(
         .flip_rdata_i(flip_rdata_i),
         .icon_last_raddr_plus_one_i(icon_last_raddr_plus_one_i),
         .icon_finish_o(icon_finish),
+        .flip_raddr_load_i(resume_i),
+        .flip_raddr_load_value_i(resume_flip_raddr_i),
+        .flip_raddr_q_o(flip_raddr_q_o),
         .flip_disable_i(flip_disable_i),
+        .ring_en_i(ring_en_i),
+        .ring_fill_cnt_i(ring_fill_cnt_i),
+        .ring_total_i(ring_total_i),
+        .ring_read_cnt_o(ring_read_cnt_o),
+        .ring_stall_o(ring_stall_o),
         .infinite_icon_loop_en_i(infinite_icon_loop_en_i)
     );
 
@@ -18,6 +18,7 @@
 // - Add RESET_VALUE parameter to set the reset value of the fifo
 // - Expose memory content for debugging purpose
 // - Add almost_full_o signal to indicate if one push is allowed (not full)
+// - Add mem_load_i/mem_i to overwrite the memory content without touching the pointers
 
 module lagd_fifo_v3 #(
     parameter bit          FALL_THROUGH = 1'b0, // fifo is in fall-through mode
@@ -46,7 +47,10 @@ module lagd_fifo_v3 #(
     input  logic  pop_i,            // pop head from queue
     // for debugging purposes
     output dtype [FifoDepth-1:0] mem_o,    // expose memory content
-    output logic almost_full_o      // queue almost full (one push allowed)
+    output logic almost_full_o,     // queue almost full (one push allowed)
+    // memory preload (e.g. to restore a checkpoint)
+    input  logic mem_load_i,        // overwrite the memory content with mem_i
+    input  dtype [FifoDepth-1:0] mem_i // memory content to load
 );
     // clock gating control
     logic gate_clock;
@@ -161,6 +165,8 @@ module lagd_fifo_v3 #(
             end
         end else if (flush_i && (FLUSH_VALUE != 0)) begin
             mem_q <= {FifoDepth{dtype'({1'b0, {(DATA_WIDTH-1){1'b1}}})}};
+        end else if (mem_load_i) begin
+            mem_q <= mem_i;
         end else if (!gate_clock) begin
             mem_q <= mem_n;
         end
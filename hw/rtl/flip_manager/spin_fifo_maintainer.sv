@@ -106,7 +106,9 @@ module spin_fifo_maintainer #(
         .data_o(spin_pop_o),
         .pop_i(fifo_pop_comb),
         .mem_o(spin_fifo_o),
-        .almost_full_o()
+        .almost_full_o(),
+        .mem_load_i(1'b0),
+        .mem_i('0)
     );
 
     // Control logic
@@ -0,0 +1,100 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// Final-energy histogram. When a computation finishes (store_i), its SPIN_DEPTH final energies
+// are registered and binned one per cycle:
+// - bin b counts the energies in [base_i + b*2^shift_i, base_i + (b+1)*2^shift_i), b < num_bins_i,
+// - energies below base_i are counted in under_o, energies above the last bin in over_o,
+// - clear_i (level) resets all counters, base_i/shift_i/num_bins_i must only change with it.
+// The counters are read out through rd_idx_i and saturate at their maximum value.
+//
+// Parameters:
+// - SPIN_DEPTH: number of final energies per computation
+// - ENERGY_TOTAL_BIT: bit width of the (signed) energy
+// - NUM_BINS: number of bins
+// - CNT_BIT: bit width of the counters
+// - RD_IDX_BIT: bit width of rd_idx_i, indices of NUM_BINS and above read out 0
+//
+// Port definitions:
+// - en_i: enable, store_i is ignored when low
+// - clear_i: reset the counters
+// - base_i: lower edge of bin 0
+// - shift_i: log2 of the bin width
+// - num_bins_i: number of bins in use (1 to NUM_BINS, larger values are clamped to NUM_BINS)
+// - store_i: 1-cycle pulse when a computation finishes (bin energy_fifo_i)
+// - energy_fifo_i: final energies of the computation
+// - rd_idx_i: bin read out on rd_cnt_o
+// - under_o, over_o: number of energies below the first bin and above the last bin
+// - busy_o: energies are being binned
+
+`include "common_cells/registers.svh"
+
+module energy_histogram #(
+    parameter int SPIN_DEPTH = 2,
+    parameter int ENERGY_TOTAL_BIT = 32,
+    parameter int NUM_BINS = 32,
+    parameter int CNT_BIT = 32,
+    parameter int RD_IDX_BIT = 8,
+    // derived parameters
+    parameter int IDX_BIT = NUM_BINS > 1 ? $clog2(NUM_BINS) : 1,
+    parameter int NBIN_BIT = $clog2(NUM_BINS + 1),
+    parameter int SLOT_BIT = SPIN_DEPTH > 1 ? $clog2(SPIN_DEPTH) : 1
+)(
+    input logic clk_i,
+    input logic rst_ni,
+    input logic en_i,
+    input logic clear_i,
+    input logic signed [ENERGY_TOTAL_BIT-1:0] base_i,
+    input logic [4:0] shift_i,
+    input logic [NBIN_BIT-1:0] num_bins_i,
+
+    input logic store_i,
+    input logic [SPIN_DEPTH-1:0] [ENERGY_TOTAL_BIT-1:0] energy_fifo_i,
+
+    input logic [RD_IDX_BIT-1:0] rd_idx_i,
+    output logic [CNT_BIT-1:0] rd_cnt_o,
+    output logic [CNT_BIT-1:0] under_o,
+    output logic [CNT_BIT-1:0] over_o,
+    output logic busy_o
+);
+    logic [SPIN_DEPTH-1:0] [ENERGY_TOTAL_BIT-1:0] energy_q;
+    logic [SLOT_BIT-1:0] slot_q;
+    logic bin_last;
+    logic signed [ENERGY_TOTAL_BIT:0] offset;
+    logic [ENERGY_TOTAL_BIT:0] bin_idx;
+    logic [NBIN_BIT-1:0] num_bins;
+    logic is_under, is_over;
+    logic [NUM_BINS-1:0] [CNT_BIT-1:0] bin_cnt_q;
+
+    // bins past NUM_BINS do not exist, their energies are counted in over_o
+    assign num_bins = (num_bins_i > NUM_BINS) ? NBIN_BIT'(NUM_BINS) : num_bins_i;
+
+    // binning of energy slot slot_q, one per cycle
+    assign bin_last = busy_o & (slot_q == SLOT_BIT'(SPIN_DEPTH - 1));
+    assign offset = $signed({energy_q[slot_q][ENERGY_TOTAL_BIT-1], energy_q[slot_q]}) -
+                    $signed({base_i[ENERGY_TOTAL_BIT-1], base_i});
+    assign bin_idx = offset >> shift_i;
+    assign is_under = offset[ENERGY_TOTAL_BIT];
+    assign is_over = ~is_under & (bin_idx >= (ENERGY_TOTAL_BIT+1)'(num_bins));
+
+    `FFL(energy_q, energy_fifo_i, store_i & en_i & ~busy_o, '0, clk_i, rst_ni)
+    `FFLARNC(busy_o, 1'b1, store_i & en_i & ~busy_o, bin_last | clear_i, 1'b0, clk_i, rst_ni)
+    `FFLARNC(slot_q, slot_q + 1'b1, busy_o, bin_last | clear_i, '0, clk_i, rst_ni)
+
+    // counters
+    `FFLARNC(under_o, under_o + 1'b1, busy_o & is_under & ~&under_o, clear_i, '0, clk_i, rst_ni)
+    `FFLARNC(over_o, over_o + 1'b1, busy_o & is_over & ~&over_o, clear_i, '0, clk_i, rst_ni)
+    for (genvar b = 0; b < NUM_BINS; b++) begin: gen_bin
+        logic hit;
+        assign hit = busy_o & ~is_under & ~is_over & (bin_idx == b) & ~&bin_cnt_q[b];
+        `FFLARNC(bin_cnt_q[b], bin_cnt_q[b] + 1'b1, hit, clear_i, '0, clk_i, rst_ni)
+    end
+
+    // compare the full index, so that an out-of-range read does not alias to a bin
+    assign rd_cnt_o = (rd_idx_i < NUM_BINS) ? bin_cnt_q[IDX_BIT'(rd_idx_i)] : '0;
+
+endmodule
@@ -0,0 +1,124 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// This module turns the energy monitor into a batch evaluator of host-supplied spin vectors
+// (energy-oracle mode). The host places num_i spin vectors in the flip memory (one spin vector
+// per word) at src_base_i. When en_i rises, the vectors are streamed one by one to the energy
+// monitor, which evaluates them against the loaded J/h, and the energies are written back to the
+// flip memory at dst_base_i, ENERGY_PER_WORD energies per word (energy k of the batch at word
+// dst_base_i + k/ENERGY_PER_WORD, bits [(k%ENERGY_PER_WORD)*ENERGY_TOTAL_BIT +: ENERGY_TOTAL_BIT]).
+// The energy monitor returns the energies in order, so no tag is needed.
+// - one spin vector is prefetched while the previous one is evaluated,
+// - a result word is written when it is full or when the last energy arrived, the energy
+//   monitor is back-pressured meanwhile,
+// - memory accesses are only issued when mem_gnt_i is set; read data is expected one cycle later.
+//
+// Parameters:
+// - NUM_SPIN: the number of spins (equal to the flip memory data width)
+// - ENERGY_TOTAL_BIT: bit width of each energy value
+// - ADDR_WIDTH: width of the flip memory word address
+// - CNT_WIDTH: width of the batch size and the counters
+//
+// Ports:
+// - en_i: enable the oracle; a rising edge starts a batch, keep high until done_o
+// - src_base_i, dst_base_i: word addresses of the spin vector list and the energy list
+// - num_i: number of spin vectors of the batch
+// - spin_*: spin vector stream to the energy monitor
+// - energy_*: energy stream from the energy monitor
+// - mem_*: flip memory port
+// - done_o: all energies of the batch are stored
+// - cnt_o: number of energies received since en_i rose
+
+`include "common_cells/registers.svh"
+
+module energy_oracle #(
+    parameter int NUM_SPIN = 256,
+    parameter int ENERGY_TOTAL_BIT = 32,
+    parameter int ADDR_WIDTH = 10,
+    parameter int CNT_WIDTH = 16,
+    // derived parameters
+    parameter int ENERGY_PER_WORD = NUM_SPIN / ENERGY_TOTAL_BIT,
+    parameter int SLOT_WIDTH = ENERGY_PER_WORD > 1 ? $clog2(ENERGY_PER_WORD) : 1
+)(
+    input  logic clk_i,
+    input  logic rst_ni,
+    input  logic en_i,
+    input  logic [ADDR_WIDTH-1:0] src_base_i,
+    input  logic [ADDR_WIDTH-1:0] dst_base_i,
+    input  logic [CNT_WIDTH-1:0] num_i,
+    // spin vectors to the energy monitor
+    output logic spin_valid_o,
+    input  logic spin_ready_i,
+    output logic [NUM_SPIN-1:0] spin_o,
+    // energies from the energy monitor
+    input  logic energy_valid_i,
+    output logic energy_ready_o,
+    input  logic [ENERGY_TOTAL_BIT-1:0] energy_i,
+    // memory interface
+    output logic mem_req_o,
+    input  logic mem_gnt_i,
+    output logic mem_we_o,
+    output logic [ADDR_WIDTH-1:0] mem_addr_o,
+    output logic [NUM_SPIN-1:0] mem_wdata_o,
+    input  logic [NUM_SPIN-1:0] mem_rdata_i,
+    // status
+    output logic done_o,
+    output logic [CNT_WIDTH-1:0] cnt_o
+);
+    logic en_dly1, en_posedge;
+    logic busy_q;
+    logic fetch_active, store_active;
+    logic mem_hdsk;
+    logic rdata_valid;
+    logic spin_hdsk, energy_hdsk;
+    logic energy_last, store_last;
+    logic store_pending;
+    logic [CNT_WIDTH-1:0] fetch_cnt_q;
+    logic [CNT_WIDTH-1:0] store_cnt_q;
+    logic [SLOT_WIDTH-1:0] slot_q;
+    logic [NUM_SPIN-1:0] result_q;
+
+    // control logic
+    assign en_posedge = en_i & ~en_dly1;
+    assign spin_hdsk = spin_valid_o & spin_ready_i;
+    assign energy_hdsk = energy_valid_i & energy_ready_o;
+    assign energy_last = energy_hdsk & (cnt_o + 1'b1 == num_i);
+    // results are stored first, a spin vector is fetched when the prefetch slot is free
+    assign store_active = store_pending;
+    assign fetch_active = busy_q & (fetch_cnt_q != num_i) & ~spin_valid_o & ~rdata_valid & ~store_pending;
+    assign mem_req_o = en_i & (store_active | fetch_active);
+    assign mem_hdsk = mem_req_o & mem_gnt_i;
+    assign mem_we_o = store_active;
+    assign mem_addr_o = store_active ? dst_base_i + store_cnt_q : src_base_i + fetch_cnt_q;
+    assign mem_wdata_o = result_q;
+    assign store_last = store_active & mem_hdsk & (store_cnt_q == (num_i - 1'b1) / ENERGY_PER_WORD);
+    assign energy_ready_o = busy_q & ~store_pending;
+
+    `FFL(en_dly1, en_i, 1'b1, 1'b0, clk_i, rst_ni)
+    `FFLARNC(busy_q, num_i != '0, en_posedge, store_last | ~en_i, 1'b0, clk_i, rst_ni)
+    `FFLARNC(done_o, 1'b1, store_last | (en_posedge & (num_i == '0)), ~en_i | (en_posedge & (num_i != '0)), 1'b0, clk_i, rst_ni)
+
+    // spin vector fetch, the read data is held until the energy monitor takes it
+    `FFLARNC(fetch_cnt_q, fetch_cnt_q + 1'b1, fetch_active & mem_hdsk, en_posedge, 'd0, clk_i, rst_ni)
+    `FFLARNC(rdata_valid, fetch_active & mem_hdsk, 1'b1, ~en_i, 1'b0, clk_i, rst_ni)
+    `FFL(spin_o, mem_rdata_i, rdata_valid, 'd0, clk_i, rst_ni)
+    `FFLARNC(spin_valid_o, 1'b1, rdata_valid, spin_hdsk | ~en_i, 1'b0, clk_i, rst_ni)
+
+    // energy collection
+    `FFLARNC(cnt_o, cnt_o + 1'b1, energy_hdsk, en_posedge, 'd0, clk_i, rst_ni)
+    `FFLARNC(slot_q, slot_q + 1'b1, energy_hdsk, en_posedge | (store_active & mem_hdsk), 'd0, clk_i, rst_ni)
+    `FFLARNC(store_pending, 1'b1, energy_hdsk & ((slot_q == ENERGY_PER_WORD - 1) | energy_last), (store_active & mem_hdsk) | ~en_i, 1'b0, clk_i, rst_ni)
+    `FFLARNC(store_cnt_q, store_cnt_q + 1'b1, store_active & mem_hdsk, en_posedge, 'd0, clk_i, rst_ni)
+
+    for (genvar i = 0; i < ENERGY_PER_WORD; i++) begin: gen_result_slot
+        `FFLARNC(result_q[i*ENERGY_TOTAL_BIT +: ENERGY_TOTAL_BIT], energy_i, energy_hdsk & (slot_q == i), en_posedge | (store_active & mem_hdsk), 'd0, clk_i, rst_ni)
+    end
+    if (NUM_SPIN > ENERGY_PER_WORD * ENERGY_TOTAL_BIT) begin: gen_result_pad
+        assign result_q[NUM_SPIN-1:ENERGY_PER_WORD*ENERGY_TOTAL_BIT] = '0;
+    end
+
+endmodule
@@ -35,11 +35,29 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     output axi_narrow_rsp_t axi_s_rsp_j_o,
     input  axi_narrow_req_t axi_s_req_f_i,
     output axi_narrow_rsp_t axi_s_rsp_f_o,
+    // AXI slave interface of the broadcast aliases (from lagd_axi_bcast in lagd_soc)
+    input  axi_narrow_req_t axi_s_req_jb_i,
+    output axi_narrow_rsp_t axi_s_rsp_jb_o,
+    input  axi_narrow_req_t axi_s_req_fb_i,
+    output axi_narrow_rsp_t axi_s_rsp_fb_o,
+    output logic bcast_j_en_o,
+    output logic bcast_f_en_o,
 
     // Register slave interface
     input reg_req_t reg_s_req_i,
     output reg_rsp_t reg_s_rsp_o,
 
+    // Replica exchange interface (to/from replica_exchange in lagd_soc)
+    output logic xchg_en_o,
+    output logic xchg_done_o,
+    output logic [15:0] xchg_pair_temp_o,
+    output logic [7:0] xchg_interval_o,
+    output logic [logic_cfg.SpinDepth-1:0] [logic_cfg.NumSpin-1:0] xchg_spin_o,
+    output logic [logic_cfg.SpinDepth-1:0] [logic_cfg.EnergyTotalBit-1:0] xchg_energy_o,
+    input  logic [logic_cfg.SpinDepth-1:0] [logic_cfg.NumSpin-1:0] xchg_spin_i,
+    input  logic xchg_release_i,
+    input  logic [15:0] xchg_swap_cnt_i,
+
     // Galena wires
     inout wire galena_j_vup_i,
     inout wire galena_j_vdn_i,
@@ -84,6 +102,7 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     logic [$clog2(logic_cfg.SynchronizerPipeDepth)-1:0] synchronizer_pipe_num;
     logic [$clog2(logic_cfg.SynchronizerPipeDepth)-1:0] synchronizer_wbl_pipe_num;
     logic dt_cfg_enable;
+    logic dt_cfg_h_only;
     logic host_readout;
     logic [logic_cfg.HRegDataBitwidth-1:0] h_rdata, dgt_hbias;
     logic [logic_cfg.FmemAddrBitwidth-1+1:0] icon_last_raddr_plus_one;
@@ -91,6 +110,7 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     logic [logic_cfg.ScalingBit-1:0] dgt_hscaling;
     logic [logic_cfg.HRegDataBitwidth-1:0] wbl_floating;
     logic [logic_cfg.JmemAddrBitwidth-1:0] dgt_addr_upper_bound;
+    logic [logic_cfg.NumSpin/logic_cfg.Parallelism-1:0] dgt_nz_block_mask;
     logic enable_flip_detection;
     logic [logic_cfg.CounterBitwidth-1:0] debug_cycle_per_spin_read;
     logic [logic_cfg.CounterBitwidth-1:0] debug_spin_read_num;
@@ -107,6 +127,50 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     logic multi_cmpt_mode_en;
     logic [logic_cfg.CcCounterBitwidth-1:0] cmpt_max_num;
     logic energy_fifo_sel;
+    logic j_mem_bank_sel;
+    logic flip_mem_bank_sel;
+    logic j_precision_2b;
+    logic restart_queue_en;
+    logic [logic_cfg.FmemAddrBitwidth-1:0] restart_queue_state_base;
+    logic [logic_cfg.FmemAddrBitwidth-1:0] restart_queue_result_base;
+    logic replica_exchange_en;
+    logic [15:0] replica_exchange_pair_temp;
+    logic [7:0] replica_exchange_interval;
+    logic em_batch_en;
+    logic [15:0] em_batch_timeout;
+    logic cmpt_pause;
+    logic cmpt_resume;
+    logic [logic_cfg.FmemAddrBitwidth:0] resume_flip_raddr;
+    logic [logic_cfg.SpinDepth-1:0] [logic_cfg.EnergyTotalBit-1:0] resume_energy;
+    logic topk_en;
+    logic topk_clear;
+    logic [7:0] topk_k;
+    logic [7:0] topk_rd_idx;
+    logic pack_en;
+    logic pack_clear;
+    logic [3:0] pack_blocks_log2;
+    logic [7:0] pack_rd_idx;
+    logic oracle_en;
+    logic [15:0] oracle_num;
+    logic [logic_cfg.FmemAddrBitwidth-1:0] oracle_src_base;
+    logic [logic_cfg.FmemAddrBitwidth-1:0] oracle_dst_base;
+    logic ring_en;
+    logic [10:0] ring_low_wm;
+    logic [10:0] ring_high_wm;
+    logic [31:0] ring_fill_cnt;
+    logic [31:0] ring_total;
+    logic hist_en;
+    logic hist_clear;
+    logic [4:0] hist_shift;
+    logic [7:0] hist_num_bins;
+    logic [7:0] hist_rd_idx;
+    logic [logic_cfg.EnergyTotalBit-1:0] hist_base;
+    logic [1:0] accept_mode;
+    logic [15:0] accept_t_start;
+    logic [15:0] accept_t_min;
+    logic [3:0] accept_t_decay_shift;
+    logic [15:0] accept_t_interval;
+    logic [31:0] accept_seed;
     // memories
     logic [logic_cfg.JmemDataBitwidth-1:0] j_rdata, dgt_weight;
     logic [logic_cfg.NumSpin-1:0] flip_rdata;
@@ -138,6 +202,16 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     logic cycle_per_iter_recount_en;
     logic [logic_cfg.FmemAddrBitwidth-1:0] fm_upstream_handshake_counter;
     logic [logic_cfg.CcCounterBitwidth-1:0] cmpt_idx;
+    logic [logic_cfg.FmemAddrBitwidth:0] ckpt_flip_raddr;
+    logic [(logic_cfg.SpinDepth > 1 ? $clog2(logic_cfg.SpinDepth) : 1)-1:0] ckpt_spin_fifo_head;
+    logic [7:0] topk_count;
+    logic [logic_cfg.EnergyTotalBit-1:0] topk_energy;
+    logic [logic_cfg.NumSpin-1:0] topk_spin;
+    logic [7:0] pack_valid;
+    logic [logic_cfg.EnergyTotalBit-1:0] pack_energy;
+    logic [logic_cfg.NumSpin-1:0] pack_spin;
+    logic [15:0] accept_temp;
+    logic [15:0] accept_uphill_cnt;
     logic [logic_cfg.ScCounterBitwidth-1:0] cycle_per_cmpt;
     logic [logic_cfg.IterCounterBitwidth-1:0] cycle_per_iteration;
     logic [2*logic_cfg.CcCounterBitwidth-1:0] cycle_all_cmpt;
@@ -169,14 +243,77 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     // internal signals
     logic cmpt_idle_dly1;
     logic cmpt_idle_posedge;
+    logic j_mem_bank_active;
+    logic flip_mem_bank_active;
+    logic [l1_mem_cfg_j.AddrWidth-1:0] j_mem_bank_offset;
+    logic [l1_mem_cfg_flip.AddrWidth-1:0] flip_mem_bank_offset;
+    logic j_mem_load_mode;
+    logic j_precision_clear;
+    logic j_logical_ren, j_mem_ren;
+    logic [logic_cfg.JmemAddrBitwidth-1:0] j_logical_raddr, j_mem_raddr;
+    logic [logic_cfg.JmemDataBitwidth-1:0] j_rdata_unpacked;
+    logic cmpt_idle_negedge;
+    logic [logic_cfg.NumSpin*logic_cfg.SpinDepth-1:0] config_spin_initial_dgt;
+    logic [logic_cfg.SpinDepth-1:0] config_spin_initial_skip_dgt;
+    logic [logic_cfg.NumSpin*logic_cfg.SpinDepth-1:0] rq_spin_initial;
+    logic rq_ready;
+    logic [15:0] rq_store_cnt;
+    logic rq_overflow;
+    logic rq_mem_req, rq_mem_gnt, rq_mem_we;
+    logic [logic_cfg.FmemAddrBitwidth-1:0] rq_mem_addr;
+    logic xchg_spin_sel;
+    logic xchg_finished;
+    logic multi_cmpt_mode_idle_dly1;
+    logic [logic_cfg.NumSpin-1:0] rq_mem_wdata;
+    logic oracle_spin_valid, oracle_spin_ready;
+    logic [logic_cfg.NumSpin-1:0] oracle_spin;
+    logic oracle_energy_valid, oracle_energy_ready;
+    logic [logic_cfg.EnergyTotalBit-1:0] oracle_energy;
+    logic oracle_done;
+    logic [15:0] oracle_cnt;
+    logic [31:0] ring_read_cnt;
+    logic [31:0] ring_level;
+    logic ring_stall;
+    logic oracle_mem_req, oracle_mem_gnt, oracle_mem_we;
+    logic [logic_cfg.FmemAddrBitwidth-1:0] oracle_mem_addr;
+    logic [logic_cfg.NumSpin-1:0] oracle_mem_wdata;
+    logic [31:0] hist_cnt, hist_under, hist_over;
 
     assign cmpt_idle_posedge = cmpt_idle & ~cmpt_idle_dly1;
+    assign cmpt_idle_negedge = ~cmpt_idle & cmpt_idle_dly1;
     `FFLARNC(cmpt_idle_dly1, cmpt_idle, en_fm, flush_en, 1'b1, clk_i, rst_ni)
 
+    //////////////////////////////////////////////////////////
+    // L1 memory bank selection //////////////////////////////
+    //////////////////////////////////////////////////////////
+    // The selected bank is latched when onloading/computation starts, so the host can
+    // fill the shadow bank while the active bank is in use. An h-only onloading keeps the
+    // J bank, since the analog J rows are not re-programmed.
+    generate
+        if (logic_cfg.NumL1Buffers > 1) begin: gen_l1_double_buffer
+            `FFL(j_mem_bank_active, j_mem_bank_sel, dt_cfg_enable & dt_cfg_idle & ~dt_cfg_h_only, 1'b0, clk_i, rst_ni)
+            `FFL(flip_mem_bank_active, flip_mem_bank_sel, cmpt_en & cmpt_idle, 1'b0, clk_i, rst_ni)
+        end else begin: gen_l1_single_buffer
+            assign j_mem_bank_active = 1'b0;
+            assign flip_mem_bank_active = 1'b0;
+        end
+    endgenerate
+
+    assign j_mem_bank_offset = j_mem_bank_active ? logic_cfg.JmemBufferSizeB : '0;
+    assign flip_mem_bank_offset = flip_mem_bank_active ? logic_cfg.FmemBufferSizeB : '0;
+
     //////////////////////////////////////////////////////////
     // L1 memory, with narrow and direct access //////////////
     //////////////////////////////////////////////////////////
-    // L1 memory instances
+    // L1 memory instances, AXI port 0 is the direct one and port 1 the broadcast alias
+    axi_narrow_req_t [1:0] l1_j_axi_req, l1_f_axi_req;
+    axi_narrow_rsp_t [1:0] l1_j_axi_rsp, l1_f_axi_rsp;
+
+    assign l1_j_axi_req = {axi_s_req_jb_i, axi_s_req_j_i};
+    assign l1_f_axi_req = {axi_s_req_fb_i, axi_s_req_f_i};
+    assign {axi_s_rsp_jb_o, axi_s_rsp_j_o} = l1_j_axi_rsp;
+    assign {axi_s_rsp_fb_o, axi_s_rsp_f_o} = l1_f_axi_rsp;
+
     memory_island_wrap_ic #(
         .Cfg                   (l1_mem_cfg_j           ),
         .axi_narrow_req_t      (axi_narrow_req_t       ),
@@ -188,8 +325,8 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     ) i_l1_mem_j (
         .clk_i                  (clk_i                 ),
         .rst_ni                 (rst_ni                ),
-        .axi_narrow_req_i       (axi_s_req_j_i         ),
-        .axi_narrow_rsp_o       (axi_s_rsp_j_o         ),
+        .axi_narrow_req_i       (l1_j_axi_req          ),
+        .axi_narrow_rsp_o       (l1_j_axi_rsp          ),
         .mem_wide_req_i         (drt_s_req_j           ),
         .mem_wide_rsp_o         (drt_s_rsp_j           )
     );
@@ -205,8 +342,8 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     ) i_l1_mem_flip (
         .clk_i                  (clk_i                 ),
         .rst_ni                 (rst_ni                ),
-        .axi_narrow_req_i       (axi_s_req_f_i         ),
-        .axi_narrow_rsp_o       (axi_s_rsp_f_o         ),
+        .axi_narrow_req_i       (l1_f_axi_req          ),
+        .axi_narrow_rsp_o       (l1_f_axi_rsp          ),
         .mem_wide_req_i         (drt_s_req_flip        ),
         .mem_wide_rsp_o         (drt_s_rsp_flip        )
     );
@@ -258,6 +395,7 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     assign config_valid_em                  = reg2hw.global_cfg_2.config_valid_em.q;
     assign config_valid_fm                  = reg2hw.global_cfg_2.config_valid_fm.q;
     assign dt_cfg_enable                    = reg2hw.global_cfg_2.dt_cfg_enable.q;
+    assign dt_cfg_h_only                    = reg2hw.global_cfg_2.dt_cfg_h_only.q;
     assign synchronizer_pipe_num            = reg2hw.global_cfg_2.synchronizer_pipe_num.q;
     assign debug_h_wwl                      = reg2hw.global_cfg_2.debug_h_wwl.q;
     assign dgt_addr_upper_bound             = reg2hw.global_cfg_2.dgt_addr_upper_bound.q;
@@ -269,9 +407,60 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     assign config_spin_initial_skip[1]      = reg2hw.global_cfg_2.config_spin_initial_skip_1.q;
     assign dgt_hscaling                     = reg2hw.global_cfg_2.dgt_hscaling.q;
     assign energy_fifo_sel                  = reg2hw.global_cfg_2.energy_fifo_sel.q;
+    assign j_precision_2b                   = reg2hw.global_cfg_2.j_precision_2b.q;
 
     assign cmpt_max_num                     = reg2hw.cmpt_max_num.q;
 
+    assign j_mem_bank_sel                   = reg2hw.l1_mem_bank.j_mem_bank_sel.q;
+    assign flip_mem_bank_sel                = reg2hw.l1_mem_bank.flip_mem_bank_sel.q;
+
+    assign restart_queue_en                 = reg2hw.restart_queue_cfg.q;
+    assign restart_queue_state_base         = reg2hw.restart_queue_addr.state_base.q[logic_cfg.FmemAddrBitwidth-1:0];
+    assign restart_queue_result_base        = reg2hw.restart_queue_addr.result_base.q[logic_cfg.FmemAddrBitwidth-1:0];
+
+    assign replica_exchange_en              = reg2hw.replica_exchange_cfg.replica_exchange_en.q;
+    assign replica_exchange_pair_temp       = reg2hw.replica_exchange_cfg.pair_temp.q;
+    assign replica_exchange_interval        = reg2hw.replica_exchange_cfg.interval.q;
+    assign em_batch_en                      = reg2hw.em_batch_cfg.em_batch_en.q;
+    assign em_batch_timeout                 = reg2hw.em_batch_cfg.em_batch_timeout.q;
+    assign cmpt_pause                       = reg2hw.checkpoint_cfg.pause_req.q;
+    assign cmpt_resume                      = reg2hw.checkpoint_cfg.resume_en.q;
+    assign resume_flip_raddr                = reg2hw.checkpoint_cfg.resume_flip_raddr.q[logic_cfg.FmemAddrBitwidth:0];
+    assign resume_energy[0]                 = reg2hw.resume_energy_0.q;
+    assign resume_energy[1]                 = reg2hw.resume_energy_1.q;
+    assign topk_en                          = reg2hw.topk_cfg.topk_en.q;
+    assign topk_clear                       = reg2hw.topk_cfg.topk_clear.q;
+    assign topk_k                           = reg2hw.topk_cfg.topk_k.q;
+    assign topk_rd_idx                      = reg2hw.topk_cfg.topk_rd_idx.q;
+    assign pack_en                          = reg2hw.pack_cfg.pack_en.q;
+    assign pack_clear                       = reg2hw.pack_cfg.pack_clear.q;
+    assign pack_blocks_log2                 = reg2hw.pack_cfg.pack_blocks_log2.q;
+    assign pack_rd_idx                      = reg2hw.pack_cfg.pack_rd_idx.q;
+    assign oracle_en                        = reg2hw.oracle_cfg.oracle_en.q;
+    assign oracle_num                       = reg2hw.oracle_cfg.oracle_num.q;
+    assign oracle_src_base                  = reg2hw.oracle_addr.src_base.q[logic_cfg.FmemAddrBitwidth-1:0];
+    assign oracle_dst_base                  = reg2hw.oracle_addr.dst_base.q[logic_cfg.FmemAddrBitwidth-1:0];
+    assign ring_en                          = reg2hw.flip_ring_cfg.ring_en.q;
+    assign ring_low_wm                      = reg2hw.flip_ring_cfg.ring_low_wm.q;
+    assign ring_high_wm                     = reg2hw.flip_ring_cfg.ring_high_wm.q;
+    assign ring_fill_cnt                    = reg2hw.flip_ring_fill.q;
+    assign ring_total                       = reg2hw.flip_ring_total.q;
+    assign ring_level                       = ring_fill_cnt - ring_read_cnt; // icons written but not read yet
+    assign hist_en                          = reg2hw.hist_cfg.hist_en.q;
+    assign hist_clear                       = reg2hw.hist_cfg.hist_clear.q;
+    assign hist_shift                       = reg2hw.hist_cfg.hist_shift.q;
+    assign hist_num_bins                    = reg2hw.hist_cfg.hist_num_bins.q;
+    assign hist_rd_idx                      = reg2hw.hist_cfg.hist_rd_idx.q;
+    assign hist_base                        = reg2hw.hist_base.q;
+    assign bcast_j_en_o                     = reg2hw.bcast_cfg.bcast_j_en.q;
+    assign accept_mode                      = reg2hw.accept_cfg.accept_mode.q;
+    assign accept_t_decay_shift             = reg2hw.accept_cfg.accept_t_decay_shift.q;
+    assign accept_t_interval                = reg2hw.accept_cfg.accept_t_interval.q;
+    assign accept_t_start                   = reg2hw.accept_temp.accept_t_start.q;
+    assign accept_t_min                     = reg2hw.accept_temp.accept_t_min.q;
+    assign accept_seed                      = reg2hw.accept_seed.q;
+    assign bcast_f_en_o                     = reg2hw.bcast_cfg.bcast_f_en.q;
+
     assign cfg_trans_num                    = reg2hw.counter_cfg_1.cfg_trans_num.q;
     assign cycle_per_wwl_high               = reg2hw.counter_cfg_1.cycle_per_wwl_high.q;
     assign cycle_per_wwl_low                = reg2hw.counter_cfg_2.cycle_per_wwl_low.q;
@@ -307,6 +496,12 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
         end
     end
 
+    always_comb begin
+        for (int i = 0; i < logic_cfg.NumSpin/logic_cfg.Parallelism/`LAGD_REG_DATA_WIDTH; i=i+1) begin
+            dgt_nz_block_mask  [i*`LAGD_REG_DATA_WIDTH +: `LAGD_REG_DATA_WIDTH] = reg2hw.j_nz_bitmap[i].q;
+        end
+    end
+
     // hw2reg
     assign hw2reg.output_status.dt_cfg_idle                        .de = en_aw;
     assign hw2reg.output_status.cmpt_idle                          .de = en_fm;
@@ -323,10 +518,29 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     assign hw2reg.output_status.debug_aw_downstream_handshake      .de = ctnus_dgt_debug;
     assign hw2reg.output_status.debug_em_upstream_handshake        .de = ctnus_dgt_debug;
     assign hw2reg.output_status.multi_cmpt_mode_idle               .de = multi_cmpt_mode_en;
+    assign hw2reg.output_status.j_mem_bank_active                  .de = 1'b1;
+    assign hw2reg.output_status.flip_mem_bank_active               .de = 1'b1;
+    assign hw2reg.restart_queue_status.ready                       .de = 1'b1;
+    assign hw2reg.restart_queue_status.store_cnt                   .de = 1'b1;
+    assign hw2reg.restart_queue_status.overflow                    .de = 1'b1;
+    assign hw2reg.replica_exchange_status                          .de = 1'b1;
     assign hw2reg.debug_fm_energy_input                            .de = ctnus_dgt_debug;
     assign hw2reg.energy_fifo_data_0                               .de = cmpt_idle_posedge | (ctnus_dgt_debug & energy_fifo_update) | ctnus_fifo_read;
     assign hw2reg.energy_fifo_data_1                               .de = cmpt_idle_posedge | (ctnus_dgt_debug & energy_fifo_update) | ctnus_fifo_read;
     assign hw2reg.cmpt_idx                                         .de = en_perf_counter;
+    assign hw2reg.checkpoint_status.flip_raddr                     .de = cmpt_idle_posedge;
+    assign hw2reg.checkpoint_status.spin_fifo_head                 .de = cmpt_idle_posedge;
+    assign hw2reg.topk_status                                      .de = 1'b1;
+    assign hw2reg.topk_energy                                      .de = 1'b1;
+    assign hw2reg.accept_status                                    .de = 1'b1;
+    assign hw2reg.pack_status                                      .de = 1'b1;
+    assign hw2reg.pack_energy                                      .de = 1'b1;
+    assign hw2reg.oracle_status.done                               .de = 1'b1;
+    assign hw2reg.oracle_status.cnt                                .de = 1'b1;
+    assign hw2reg.flip_ring_status                                 .de = 1'b1;
+    assign hw2reg.hist_count                                       .de = 1'b1;
+    assign hw2reg.hist_under                                       .de = 1'b1;
+    assign hw2reg.hist_over                                        .de = 1'b1;
     assign hw2reg.cycle_per_cmpt_and_iter.cmpt_idle                .de = en_perf_counter; // a copy of cmpt_idle
     assign hw2reg.cycle_per_cmpt_and_iter.fm_rx_cnt_l7b            .de = en_perf_counter;
     assign hw2reg.cycle_per_cmpt_and_iter.cycle_per_iteration      .de = en_perf_counter & (cycle_per_iter_recount_en | cmpt_idle_posedge | ctnus_dgt_debug);
@@ -337,6 +551,9 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     assign hw2reg.flip_mem_ren_raddr.flip_q_valid                  .de = ctnus_dgt_debug;
     assign hw2reg.flip_mem_ren_raddr.flip_raddr                    .de = ctnus_dgt_debug;
     assign hw2reg.flip_mem_ren_raddr.debug_spin_waddr              .de = ctnus_dgt_debug;
+    assign hw2reg.flip_mem_ren_raddr.ring_low                      .de = 1'b1;
+    assign hw2reg.flip_mem_ren_raddr.ring_high                     .de = 1'b1;
+    assign hw2reg.flip_mem_ren_raddr.ring_stall                    .de = 1'b1;
     assign hw2reg.j_mem_ren_raddr.j_mem_ren_load                   .de = ctnus_dgt_debug;
     assign hw2reg.j_mem_ren_raddr.dgt_weight_ren                   .de = ctnus_dgt_debug;
     assign hw2reg.j_mem_ren_raddr.j_raddr_load                     .de = ctnus_dgt_debug;
@@ -367,10 +584,30 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     assign hw2reg.output_status.debug_aw_downstream_handshake       .d = debug_aw_downstream_handshake;
     assign hw2reg.output_status.debug_em_upstream_handshake         .d = debug_em_upstream_handshake;
     assign hw2reg.output_status.multi_cmpt_mode_idle                .d = multi_cmpt_mode_idle;
+    assign hw2reg.output_status.j_mem_bank_active                   .d = j_mem_bank_active;
+    assign hw2reg.output_status.flip_mem_bank_active                .d = flip_mem_bank_active;
+    assign hw2reg.restart_queue_status.ready                        .d = rq_ready;
+    assign hw2reg.restart_queue_status.store_cnt                    .d = rq_store_cnt;
+    assign hw2reg.restart_queue_status.overflow                     .d = rq_overflow;
+    assign hw2reg.replica_exchange_status                           .d = xchg_swap_cnt_i;
     assign hw2reg.debug_fm_energy_input                             .d = debug_fm_energy_input;
     assign hw2reg.energy_fifo_data_0                                .d = energy_fifo_data[0];
     assign hw2reg.energy_fifo_data_1                                .d = energy_fifo_data[1];
     assign hw2reg.cmpt_idx                                          .d = cmpt_idx;
+    assign hw2reg.checkpoint_status.flip_raddr                      .d = ckpt_flip_raddr;
+    assign hw2reg.checkpoint_status.spin_fifo_head                  .d = ckpt_spin_fifo_head;
+    assign hw2reg.topk_status                                       .d = topk_count;
+    assign hw2reg.topk_energy                                       .d = topk_energy;
+    assign hw2reg.accept_status.accept_temp                         .d = accept_temp;
+    assign hw2reg.accept_status.accept_uphill_cnt                   .d = accept_uphill_cnt;
+    assign hw2reg.pack_status                                       .d = pack_valid;
+    assign hw2reg.pack_energy                                       .d = pack_energy;
+    assign hw2reg.oracle_status.done                                .d = oracle_done;
+    assign hw2reg.oracle_status.cnt                                 .d = oracle_cnt;
+    assign hw2reg.flip_ring_status                                  .d = ring_read_cnt;
+    assign hw2reg.hist_count                                        .d = hist_cnt;
+    assign hw2reg.hist_under                                        .d = hist_under;
+    assign hw2reg.hist_over                                         .d = hist_over;
     assign hw2reg.cycle_per_cmpt_and_iter.cmpt_idle                 .d = cmpt_idle;
     assign hw2reg.cycle_per_cmpt_and_iter.fm_rx_cnt_l7b             .d = fm_upstream_handshake_counter[6:0];
     assign hw2reg.cycle_per_cmpt_and_iter.cycle_per_iteration       .d = cycle_per_iteration;
@@ -382,6 +619,9 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     assign hw2reg.flip_mem_ren_raddr.flip_q_valid                   .d = drt_s_req_flip.q_valid;
     assign hw2reg.flip_mem_ren_raddr.flip_raddr                     .d = flip_raddr;
     assign hw2reg.flip_mem_ren_raddr.debug_spin_waddr               .d = debug_spin_waddr;
+    assign hw2reg.flip_mem_ren_raddr.ring_low                       .d = ring_en & (ring_level <= ring_low_wm);
+    assign hw2reg.flip_mem_ren_raddr.ring_high                      .d = ring_en & (ring_level >= ring_high_wm);
+    assign hw2reg.flip_mem_ren_raddr.ring_stall                     .d = ring_stall;
     assign hw2reg.j_mem_ren_raddr.j_mem_ren_load                    .d = j_mem_ren_load;
     assign hw2reg.j_mem_ren_raddr.dgt_weight_ren                    .d = dgt_weight_ren;
     assign hw2reg.j_mem_ren_raddr.j_raddr_load                      .d = j_raddr_load;
@@ -404,12 +644,16 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
             hw2reg.debug_fm_spin_out[i].de = ctnus_dgt_debug;
             hw2reg.debug_aw_spin_out[i].de = ctnus_dgt_debug;
             hw2reg.debug_em_spin_in [i].de = ctnus_dgt_debug;
+            hw2reg.topk_spin        [i].de = 1'b1;
+            hw2reg.pack_spin        [i].de = 1'b1;
 
             hw2reg.spin_fifo_data_0 [i].d = spin_fifo_data[0][i*`LAGD_REG_DATA_WIDTH +: `LAGD_REG_DATA_WIDTH];
             hw2reg.spin_fifo_data_1 [i].d = spin_fifo_data[1][i*`LAGD_REG_DATA_WIDTH +: `LAGD_REG_DATA_WIDTH];
             hw2reg.debug_fm_spin_out[i].d = debug_fm_spin_out[i*`LAGD_REG_DATA_WIDTH +: `LAGD_REG_DATA_WIDTH];
             hw2reg.debug_aw_spin_out[i].d = debug_aw_spin_out[i*`LAGD_REG_DATA_WIDTH +: `LAGD_REG_DATA_WIDTH];
             hw2reg.debug_em_spin_in [i].d = debug_em_spin_in [i*`LAGD_REG_DATA_WIDTH +: `LAGD_REG_DATA_WIDTH];
+            hw2reg.topk_spin        [i].d = topk_spin        [i*`LAGD_REG_DATA_WIDTH +: `LAGD_REG_DATA_WIDTH];
+            hw2reg.pack_spin        [i].d = pack_spin        [i*`LAGD_REG_DATA_WIDTH +: `LAGD_REG_DATA_WIDTH];
         end
     end
 
@@ -449,8 +693,8 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     // Digital Macro /////////////////////////////////////////
     //////////////////////////////////////////////////////////
 
-    assign j_rdata = drt_s_rsp_j.p.data;
-    assign dgt_weight = drt_s_rsp_j.p.data;
+    assign j_rdata = j_rdata_unpacked;
+    assign dgt_weight = j_rdata_unpacked;
     assign flip_rdata = drt_s_rsp_flip.p.data;
 
     digital_macro #(
@@ -464,8 +708,13 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
         .PIPESINTF                       (logic_cfg.PipesIntf              ),
         .PIPESMID                        (logic_cfg.PipesMid               ),
         .PIPESFLIPFILTER                 (logic_cfg.PipesFlipFilter        ),
+        .PIPESJREAD                      (logic_cfg.PipesJRead             ),
+        .PIPESFLIPENGINE                 (logic_cfg.PipesFlipEngine        ),
+        .EM_BATCH                        (logic_cfg.EmBatch                ),
         .SPIN_DEPTH                      (logic_cfg.SpinDepth              ),
         .FLIP_ICON_DEPTH                 (logic_cfg.FlipIconDepth          ),
+        .TOPK                            (logic_cfg.TopK                   ),
+        .PACK_BLOCKS                     (logic_cfg.PackBlocks             ),
         .COUNTER_BITWIDTH                (logic_cfg.CounterBitwidth        ),
         .SYNCHRONIZER_PIPEDEPTH          (logic_cfg.SynchronizerPipeDepth  ),
         .SPIN_WBL_OFFSET                 (logic_cfg.SpinWblOffset          ),
@@ -490,8 +739,8 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
         .debug_dt_configure_enable_i     (debug_dt_configure_enable        ),
         .debug_spin_configure_enable_i   (debug_spin_configure_enable      ),
         .config_counter_i                (config_counter                   ),
-        .config_spin_initial_i           (config_spin_initial              ),
-        .config_spin_initial_skip_i      (config_spin_initial_skip         ),
+        .config_spin_initial_i           (config_spin_initial_dgt          ),
+        .config_spin_initial_skip_i      (config_spin_initial_skip_dgt     ),
         .cfg_trans_num_i                 (cfg_trans_num                    ),
         .cycle_per_wwl_high_i            (cycle_per_wwl_high               ),
         .cycle_per_wwl_low_i             (cycle_per_wwl_low                ),
@@ -507,6 +756,7 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
         .debug_cycle_per_spin_read_i     (debug_cycle_per_spin_read        ),
         .debug_spin_read_num_i           (debug_spin_read_num              ),
         .dt_cfg_enable_i                 (dt_cfg_enable                    ),
+        .dt_cfg_h_only_i                 (dt_cfg_h_only                    ),
         .j_mem_ren_o                     (j_mem_ren_load                   ),
         .j_raddr_o                       (j_raddr_load                     ),
         .j_rdata_i                       (j_rdata                          ),
@@ -515,6 +765,14 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
         .dt_cfg_idle_o                   (dt_cfg_idle                      ),
         .flush_i                         (flush_en                         ),
         .en_comparison_i                 (en_comparison                    ),
+        .accept_mode_i                   (accept_mode                      ),
+        .accept_t_start_i                (accept_t_start                   ),
+        .accept_t_min_i                  (accept_t_min                     ),
+        .accept_t_decay_shift_i          (accept_t_decay_shift             ),
+        .accept_t_interval_i             (accept_t_interval                ),
+        .accept_seed_i                   (accept_seed                      ),
+        .accept_temp_o                   (accept_temp                      ),
+        .accept_uphill_cnt_o             (accept_uphill_cnt                ),
         .cmpt_en_i                       (cmpt_en                          ),
         .cmpt_idle_o                     (cmpt_idle                        ),
         .host_readout_i                  (host_readout                     ),
@@ -523,9 +781,15 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
         .icon_last_raddr_plus_one_i      (icon_last_raddr_plus_one         ),
         .flip_rdata_i                    (flip_rdata                       ),
         .flip_disable_i                  (flip_disable                     ),
+        .ring_en_i                       (ring_en                          ),
+        .ring_fill_cnt_i                 (ring_fill_cnt                    ),
+        .ring_total_i                    (ring_total                       ),
+        .ring_read_cnt_o                 (ring_read_cnt                    ),
+        .ring_stall_o                    (ring_stall                       ),
         .dgt_weight_ren_o                (dgt_weight_ren                   ),
         .dgt_weight_raddr_o              (dgt_weight_raddr                 ),
         .dgt_addr_upper_bound_i          (dgt_addr_upper_bound             ),
+        .dgt_nz_block_mask_i             (dgt_nz_block_mask                ),
         .dgt_weight_i                    (dgt_weight                       ),
         .dgt_hbias_i                     (dgt_hbias                        ),
         .dgt_hscaling_i                  (dgt_hscaling                     ),
@@ -546,6 +810,29 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
         .energy_fifo_o                   (energy_fifo_data                 ),
         .spin_fifo_o                     (spin_fifo_data                   ),
         .enable_flip_detection_i         (enable_flip_detection            ),
+        .em_batch_en_i                   (em_batch_en                      ),
+        .em_batch_timeout_i              (em_batch_timeout                 ),
+        .topk_en_i                       (topk_en                          ),
+        .topk_clear_i                    (topk_clear                       ),
+        .topk_k_i                        (topk_k                           ),
+        .topk_rd_idx_i                   (topk_rd_idx                      ),
+        .topk_count_o                    (topk_count                       ),
+        .topk_energy_o                   (topk_energy                      ),
+        .topk_spin_o                     (topk_spin                        ),
+        .pack_en_i                       (pack_en                          ),
+        .pack_clear_i                    (pack_clear                       ),
+        .pack_blocks_log2_i              (pack_blocks_log2                 ),
+        .pack_rd_idx_i                   (pack_rd_idx                      ),
+        .pack_valid_o                    (pack_valid                       ),
+        .pack_energy_o                   (pack_energy                      ),
+        .pack_spin_o                     (pack_spin                        ),
+        .oracle_en_i                     (oracle_en                        ),
+        .oracle_spin_valid_i             (oracle_spin_valid                ),
+        .oracle_spin_ready_o             (oracle_spin_ready                ),
+        .oracle_spin_i                   (oracle_spin                      ),
+        .oracle_energy_valid_o           (oracle_energy_valid              ),
+        .oracle_energy_ready_i           (oracle_energy_ready              ),
+        .oracle_energy_o                 (oracle_energy                    ),
         // debugging interface
         .debug_j_write_en_i              (debug_j_write_en                 ),
         .debug_j_read_en_i               (debug_j_read_en                  ),
@@ -577,7 +864,14 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
         .debug_em_spin_in_o              (debug_em_spin_in                 ),
         .infinite_icon_loop_en_i         (infinite_icon_loop_en            ),
         .multi_cmpt_mode_en_i            (multi_cmpt_mode_en               ),
+        .multi_cmpt_hold_i               (replica_exchange_en & ~xchg_release_i),
         .cmpt_max_num_i                  (cmpt_max_num                     ),
+        .cmpt_pause_i                    (cmpt_pause                       ),
+        .cmpt_resume_i                   (cmpt_resume                      ),
+        .resume_flip_raddr_i             (resume_flip_raddr                ),
+        .resume_energy_i                 (resume_energy                    ),
+        .flip_raddr_q_o                  (ckpt_flip_raddr                  ),
+        .spin_fifo_head_o                (ckpt_spin_fifo_head              ),
         .multi_cmpt_mode_idle_o          (multi_cmpt_mode_idle             ),
         .cycle_per_iter_recount_en_o     (cycle_per_iter_recount_en        ),
         .fm_upstream_handshake_counter_o (fm_upstream_handshake_counter    ),
@@ -588,22 +882,174 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
     );
 
 
+    //////////////////////////////////////////////////////////
+    // Restart queue /////////////////////////////////////////
+    //////////////////////////////////////////////////////////
+    // Initial spins of each restart come from the flip memory instead of the CSRs when enabled,
+    // or from the replica exchange after the first exchange of a multi-cmpt run.
+    always_comb begin
+        if (xchg_spin_sel) begin
+            config_spin_initial_dgt = xchg_spin_i;
+            config_spin_initial_skip_dgt = '0;
+        end else if (restart_queue_en) begin
+            config_spin_initial_dgt = rq_spin_initial;
+            config_spin_initial_skip_dgt = '0;
+        end else begin
+            config_spin_initial_dgt = config_spin_initial;
+            config_spin_initial_skip_dgt = config_spin_initial_skip;
+        end
+    end
+    // flip icon reads and debug spin writes have priority
+    assign rq_mem_gnt = ~flip_ren & ~debug_spin_valid;
+
+    restart_queue #(
+        .NUM_SPIN              (logic_cfg.NumSpin          ),
+        .SPIN_DEPTH            (logic_cfg.SpinDepth        ),
+        .ENERGY_TOTAL_BIT      (logic_cfg.EnergyTotalBit   ),
+        .ADDR_WIDTH            (logic_cfg.FmemAddrBitwidth ),
+        .IDX_WIDTH             (16                         )
+    ) u_restart_queue (
+        .clk_i                 (clk_i                      ),
+        .rst_ni                (rst_ni                     ),
+        .en_i                  (restart_queue_en           ),
+        .state_base_i          (restart_queue_state_base   ),
+        .result_base_i         (restart_queue_result_base  ),
+        .fetch_i               (cmpt_idle_negedge          ),
+        .store_i               (cmpt_idle_posedge          ),
+        .spin_fifo_i           (spin_fifo_data             ),
+        .energy_fifo_i         (energy_fifo_data           ),
+        .mem_req_o             (rq_mem_req                 ),
+        .mem_gnt_i             (rq_mem_gnt                 ),
+        .mem_we_o              (rq_mem_we                  ),
+        .mem_addr_o            (rq_mem_addr                ),
+        .mem_wdata_o           (rq_mem_wdata               ),
+        .mem_rdata_i           (flip_rdata                 ),
+        .spin_initial_o        (rq_spin_initial            ),
+        .ready_o               (rq_ready                   ),
+        .store_cnt_o           (rq_store_cnt               ),
+        .overflow_o            (rq_overflow                )
+    );
+
+    //////////////////////////////////////////////////////////
+    // Final-energy histogram ////////////////////////////////
+    //////////////////////////////////////////////////////////
+    // The final energies of every computation (as latched in energy_fifo_data) are binned, so the
+    // statistics of a multi-cmpt campaign are read out once at the end.
+    if (logic_cfg.HistBins > 0) begin: gen_energy_histogram
+        localparam int HIST_NBIN_BIT = $clog2(logic_cfg.HistBins + 1);
+
+        energy_histogram #(
+            .SPIN_DEPTH            (logic_cfg.SpinDepth        ),
+            .ENERGY_TOTAL_BIT      (logic_cfg.EnergyTotalBit   ),
+            .NUM_BINS              (logic_cfg.HistBins         ),
+            .CNT_BIT               (32                         ),
+            .RD_IDX_BIT            ($bits(hist_rd_idx)         )
+        ) u_energy_histogram (
+            .clk_i                 (clk_i                      ),
+            .rst_ni                (rst_ni                     ),
+            .en_i                  (hist_en                    ),
+            .clear_i               (hist_clear | flush_en      ),
+            .base_i                (hist_base                  ),
+            .shift_i               (hist_shift                 ),
+            .num_bins_i            ((hist_num_bins > logic_cfg.HistBins) ? HIST_NBIN_BIT'(logic_cfg.HistBins) : HIST_NBIN_BIT'(hist_num_bins)),
+            .store_i               (cmpt_idle_posedge          ),
+            .energy_fifo_i         (energy_fifo_data           ),
+            .rd_idx_i              (hist_rd_idx                ),
+            .rd_cnt_o              (hist_cnt                   ),
+            .under_o               (hist_under                 ),
+            .over_o                (hist_over                  ),
+            .busy_o                (                           )
+        );
+    end else begin: gen_no_energy_histogram
+        assign hist_cnt = '0;
+        assign hist_under = '0;
+        assign hist_over = '0;
+    end
+
+    //////////////////////////////////////////////////////////
+    // Energy oracle /////////////////////////////////////////
+    //////////////////////////////////////////////////////////
+    // Host-supplied spin vectors in the flip memory are evaluated by the energy monitor and their
+    // energies written back to the flip memory. The restart queue has priority on the memory.
+    assign oracle_mem_gnt = rq_mem_gnt & ~rq_mem_req;
+
+    energy_oracle #(
+        .NUM_SPIN              (logic_cfg.NumSpin          ),
+        .ENERGY_TOTAL_BIT      (logic_cfg.EnergyTotalBit   ),
+        .ADDR_WIDTH            (logic_cfg.FmemAddrBitwidth ),
+        .CNT_WIDTH             (16                         )
+    ) u_energy_oracle (
+        .clk_i                 (clk_i                      ),
+        .rst_ni                (rst_ni                     ),
+        .en_i                  (oracle_en                  ),
+        .src_base_i            (oracle_src_base            ),
+        .dst_base_i            (oracle_dst_base            ),
+        .num_i                 (oracle_num                 ),
+        .spin_valid_o          (oracle_spin_valid          ),
+        .spin_ready_i          (oracle_spin_ready          ),
+        .spin_o                (oracle_spin                ),
+        .energy_valid_i        (oracle_energy_valid        ),
+        .energy_ready_o        (oracle_energy_ready        ),
+        .energy_i              (oracle_energy              ),
+        .mem_req_o             (oracle_mem_req             ),
+        .mem_gnt_i             (oracle_mem_gnt             ),
+        .mem_we_o              (oracle_mem_we              ),
+        .mem_addr_o            (oracle_mem_addr            ),
+        .mem_wdata_o           (oracle_mem_wdata           ),
+        .mem_rdata_i           (flip_rdata                 ),
+        .done_o                (oracle_done                ),
+        .cnt_o                 (oracle_cnt                 )
+    );
+
+    //////////////////////////////////////////////////////////
+    // Replica exchange //////////////////////////////////////
+    //////////////////////////////////////////////////////////
+    // The exchange itself is done in lagd_soc; the next computation waits for xchg_release_i.
+    // Once the multi-cmpt run of the core is over, it leaves the exchange until its next run, so
+    // that cores with a larger cmpt_max_num are not left waiting for it.
+    `FFL(multi_cmpt_mode_idle_dly1, multi_cmpt_mode_idle, 1'b1, 1'b1, clk_i, rst_ni)
+    `FFLARNC(xchg_finished, 1'b1, multi_cmpt_mode_idle & ~multi_cmpt_mode_idle_dly1, ~multi_cmpt_mode_idle | ~replica_exchange_en, 1'b0, clk_i, rst_ni)
+    assign xchg_en_o = replica_exchange_en & ~xchg_finished;
+    assign xchg_done_o = replica_exchange_en & cmpt_idle_posedge;
+    assign xchg_pair_temp_o = replica_exchange_pair_temp;
+    assign xchg_interval_o = replica_exchange_interval;
+    assign xchg_spin_o = spin_fifo_data;
+    assign xchg_energy_o = energy_fifo_data;
+
+    `FFLARNC(xchg_spin_sel, 1'b1, replica_exchange_en & xchg_release_i, multi_cmpt_mode_idle | ~replica_exchange_en, 1'b0, clk_i, rst_ni)
+
     //////////////////////////////////////////////////////////
     // Memory MUX ////////////////////////////////////////////
     //////////////////////////////////////////////////////////
     // flip memory request mux
     always_comb begin
-        case(debug_spin_valid)
-            1'b0: begin: no_debug_spin_read
-                drt_s_req_flip.q.addr          = flip_raddr << $clog2(`IC_L1_FLIP_MEM_DATA_WIDTH/8); // word address to byte address
+        case({debug_spin_valid, rq_mem_req & rq_mem_gnt, oracle_mem_req & oracle_mem_gnt})
+            3'b000: begin: no_debug_spin_read
+                drt_s_req_flip.q.addr          = flip_mem_bank_offset + (flip_raddr << $clog2(`IC_L1_FLIP_MEM_DATA_WIDTH/8)); // word address to byte address
                 drt_s_req_flip.q.write         = 1'b0; // read
                 drt_s_req_flip.q.data          = {`IC_L1_FLIP_MEM_DATA_WIDTH{1'b0}}; // not used for read
                 drt_s_req_flip.q.strb          = {(`IC_L1_FLIP_MEM_DATA_WIDTH/8){1'b1}};
                 drt_s_req_flip.q.user          = 'd0; // not used
                 drt_s_req_flip.q_valid         = flip_ren;
             end
-            1'b1: begin: debug_spin_read
-                drt_s_req_flip.q.addr          = debug_spin_waddr << $clog2(`IC_L1_FLIP_MEM_DATA_WIDTH/8); // word address to byte address
+            3'b001: begin: energy_oracle_access
+                drt_s_req_flip.q.addr          = flip_mem_bank_offset + (oracle_mem_addr << $clog2(`IC_L1_FLIP_MEM_DATA_WIDTH/8)); // word address to byte address
+                drt_s_req_flip.q.write         = oracle_mem_we;
+                drt_s_req_flip.q.data          = oracle_mem_wdata;
+                drt_s_req_flip.q.strb          = {(`IC_L1_FLIP_MEM_DATA_WIDTH/8){1'b1}};
+                drt_s_req_flip.q.user          = 'd0; // not used
+                drt_s_req_flip.q_valid         = 1'b1;
+            end
+            3'b010: begin: restart_queue_access
+                drt_s_req_flip.q.addr          = flip_mem_bank_offset + (rq_mem_addr << $clog2(`IC_L1_FLIP_MEM_DATA_WIDTH/8)); // word address to byte address
+                drt_s_req_flip.q.write         = rq_mem_we;
+                drt_s_req_flip.q.data          = rq_mem_wdata;
+                drt_s_req_flip.q.strb          = {(`IC_L1_FLIP_MEM_DATA_WIDTH/8){1'b1}};
+                drt_s_req_flip.q.user          = 'd0; // not used
+                drt_s_req_flip.q_valid         = 1'b1;
+            end
+            default: begin: debug_spin_read
+                drt_s_req_flip.q.addr          = flip_mem_bank_offset + (debug_spin_waddr << $clog2(`IC_L1_FLIP_MEM_DATA_WIDTH/8)); // word address to byte address
                 drt_s_req_flip.q.write         = 1'b1; // write
                 drt_s_req_flip.q.data          = debug_spin_out;
                 drt_s_req_flip.q.strb          = {(`IC_L1_FLIP_MEM_DATA_WIDTH/8){1'b1}};
@@ -613,26 +1059,38 @@ module ising_core_wrap import axi_pkg::*; import memory_island_pkg::*; import is
         endcase
     end
 
-    // j memory request mux
-    always_comb begin
-        case(dt_cfg_enable | (~dt_cfg_idle))
-            1'b0: begin: compute_mode
-                drt_s_req_j.q.addr         = dgt_weight_raddr << $clog2(`IC_L1_J_MEM_DATA_WIDTH/8); // word address to byte address
-                drt_s_req_j.q.write        = 1'b0; // read
-                drt_s_req_j.q.data         = {`IC_L1_J_MEM_DATA_WIDTH{1'b0}}; // not used for read
-                drt_s_req_j.q.strb         = {(`IC_L1_J_MEM_DATA_WIDTH/8){1'b1}};
-                drt_s_req_j.q.user         = 'd0; // not used
-                drt_s_req_j.q_valid        = dgt_weight_ren;
-            end
-            1'b1: begin: load_mode
-                drt_s_req_j.q.addr         = j_raddr_load << $clog2(`IC_L1_J_MEM_DATA_WIDTH/8); // word address to byte address
-                drt_s_req_j.q.write        = 1'b0; // read
-                drt_s_req_j.q.data         = {`IC_L1_J_MEM_DATA_WIDTH{1'b0}}; // not used for read
-                drt_s_req_j.q.strb         = {(`IC_L1_J_MEM_DATA_WIDTH/8){1'b1}};
-                drt_s_req_j.q.user         = 'd0; // not used
-                drt_s_req_j.q_valid        = j_mem_ren_load;
-            end
-        endcase
-    end
+    // j memory logical read request mux
+    assign j_mem_load_mode = dt_cfg_enable | (~dt_cfg_idle);
+    assign j_logical_ren = j_mem_load_mode ? j_mem_ren_load : dgt_weight_ren;
+    assign j_logical_raddr = j_mem_load_mode ? j_raddr_load : dgt_weight_raddr;
+    // J may be rewritten by the host between onloading/computation runs
+    assign j_precision_clear = (dt_cfg_enable & dt_cfg_idle) | (cmpt_en & cmpt_idle) | flush_en;
+
+    // j memory precision adapter (2-bit packed J is unpacked here)
+    j_precision_adapter #(
+        .NUM_SPIN              (logic_cfg.NumSpin          ),
+        .BITJ                  (logic_cfg.BitJ             ),
+        .PARALLELISM           (logic_cfg.Parallelism      ),
+        .ADDR_WIDTH            (logic_cfg.JmemAddrBitwidth )
+    ) u_j_precision_adapter (
+        .clk_i                 (clk_i                      ),
+        .rst_ni                (rst_ni                     ),
+        .precision_2b_i        (j_precision_2b             ),
+        .clear_i               (j_precision_clear          ),
+        .ren_i                 (j_logical_ren              ),
+        .raddr_i               (j_logical_raddr            ),
+        .rdata_o               (j_rdata_unpacked           ),
+        .ren_o                 (j_mem_ren                  ),
+        .raddr_o               (j_mem_raddr                ),
+        .rdata_i               (drt_s_rsp_j.p.data         )
+    );
+
+    // j memory request
+    assign drt_s_req_j.q.addr  = j_mem_bank_offset + (j_mem_raddr << $clog2(`IC_L1_J_MEM_DATA_WIDTH/8)); // word address to byte address
+    assign drt_s_req_j.q.write = 1'b0; // read
+    assign drt_s_req_j.q.data  = {`IC_L1_J_MEM_DATA_WIDTH{1'b0}}; // not used for read
+    assign drt_s_req_j.q.strb  = {(`IC_L1_J_MEM_DATA_WIDTH/8){1'b1}};
+    assign drt_s_req_j.q.user  = 'd0; // not used
+    assign drt_s_req_j.q_valid = j_mem_ren;
 
 endmodule
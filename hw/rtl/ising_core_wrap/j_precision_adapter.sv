@@ -0,0 +1,86 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// This module sits between the J memory wide port and its readers (analog_cfg during onloading and
+// the energy monitor during computation) and implements the runtime 2-bit J precision mode.
+// In 4-bit mode it is transparent. In 2-bit mode each memory word holds two logical words
+// (2*PARALLELISM rows of NUM_SPIN 2-bit two's complement couplings, row 0 at the LSBs):
+// - the logical read address is halved to get the physical address,
+// - a read whose physical address equals the last one read is dropped, as the memory output
+//   holds its data between reads (the same property analog_cfg relies on when muxing rows),
+// - the returned word is unpacked by sign-extending the selected half to the BITJ-bit layout.
+// Readers are unaware of the mode: data is still valid one cycle after the logical read.
+//
+// Parameters:
+// - NUM_SPIN: the number of spins (couplings per row)
+// - BITJ: bit width of each coupling in the standard layout
+// - PARALLELISM: number of rows per logical memory word
+// - ADDR_WIDTH: width of the (logical and physical) word address
+//
+// Ports:
+// - precision_2b_i: 1 to read 2-bit packed J, 0 for the standard BITJ-bit layout
+// - clear_i: forget the last physical address read (e.g. when the memory content may have changed)
+// - ren_i, raddr_i: logical read request from the reader
+// - ren_o, raddr_o: physical read request to the memory
+// - rdata_i: memory read data
+// - rdata_o: unpacked read data to the reader
+
+`include "common_cells/registers.svh"
+
+module j_precision_adapter #(
+    parameter int NUM_SPIN = 256,
+    parameter int BITJ = 4,
+    parameter int PARALLELISM = 4,
+    parameter int ADDR_WIDTH = 6,
+    // derived parameters
+    parameter int DATA_WIDTH = NUM_SPIN * BITJ * PARALLELISM
+)(
+    input  logic clk_i,
+    input  logic rst_ni,
+    input  logic precision_2b_i,
+    input  logic clear_i,
+    // reader interface
+    input  logic ren_i,
+    input  logic [ADDR_WIDTH-1:0] raddr_i,
+    output logic [DATA_WIDTH-1:0] rdata_o,
+    // memory interface
+    output logic ren_o,
+    output logic [ADDR_WIDTH-1:0] raddr_o,
+    input  logic [DATA_WIDTH-1:0] rdata_i
+);
+    localparam int NUM_ELEM_PER_WORD = NUM_SPIN * PARALLELISM;
+
+    logic [ADDR_WIDTH-1:0] raddr_last;
+    logic raddr_last_valid;
+    logic read_hit;
+    logic half_sel;
+    logic [DATA_WIDTH-1:0] rdata_unpacked;
+
+    // address translation and read suppression
+    assign raddr_o = precision_2b_i ? (raddr_i >> 1) : raddr_i;
+    assign read_hit = precision_2b_i & raddr_last_valid & (raddr_o == raddr_last);
+    assign ren_o = ren_i & ~read_hit;
+
+    `FFLARNC(raddr_last, raddr_o, ren_o, clear_i | ~precision_2b_i, 'd0, clk_i, rst_ni)
+    `FFLARNC(raddr_last_valid, 1'b1, ren_o, clear_i | ~precision_2b_i, 1'b0, clk_i, rst_ni)
+    // aligned with the memory read latency
+    `FFL(half_sel, raddr_i[0], ren_i, 1'b0, clk_i, rst_ni)
+
+    // unpacking: element e of the selected half is sign-extended to element e of the output
+    always_comb begin
+        rdata_unpacked = 'd0;
+        for (int e = 0; e < NUM_ELEM_PER_WORD; e = e + 1) begin
+            rdata_unpacked[e*BITJ +: BITJ] = {
+                {(BITJ-1){rdata_i[(half_sel*NUM_ELEM_PER_WORD + e)*2 + 1]}},
+                rdata_i[(half_sel*NUM_ELEM_PER_WORD + e)*2]
+            };
+        end
+    end
+
+    assign rdata_o = precision_2b_i ? rdata_unpacked : rdata_i;
+
+endmodule
@@ -0,0 +1,159 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// This module provides a different set of initial spins for each computation in multi-cmpt
+// mode, and stores the result of each computation, so a multi-start campaign runs without host
+// intervention. Both lists live in the flip memory (one spin vector per word):
+// - restart states: restart n uses the SPIN_DEPTH words at state_base_i + n*SPIN_DEPTH.
+// - results: computation n writes its SPIN_DEPTH final spin vectors followed by one word with the
+//   SPIN_DEPTH final energies (energy k at bits [k*ENERGY_TOTAL_BIT +: ENERGY_TOTAL_BIT]) to
+//   result_base_i + n*(SPIN_DEPTH+1).
+// The states of restart n+1 are prefetched as soon as computation n starts, so they are ready
+// when the next configuration starts. Memory accesses have a lower priority than the flip icon
+// reads and are only issued when mem_gnt_i is set; read data is expected one cycle later.
+// Addresses are computed at full width: an access past the last flip memory word is dropped
+// instead of wrapping around onto the flip icons, and flagged in overflow_o if it is a result
+// store or if a computation starts from states that could not be fetched.
+// Capacity: a restart takes 2*SPIN_DEPTH+1 flip memory words, so the words left behind the flip
+// icons hold (1024 - icons) / (2*SPIN_DEPTH+1) restarts of a 1024-word flip memory, about 100
+// with SPIN_DEPTH = 2 and 512 icons, and about 200 without icons. Longer campaigns are run in
+// rounds, the host refilling the states and reading the results between two multi-cmpt runs.
+//
+// Parameters:
+// - NUM_SPIN: the number of spins (equal to the flip memory data width)
+// - SPIN_DEPTH: depth of the spin FIFO (initial spins per restart)
+// - ENERGY_TOTAL_BIT: bit width of each energy value, SPIN_DEPTH*ENERGY_TOTAL_BIT <= NUM_SPIN
+// - ADDR_WIDTH: width of the flip memory word address
+// - IDX_WIDTH: width of the restart/result index counters
+//
+// Ports:
+// - en_i: enable the restart queue; a rising edge restarts both lists and prefetches restart 0
+// - state_base_i, result_base_i: word addresses of the restart state list and the result list
+// - fetch_i: 1-cycle pulse when a computation starts (prefetch the states of the next restart)
+// - store_i: 1-cycle pulse when a computation finishes (store spin_fifo_i/energy_fifo_i)
+// - mem_*: flip memory port
+// - spin_initial_o: initial spins of the next restart
+// - ready_o: spin_initial_o holds the states of the next restart
+// - store_cnt_o: number of results stored since en_i rose
+// - overflow_o: a list ran past the end of the flip memory since en_i rose (sticky)
+
+`include "common_cells/registers.svh"
+
+module restart_queue #(
+    parameter int NUM_SPIN = 256,
+    parameter int SPIN_DEPTH = 2,
+    parameter int ENERGY_TOTAL_BIT = 32,
+    parameter int ADDR_WIDTH = 10,
+    parameter int IDX_WIDTH = 16,
+    // derived parameters
+    parameter int WORD_CNT_WIDTH = $clog2(SPIN_DEPTH + 1),
+    parameter int FULL_ADDR_WIDTH = ADDR_WIDTH + IDX_WIDTH + WORD_CNT_WIDTH
+)(
+    input  logic clk_i,
+    input  logic rst_ni,
+    input  logic en_i,
+    input  logic [ADDR_WIDTH-1:0] state_base_i,
+    input  logic [ADDR_WIDTH-1:0] result_base_i,
+    input  logic fetch_i,
+    input  logic store_i,
+    input  logic [SPIN_DEPTH*NUM_SPIN-1:0] spin_fifo_i,
+    input  logic [SPIN_DEPTH*ENERGY_TOTAL_BIT-1:0] energy_fifo_i,
+    // memory interface
+    output logic mem_req_o,
+    input  logic mem_gnt_i,
+    output logic mem_we_o,
+    output logic [ADDR_WIDTH-1:0] mem_addr_o,
+    output logic [NUM_SPIN-1:0] mem_wdata_o,
+    input  logic [NUM_SPIN-1:0] mem_rdata_i,
+    // restart states and status
+    output logic [SPIN_DEPTH*NUM_SPIN-1:0] spin_initial_o,
+    output logic ready_o,
+    output logic [IDX_WIDTH-1:0] store_cnt_o,
+    output logic overflow_o
+);
+    logic en_dly1, en_posedge;
+    logic fetch_start, store_start;
+    logic fetch_pending, store_pending;
+    logic fetch_active, store_active;
+    logic fetch_last, store_last;
+    logic mem_hdsk;
+    logic [FULL_ADDR_WIDTH-1:0] fetch_addr, store_addr;
+    logic fetch_oob, store_oob;
+    logic fetch_drop, store_drop;
+    logic fetch_dropped;
+    logic [WORD_CNT_WIDTH-1:0] fetch_word_q, store_word_q;
+    logic [IDX_WIDTH-1:0] fetch_idx_q;
+    logic rdata_valid;
+    logic [WORD_CNT_WIDTH-1:0] rdata_word;
+    logic [SPIN_DEPTH*NUM_SPIN-1:0] result_spin_q;
+    logic [SPIN_DEPTH*ENERGY_TOTAL_BIT-1:0] result_energy_q;
+
+    // control logic
+    assign en_posedge = en_i & ~en_dly1;
+    assign fetch_start = en_posedge | (en_i & fetch_i);
+    assign store_start = en_i & store_i;
+    // stores are served first as their source is only held until the next store
+    assign store_active = store_pending;
+    assign fetch_active = fetch_pending & ~store_pending;
+    assign mem_req_o = en_i & ((store_active & ~store_oob) | (fetch_active & ~fetch_oob));
+    assign mem_hdsk = mem_req_o & mem_gnt_i;
+    assign mem_we_o = store_active;
+    assign fetch_last = fetch_active & mem_hdsk & (fetch_word_q == SPIN_DEPTH - 1);
+    assign store_last = store_active & mem_hdsk & (store_word_q == SPIN_DEPTH);
+
+    // out-of-range accesses: the rest of the list entry is dropped as well
+    assign fetch_addr = state_base_i + fetch_idx_q * SPIN_DEPTH + fetch_word_q;
+    assign store_addr = result_base_i + store_cnt_o * (SPIN_DEPTH + 1) + store_word_q;
+    assign fetch_oob = (fetch_addr >> ADDR_WIDTH) != 'd0;
+    assign store_oob = (store_addr >> ADDR_WIDTH) != 'd0;
+    assign fetch_drop = en_i & fetch_active & fetch_oob;
+    assign store_drop = en_i & store_active & store_oob;
+
+    // data path
+    always_comb begin
+        if (store_active) begin
+            mem_addr_o = store_addr[ADDR_WIDTH-1:0];
+            mem_wdata_o = 'd0;
+            if (store_word_q == SPIN_DEPTH) begin
+                mem_wdata_o[SPIN_DEPTH*ENERGY_TOTAL_BIT-1:0] = result_energy_q;
+            end else begin
+                mem_wdata_o = result_spin_q[store_word_q*NUM_SPIN +: NUM_SPIN];
+            end
+        end else begin
+            mem_addr_o = fetch_addr[ADDR_WIDTH-1:0];
+            mem_wdata_o = 'd0;
+        end
+    end
+
+    `FFL(en_dly1, en_i, 1'b1, 1'b0, clk_i, rst_ni)
+
+    // restart state prefetch
+    `FFLARNC(fetch_pending, 1'b1, fetch_start, fetch_last | fetch_drop | ~en_i, 1'b0, clk_i, rst_ni)
+    `FFLARNC(fetch_word_q, fetch_word_q + 1'b1, fetch_active & mem_hdsk, fetch_start | fetch_last | fetch_drop, 'd0, clk_i, rst_ni)
+    `FFLARNC(fetch_idx_q, fetch_idx_q + 1'b1, fetch_last | fetch_drop, en_posedge, 'd0, clk_i, rst_ni)
+    // the prefetched restart could not be read; only an error once a computation starts from it
+    `FFLARNC(fetch_dropped, 1'b1, fetch_drop, fetch_start & ~fetch_drop, 1'b0, clk_i, rst_ni)
+    `FFL(rdata_valid, fetch_active & mem_hdsk, 1'b1, 1'b0, clk_i, rst_ni)
+    `FFL(rdata_word, fetch_word_q, fetch_active & mem_hdsk, 'd0, clk_i, rst_ni)
+    // ready once the last word of the prefetch is back
+    `FFLARNC(ready_o, 1'b1, rdata_valid & (rdata_word == SPIN_DEPTH - 1), fetch_start | ~en_i, 1'b0, clk_i, rst_ni)
+
+    for (genvar i = 0; i < SPIN_DEPTH; i++) begin: gen_spin_initial
+        `FFL(spin_initial_o[i*NUM_SPIN +: NUM_SPIN], mem_rdata_i, rdata_valid & (rdata_word == i), 'd0, clk_i, rst_ni)
+    end
+
+    // result store
+    `FFL(result_spin_q, spin_fifo_i, store_start, 'd0, clk_i, rst_ni)
+    `FFL(result_energy_q, energy_fifo_i, store_start, 'd0, clk_i, rst_ni)
+    `FFLARNC(store_pending, 1'b1, store_start, store_last | store_drop | ~en_i, 1'b0, clk_i, rst_ni)
+    `FFLARNC(store_word_q, store_word_q + 1'b1, store_active & mem_hdsk, store_start | store_last | store_drop, 'd0, clk_i, rst_ni)
+    `FFLARNC(store_cnt_o, store_cnt_o + 1'b1, store_last, en_posedge, 'd0, clk_i, rst_ni)
+
+    // overflow status
+    `FFLARNC(overflow_o, 1'b1, store_drop | (en_i & fetch_i & fetch_dropped), en_posedge, 1'b0, clk_i, rst_ni)
+
+endmodule
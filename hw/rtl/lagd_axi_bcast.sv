@@ -0,0 +1,108 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// This module implements a broadcast alias of one L1 memory (J or flip) of the Ising cores. The
+// alias has the layout of the memory of a single core; it sits on its own AXI slave port of the
+// external crossbar and is connected to the second AXI port of the memory of every core:
+// - writes are multicast to the cores selected by en_i: every AW and W beat is forked to all of
+//   them, and is accepted once every selected core has taken it. The B responses of the selected
+//   cores are joined into one, with the worst response code. Since every core sees the same
+//   AW/W sequence and the memories answer in order, the joined responses stay aligned,
+// - reads are served by the lowest selected core, so a broadcast load can be read back,
+// - with no core selected, the alias targets core 0 only.
+// en_i must only change while no transaction is in flight on the alias. ATOPs are not supported.
+//
+// Parameters:
+// - NUM_CORES: the number of Ising cores
+// - axi_req_t, axi_rsp_t: AXI request/response types of the cores' L1 memory ports
+//
+// Ports:
+// - slv_req_i, slv_rsp_o: AXI slave port of the alias (from the external crossbar)
+// - en_i: per core, whether the core receives the writes to the alias
+// - mst_req_o, mst_rsp_i: per core, AXI port to the broadcast port of the core's L1 memory
+
+`include "common_cells/registers.svh"
+
+module lagd_axi_bcast #(
+    parameter int NUM_CORES = 2,
+    parameter type axi_req_t = logic,
+    parameter type axi_rsp_t = logic
+)(
+    input  logic clk_i,
+    input  logic rst_ni,
+    input  axi_req_t slv_req_i,
+    output axi_rsp_t slv_rsp_o,
+    input  logic [NUM_CORES-1:0] en_i,
+    output axi_req_t [NUM_CORES-1:0] mst_req_o,
+    input  axi_rsp_t [NUM_CORES-1:0] mst_rsp_i
+);
+    localparam int IDX_BIT = NUM_CORES > 1 ? $clog2(NUM_CORES) : 1;
+
+    logic [NUM_CORES-1:0] sel;
+    logic [IDX_BIT-1:0] first;
+    logic [NUM_CORES-1:0] aw_done_q, aw_done_d, aw_acc;
+    logic [NUM_CORES-1:0] w_done_q, w_done_d, w_acc;
+    logic [NUM_CORES-1:0] b_arrived;
+    logic aw_ready, w_ready, b_valid;
+
+    // selected cores, and the lowest one (read target, B id)
+    assign sel = (en_i == '0) ? NUM_CORES'(1) : en_i;
+
+    always_comb begin
+        first = '0;
+        for (int i = NUM_CORES - 1; i >= 0; i--) begin
+            if (sel[i]) first = IDX_BIT'(i);
+        end
+    end
+
+    // AW/W fork: a core that took the current beat is masked until every selected core took it
+    for (genvar i = 0; i < NUM_CORES; i++) begin: gen_fork
+        assign aw_acc[i] = ~sel[i] | aw_done_q[i] | mst_rsp_i[i].aw_ready;
+        assign w_acc[i] = ~sel[i] | w_done_q[i] | mst_rsp_i[i].w_ready;
+        assign aw_done_d[i] = aw_ready ? 1'b0 : aw_done_q[i] | (sel[i] & slv_req_i.aw_valid & mst_rsp_i[i].aw_ready);
+        assign w_done_d[i] = w_ready ? 1'b0 : w_done_q[i] | (sel[i] & slv_req_i.w_valid & mst_rsp_i[i].w_ready);
+        assign b_arrived[i] = ~sel[i] | mst_rsp_i[i].b_valid;
+    end
+
+    assign aw_ready = &aw_acc;
+    assign w_ready = &w_acc;
+    assign b_valid = &b_arrived;
+
+    `FFL(aw_done_q, aw_done_d, 1'b1, '0, clk_i, rst_ni)
+    `FFL(w_done_q, w_done_d, 1'b1, '0, clk_i, rst_ni)
+
+    // requests to the cores
+    always_comb begin
+        for (int i = 0; i < NUM_CORES; i++) begin
+            mst_req_o[i]          = '0;
+            mst_req_o[i].aw       = slv_req_i.aw;
+            mst_req_o[i].aw_valid = slv_req_i.aw_valid & sel[i] & ~aw_done_q[i];
+            mst_req_o[i].w        = slv_req_i.w;
+            mst_req_o[i].w_valid  = slv_req_i.w_valid & sel[i] & ~w_done_q[i];
+            mst_req_o[i].b_ready  = slv_req_i.b_ready & b_valid & sel[i];
+            mst_req_o[i].ar       = slv_req_i.ar;
+            mst_req_o[i].ar_valid = slv_req_i.ar_valid & (first == IDX_BIT'(i));
+            mst_req_o[i].r_ready  = slv_req_i.r_ready & (first == IDX_BIT'(i));
+        end
+    end
+
+    // joined response
+    always_comb begin
+        slv_rsp_o          = '0;
+        slv_rsp_o.aw_ready = aw_ready;
+        slv_rsp_o.w_ready  = w_ready;
+        slv_rsp_o.b_valid  = b_valid;
+        slv_rsp_o.b        = mst_rsp_i[first].b;
+        for (int i = 0; i < NUM_CORES; i++) begin
+            if (sel[i] && mst_rsp_i[i].b.resp > slv_rsp_o.b.resp) slv_rsp_o.b.resp = mst_rsp_i[i].b.resp;
+        end
+        slv_rsp_o.ar_ready = mst_rsp_i[first].ar_ready;
+        slv_rsp_o.r_valid  = mst_rsp_i[first].r_valid;
+        slv_rsp_o.r        = mst_rsp_i[first].r;
+    end
+
+endmodule
@@ -70,15 +70,16 @@ package lagd_mem_cfg_pkg;
     };
 
     // localparam int unsigned IsingCoreJWordsPerBank = `L1_J_MEM_SIZE_B*8/`IC_L1_J_MEM_DATA_WIDTH;
-    localparam int unsigned IsingCoreJWordsPerBank = 64;
-    localparam int unsigned IsingCoreJNumNarrowBanks = `L1_J_MEM_SIZE_B*8/IsingCoreJWordsPerBank/`LAGD_AXI_DATA_WIDTH;
+    // Extra buffers deepen the banks so that the wide port width is unchanged
+    localparam int unsigned IsingCoreJWordsPerBank = 64 * `L1_NUM_BUFFERS;
+    localparam int unsigned IsingCoreJNumNarrowBanks = `IC_L1_J_MEM_REGION_B*8/IsingCoreJWordsPerBank/`LAGD_AXI_DATA_WIDTH;
     localparam memory_island_pkg::mem_cfg_t IsingCoreL1MemCfgJ = '{
         AddrWidth           : `CVA6_ADDR_WIDTH,
         NarrowDataWidth     : `LAGD_AXI_DATA_WIDTH,
         WideDataWidth       : `IC_L1_J_MEM_DATA_WIDTH,
         AxiNarrowIdWidth    : `LAGD_AXI_ID_WIDTH,
         AxiWideIdWidth      : `LAGD_AXI_ID_WIDTH,
-        NumAxiNarrowReq : 1,
+        NumAxiNarrowReq : 2, // direct and broadcast AXI ports
         NumDirectNarrowReq : 0,
         NumAxiWideReq : 0,
         NumDirectWideReq : 1,
@@ -100,15 +101,15 @@ package lagd_mem_cfg_pkg;
     };
 
     // localparam int unsigned IsingCoreFlipWordsPerBank = `L1_FLIP_MEM_SIZE_B*8/`IC_L1_FLIP_MEM_DATA_WIDTH;
-    localparam int unsigned IsingCoreFlipWordsPerBank = 1024;
-    localparam int unsigned IsingCoreFlipNumNarrowBanks = `L1_FLIP_MEM_SIZE_B*8/IsingCoreFlipWordsPerBank/`LAGD_AXI_DATA_WIDTH;
+    localparam int unsigned IsingCoreFlipWordsPerBank = 1024 * `L1_NUM_BUFFERS;
+    localparam int unsigned IsingCoreFlipNumNarrowBanks = `IC_L1_FLIP_MEM_REGION_B*8/IsingCoreFlipWordsPerBank/`LAGD_AXI_DATA_WIDTH;
     localparam memory_island_pkg::mem_cfg_t IsingCoreL1MemCfgFlip = '{
         AddrWidth           : `CVA6_ADDR_WIDTH,
         NarrowDataWidth     : `LAGD_AXI_DATA_WIDTH,
         WideDataWidth       : `IC_L1_FLIP_MEM_DATA_WIDTH,
         AxiNarrowIdWidth    : `LAGD_AXI_ID_WIDTH,
         AxiWideIdWidth      : `LAGD_AXI_ID_WIDTH,
-        NumAxiNarrowReq : 1,
+        NumAxiNarrowReq : 2, // direct and broadcast AXI ports
         NumDirectNarrowReq : 0,
         NumAxiWideReq : 0,
         NumDirectWideReq : 1,
@@ -23,12 +23,14 @@ package lagd_pkg;
         cheshire_pkg::byte_bt L2_MEM;
         cheshire_pkg::byte_bt STACK_MEM; 
         cheshire_pkg::byte_bt ISING_CORES_BASE;
+        cheshire_pkg::byte_bt ISING_BCAST_BASE;
     } lagd_slv_idx_e;
     
     localparam lagd_slv_idx_e LagdSlvIdxEnum = '{
         L2_MEM: 0,
         STACK_MEM: 1,
-        ISING_CORES_BASE: 2
+        ISING_CORES_BASE: 2,
+        ISING_BCAST_BASE: 2 + 2*`NUM_ISING_CORES
     };
 
     typedef cheshire_pkg::byte_bt [2**(cheshire_pkg::MaxExtAxiSlvWidth)-1:0] lagd_slv_idx_map_t;
@@ -48,6 +50,9 @@ package lagd_pkg;
             idx = $unsigned(IdxMap.ISING_CORES_BASE) + 2*i + 1;
             idx_map[idx] = idx;
         end
+        // J and flip broadcast aliases after the cores
+        idx_map[IdxMap.ISING_BCAST_BASE] = IdxMap.ISING_BCAST_BASE;
+        idx_map[IdxMap.ISING_BCAST_BASE + 1] = IdxMap.ISING_BCAST_BASE + 1;
         return idx_map;
     endfunction : gen_lagd_slv_idx_map
 
@@ -69,8 +74,11 @@ package lagd_pkg;
             idx = $unsigned(Idx.ISING_CORES_BASE + 2*i);
             addr_map[idx] = $unsigned(`IC_MEM_BASE_ADDR + i * `IC_L1_MEM_SIZE_B);
             idx = $unsigned(Idx.ISING_CORES_BASE + 2*i + 1);
-            addr_map[idx] = $unsigned(`IC_MEM_BASE_ADDR + i * `IC_L1_MEM_SIZE_B + `L1_J_MEM_SIZE_B);
+            addr_map[idx] = $unsigned(`IC_MEM_BASE_ADDR + i * `IC_L1_MEM_SIZE_B + `IC_L1_J_MEM_REGION_B);
         end
+        // Broadcast aliases
+        addr_map[Idx.ISING_BCAST_BASE] = `IC_BCAST_BASE_ADDR;
+        addr_map[Idx.ISING_BCAST_BASE + 1] = $unsigned(`IC_BCAST_BASE_ADDR + `IC_L1_J_MEM_REGION_B);
         return addr_map;
     endfunction : gen_lagd_slv_start_addr
 
@@ -85,10 +93,13 @@ package lagd_pkg;
         // Ising cores
         for (int unsigned i = 0; i < `NUM_ISING_CORES; i++) begin
             idx = $unsigned(Idx.ISING_CORES_BASE + 2*i);
-            addr_map[idx] = $unsigned(`IC_MEM_BASE_ADDR + i * `IC_L1_MEM_SIZE_B + `L1_J_MEM_SIZE_B - 1);
+            addr_map[idx] = $unsigned(`IC_MEM_BASE_ADDR + i * `IC_L1_MEM_SIZE_B + `IC_L1_J_MEM_REGION_B - 1);
             idx = $unsigned(Idx.ISING_CORES_BASE + 2*i + 1);
             addr_map[idx] = $unsigned(`IC_MEM_BASE_ADDR + (i+1) * `IC_L1_MEM_SIZE_B - 1);
         end
+        // Broadcast aliases
+        addr_map[Idx.ISING_BCAST_BASE] = $unsigned(`IC_BCAST_BASE_ADDR + `IC_L1_J_MEM_REGION_B - 1);
+        addr_map[Idx.ISING_BCAST_BASE + 1] = $unsigned(`IC_BCAST_BASE_ADDR + `IC_L1_MEM_SIZE_B - 1);
         return addr_map;
     endfunction : gen_lagd_slv_end_addr
 
@@ -218,11 +229,20 @@ package lagd_pkg;
     ///////////////////////////////////////
 
     // Check that the number of cores can be encoded in the AXI Slave ID width
-    `PACKAGE_ASSERT(cheshire_pkg::MaxExtAxiSlvWidth >= $clog2(`NUM_ISING_CORES + 2))
+    `PACKAGE_ASSERT(cheshire_pkg::MaxExtAxiSlvWidth >= $clog2(`LAGD_NUM_AXI_SLV))
+    // Check that the broadcast aliases do not overlap the cores' L1 memories
+    `PACKAGE_ASSERT(`IC_MEM_BASE_ADDR + `NUM_ISING_CORES * `IC_L1_MEM_SIZE_B <= `IC_BCAST_BASE_ADDR)
+    // Check that the broadcast alias is aligned like the cores' L1 memories
+    `PACKAGE_ASSERT(`IC_BCAST_BASE_ADDR % `IC_L1_MEM_SIZE_B == 0)
     // Check that the number of cores can be encoded in the Reg Slave ID width
     `PACKAGE_ASSERT(cheshire_pkg::MaxExtRegSlvWidth >= $clog2(`NUM_ISING_CORES))
     // Check that the memory per core is not larger than the maximum allowed
     `PACKAGE_ASSERT(`IC_L1_MEM_SIZE_B <= `IC_L1_MEM_LIMIT)
+    // Check that the J/flip memories are single or double buffered
+    `PACKAGE_ASSERT(`L1_NUM_BUFFERS == 1 || `L1_NUM_BUFFERS == 2)
+    // Check that the j_nz_bitmap multireg (count 2 in lagd_core_regs.hjson) has one bit per J
+    // memory word, i.e. per block of the flip filter
+    `PACKAGE_ASSERT(`NUM_SPIN / `PARALLELISM == 2 * `LAGD_REG_DATA_WIDTH)
 
 endpackage : lagd_pkg
 
@@ -246,6 +266,10 @@ package ising_logic_pkg;
         int PipesMid;
         /// Pipeline in flip filter interface
         int PipesFlipFilter;
+        /// Pipeline on the J memory read data
+        int PipesJRead;
+        /// Pipeline after the flip mask of the flip engine
+        int PipesFlipEngine;
         /// Parallelism factor
         int unsigned Parallelism;
         /// Total energy bit width
@@ -270,6 +294,14 @@ package ising_logic_pkg;
         int HIsNegative;
         /// Enable flip detection
         int EnableFlipDetection;
+        /// Spin vectors evaluated per J sweep by the energy monitor
+        int unsigned EmBatch;
+        /// Number of entries of the top-K solutions buffer (0: no buffer)
+        int unsigned TopK;
+        /// Maximum number of models packed on the diagonal of J (1: no packing)
+        int unsigned PackBlocks;
+        /// Number of bins of the final-energy histogram (0: no histogram)
+        int unsigned HistBins;
         /// J memory address bitwidth
         int unsigned JmemAddrBitwidth;
         /// Flip memory address bitwidth
@@ -280,6 +312,12 @@ package ising_logic_pkg;
         int unsigned FmemDataBitwidth;
         /// H register data bitwidth
         int unsigned HRegDataBitwidth;
+        /// Number of J/flip memory buffers (1 or 2)
+        int unsigned NumL1Buffers;
+        /// Size of one J memory buffer in bytes
+        int unsigned JmemBufferSizeB;
+        /// Size of one flip memory buffer in bytes
+        int unsigned FmemBufferSizeB;
     } ising_logic_cfg_t;
     localparam ising_logic_cfg_t IsingLogicCfg = '{
         NumSpin              : `NUM_SPIN,
@@ -290,9 +328,11 @@ package ising_logic_pkg;
         PipesIntf            : 1, // pipeline at energy monitor interface
         PipesMid             : 1, // pipeline in adder tree of energy monitor
         PipesFlipFilter      : 1, // pipeline at flip filter interface
+        PipesJRead           : 0, // pipeline on the J memory read data
+        PipesFlipEngine      : 0, // pipeline after the flip mask of the flip engine
         Parallelism          : `PARALLELISM,
         EnergyTotalBit       : `ENERGY_TOTAL_BIT,
-        SpinDepth            : 2,
+        SpinDepth            : `SPIN_DEPTH,
         FlipIconDepth        : `FLIP_ICON_DEPTH,
         CounterBitwidth      : `COUNTER_BITWIDTH,
         CcCounterBitwidth    : `CC_COUNTER_BITWIDTH,
@@ -302,11 +342,18 @@ package ising_logic_pkg;
         SpinWblOffset        : `SPIN_WBL_OFFSET,
         HIsNegative          : 1,
         EnableFlipDetection  : `ENABLE_FLIP_DETECTION,
+        EmBatch              : `EM_BATCH_SLOTS,
+        TopK                 : `TOPK_DEPTH,
+        PackBlocks           : `PACK_BLOCKS,
+        HistBins             : `HIST_BINS,
         JmemAddrBitwidth     : `IC_L1_J_MEM_ADDR_WIDTH,
         FmemAddrBitwidth     : `IC_L1_FLIP_MEM_ADDR_WIDTH,
         JmemDataBitwidth     : `IC_L1_J_MEM_DATA_WIDTH,
         FmemDataBitwidth     : `IC_L1_FLIP_MEM_DATA_WIDTH,
-        HRegDataBitwidth     : `NUM_SPIN*`BIT_H
+        HRegDataBitwidth     : `NUM_SPIN*`BIT_H,
+        NumL1Buffers         : `L1_NUM_BUFFERS,
+        JmemBufferSizeB      : `L1_J_MEM_SIZE_B,
+        FmemBufferSizeB      : `L1_FLIP_MEM_SIZE_B
     };
 
 endpackage: ising_logic_pkg
\ No newline at end of file
@@ -61,6 +61,17 @@ module lagd_soc import lagd_pkg::*; (
     // Register interface
     lagd_reg_req_t  [`LAGD_NUM_REG_SLV-1:0] reg_ext_req;
     lagd_reg_rsp_t  [`LAGD_NUM_REG_SLV-1:0] reg_ext_rsp;
+    // Replica exchange
+    localparam ising_logic_pkg::ising_logic_cfg_t LogicCfg = ising_logic_pkg::IsingLogicCfg;
+    logic [`NUM_ISING_CORES-1:0] xchg_en, xchg_done, xchg_release;
+    logic [`NUM_ISING_CORES-1:0] [15:0] xchg_pair_temp, xchg_swap_cnt;
+    logic [`NUM_ISING_CORES-1:0] [7:0] xchg_interval;
+    logic [`NUM_ISING_CORES-1:0] [LogicCfg.SpinDepth-1:0] [LogicCfg.NumSpin-1:0] xchg_spin_core, xchg_spin_next;
+    logic [`NUM_ISING_CORES-1:0] [LogicCfg.SpinDepth-1:0] [LogicCfg.EnergyTotalBit-1:0] xchg_energy_core;
+    // J/flip memory broadcast aliases
+    lagd_axi_slv_req_t  [`NUM_ISING_CORES-1:0] axi_bcast_j_req, axi_bcast_f_req;
+    lagd_axi_slv_rsp_t  [`NUM_ISING_CORES-1:0] axi_bcast_j_rsp, axi_bcast_f_rsp;
+    logic [`NUM_ISING_CORES-1:0] bcast_j_en, bcast_f_en;
 
     //////////////////////////////////////////////////////////
     // Cheshire instantiation  ///////////////////////////////
@@ -191,9 +202,26 @@ module lagd_soc import lagd_pkg::*; (
                 .axi_s_rsp_j_o       (axi_ext_slv_rsp[IsingCoreJIdx]),
                 .axi_s_req_f_i       (axi_ext_slv_req[IsingCoreFIdx]),
                 .axi_s_rsp_f_o       (axi_ext_slv_rsp[IsingCoreFIdx]),
+                // Broadcast aliases
+                .axi_s_req_jb_i      (axi_bcast_j_req[i]            ),
+                .axi_s_rsp_jb_o      (axi_bcast_j_rsp[i]            ),
+                .axi_s_req_fb_i      (axi_bcast_f_req[i]            ),
+                .axi_s_rsp_fb_o      (axi_bcast_f_rsp[i]            ),
+                .bcast_j_en_o        (bcast_j_en[i]                 ),
+                .bcast_f_en_o        (bcast_f_en[i]                 ),
                 // Register interface
                 .reg_s_req_i       (reg_ext_req[i]                          ),
                 .reg_s_rsp_o       (reg_ext_rsp[i]                          ),
+                // Replica exchange interface
+                .xchg_en_o         (xchg_en[i]                              ),
+                .xchg_done_o       (xchg_done[i]                            ),
+                .xchg_pair_temp_o  (xchg_pair_temp[i]                       ),
+                .xchg_interval_o   (xchg_interval[i]                        ),
+                .xchg_spin_o       (xchg_spin_core[i]                       ),
+                .xchg_energy_o     (xchg_energy_core[i]                     ),
+                .xchg_spin_i       (xchg_spin_next[i]                       ),
+                .xchg_release_i    (xchg_release[i]                         ),
+                .xchg_swap_cnt_i   (xchg_swap_cnt[i]                        ),
                 // Galena wires
                 .galena_j_vup_i    (galena_j_vup_i[i]                       ),
                 .galena_j_vdn_i    (galena_j_vdn_i[i]                       ),
@@ -204,4 +232,60 @@ module lagd_soc import lagd_pkg::*; (
         end
     endgenerate
 
+    //////////////////////////////////////////////////////////
+    // J/flip memory broadcast aliases ///////////////////////
+    //////////////////////////////////////////////////////////
+    lagd_axi_bcast #(
+        .NUM_CORES         (`NUM_ISING_CORES        ),
+        .axi_req_t         (lagd_axi_slv_req_t      ),
+        .axi_rsp_t         (lagd_axi_slv_rsp_t      )
+    ) i_axi_bcast_j (
+        .clk_i             (clk_i                   ),
+        .rst_ni            (rst_ni                  ),
+        .slv_req_i         (axi_ext_slv_req[LagdSlvIdxEnum.ISING_BCAST_BASE]),
+        .slv_rsp_o         (axi_ext_slv_rsp[LagdSlvIdxEnum.ISING_BCAST_BASE]),
+        .en_i              (bcast_j_en              ),
+        .mst_req_o         (axi_bcast_j_req         ),
+        .mst_rsp_i         (axi_bcast_j_rsp         )
+    );
+
+    lagd_axi_bcast #(
+        .NUM_CORES         (`NUM_ISING_CORES        ),
+        .axi_req_t         (lagd_axi_slv_req_t      ),
+        .axi_rsp_t         (lagd_axi_slv_rsp_t      )
+    ) i_axi_bcast_f (
+        .clk_i             (clk_i                   ),
+        .rst_ni            (rst_ni                  ),
+        .slv_req_i         (axi_ext_slv_req[LagdSlvIdxEnum.ISING_BCAST_BASE + 1]),
+        .slv_rsp_o         (axi_ext_slv_rsp[LagdSlvIdxEnum.ISING_BCAST_BASE + 1]),
+        .en_i              (bcast_f_en              ),
+        .mst_req_o         (axi_bcast_f_req         ),
+        .mst_rsp_i         (axi_bcast_f_rsp         )
+    );
+
+    //////////////////////////////////////////////////////////
+    // Replica exchange between Ising cores //////////////////
+    //////////////////////////////////////////////////////////
+    replica_exchange #(
+        .NUM_CORES         (`NUM_ISING_CORES        ),
+        .NUM_SPIN          (LogicCfg.NumSpin        ),
+        .SPIN_DEPTH        (LogicCfg.SpinDepth      ),
+        .ENERGY_TOTAL_BIT  (LogicCfg.EnergyTotalBit ),
+        .TEMP_BIT          (16                      ),
+        .INTERVAL_BIT      (8                       ),
+        .CNT_WIDTH         (16                      )
+    ) i_replica_exchange (
+        .clk_i             (clk_i                   ),
+        .rst_ni            (rst_ni                  ),
+        .en_i              (xchg_en                 ),
+        .done_i            (xchg_done               ),
+        .pair_temp_i       (xchg_pair_temp          ),
+        .interval_i        (xchg_interval           ),
+        .spin_i            (xchg_spin_core          ),
+        .energy_i          (xchg_energy_core        ),
+        .spin_o            (xchg_spin_next          ),
+        .release_o         (xchg_release            ),
+        .swap_cnt_o        (xchg_swap_cnt           )
+    );
+
 endmodule
\ No newline at end of file
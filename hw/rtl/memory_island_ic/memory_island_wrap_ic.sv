@@ -14,20 +14,23 @@ module memory_island_wrap_ic import memory_island_pkg::*; #(
     parameter type mem_narrow_req_t = logic,
     parameter type mem_narrow_rsp_t = logic,
     parameter type mem_wide_req_t = logic,
-    parameter type mem_wide_rsp_t = logic
+    parameter type mem_wide_rsp_t = logic,
+
+    // Derived parameters - do not touch
+    parameter int unsigned NumAxiNarrowReqSafe = `ZWIDTH_SAFE(Cfg.NumAxiNarrowReq)
 )(
     input logic clk_i,
     input logic rst_ni,
 
-    input axi_narrow_req_t axi_narrow_req_i,
-    output axi_narrow_rsp_t  axi_narrow_rsp_o,
+    input axi_narrow_req_t [NumAxiNarrowReqSafe-1:0] axi_narrow_req_i,
+    output axi_narrow_rsp_t [NumAxiNarrowReqSafe-1:0] axi_narrow_rsp_o,
 
     input mem_wide_req_t mem_wide_req_i,
     output mem_wide_rsp_t mem_wide_rsp_o
 );
 
-    mem_narrow_req_t mem_narrow_req_from_axi;
-    mem_narrow_rsp_t mem_narrow_rsp_to_axi;
+    mem_narrow_req_t [NumAxiNarrowReqSafe-1:0] mem_narrow_req_from_axi;
+    mem_narrow_rsp_t [NumAxiNarrowReqSafe-1:0] mem_narrow_rsp_to_axi;
 
     // Spill latencies
     localparam int unsigned NarrowMemRspLatency = Cfg.SpillAxiNarrowReqEntry +
@@ -39,26 +42,28 @@ module memory_island_wrap_ic import memory_island_pkg::*; #(
         Cfg.SpillWideRspRouted + Cfg.SpillAxiWideRspEntry + Cfg.BankAccessLatency;
     
     // =============================================================================================
-    // Axi to mem adapters
+    // Axi to mem adapters (one per AXI port, arbitrated per bank in the memory island core)
     // =============================================================================================
-    axi_to_mem_adapter #(
-        .axi_req_t(axi_narrow_req_t),
-        .axi_rsp_t(axi_narrow_rsp_t),
-        .mem_req_t(mem_narrow_req_t),
-        .mem_rsp_t(mem_narrow_rsp_t),
-        .AddrWidth(Cfg.AddrWidth),
-        .DataWidth(Cfg.NarrowDataWidth),
-        .IdWidth(Cfg.AxiNarrowIdWidth),
-        .BufDepth(1 + NarrowMemRspLatency),
-        .ReadWrite(1'b0)
-    ) u_axi_to_mem_adapter_narrow (
-        .clk_i(clk_i),
-        .rst_ni(rst_ni),
-        .axi_req_i(axi_narrow_req_i),
-        .axi_rsp_o(axi_narrow_rsp_o),
-        .mem_req_o(mem_narrow_req_from_axi),
-        .mem_rsp_i(mem_narrow_rsp_to_axi)
-    );
+    for (genvar i = 0; i < Cfg.NumAxiNarrowReq; i++) begin : gen_axi_narrow
+        axi_to_mem_adapter #(
+            .axi_req_t(axi_narrow_req_t),
+            .axi_rsp_t(axi_narrow_rsp_t),
+            .mem_req_t(mem_narrow_req_t),
+            .mem_rsp_t(mem_narrow_rsp_t),
+            .AddrWidth(Cfg.AddrWidth),
+            .DataWidth(Cfg.NarrowDataWidth),
+            .IdWidth(Cfg.AxiNarrowIdWidth),
+            .BufDepth(1 + NarrowMemRspLatency),
+            .ReadWrite(1'b0)
+        ) u_axi_to_mem_adapter_narrow (
+            .clk_i(clk_i),
+            .rst_ni(rst_ni),
+            .axi_req_i(axi_narrow_req_i[i]),
+            .axi_rsp_o(axi_narrow_rsp_o[i]),
+            .mem_req_o(mem_narrow_req_from_axi[i]),
+            .mem_rsp_i(mem_narrow_rsp_to_axi[i])
+        );
+    end
 
     // =============================================================================================
     // Memory island core
@@ -0,0 +1,166 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// This module implements the replica exchange (parallel tempering) path between the Ising cores.
+// Every enabled core runs the same model in multi-cmpt mode at its own temperature (flip schedule);
+// core c is assumed to be colder than core c+1:
+// - when a core finishes a computation (done_i), it waits until all enabled cores have finished,
+// - the cores are then paired as (c, c+1) with c even, or c odd on every other round (only when
+//   NUM_CORES > 2). A pair is only evaluated on every interval_i[c]-th round it is paired in
+//   (0 and 1: every round); in the other rounds its replicas stay in place,
+// - for each spin FIFO slot k of an evaluated pair, the replicas are swapped with the Metropolis
+//   probability min(1, exp(-(beta_c - beta_c+1) * (E[c][k] - E[c+1][k]))). With the pair
+//   temperature T = 1 / (beta_c - beta_c+1) in energy units (pair_temp_i[c]), this is
+//   dE = E[c+1][k] - E[c][k] < T * (-ln u), u uniform in (0, 1). As in acceptance_ctrl, -ln u is
+//   read from a 64-entry lookup table (UQ3.5) indexed by a xorshift32 RNG, one per pair and slot,
+//   which is reseeded whenever no core is enabled. T = 0 only swaps when dE < 0,
+// - the (swapped) final spins are registered on spin_o and release_o starts the next computation
+//   of every enabled core, which takes spin_o as its initial spins.
+// Disabled cores do not take part and are never waited for. A core drops en_i when its multi-cmpt
+// run is over, so cores running more computations than others keep exchanging among themselves.
+//
+// Parameters:
+// - NUM_CORES: the number of Ising cores
+// - NUM_SPIN: the number of spins
+// - SPIN_DEPTH: depth of the spin FIFO (replicas per core)
+// - ENERGY_TOTAL_BIT: bit width of each energy value
+// - TEMP_BIT: bit width of the pair temperature
+// - INTERVAL_BIT: bit width of the exchange interval
+// - CNT_WIDTH: width of the swap counters
+//
+// Ports:
+// - en_i: per core, whether the core takes part in the replica exchange
+// - done_i: per core, 1-cycle pulse when a computation finishes
+// - pair_temp_i: per core, temperature 1 / (beta_c - beta_c+1) of the pair (c, c+1)
+// - interval_i: per core, number of rounds between two evaluations of the pair (c, c+1)
+// - spin_i, energy_i: per core, final spins and energies of the last computation
+// - spin_o: per core, initial spins of the next computation
+// - release_o: per core, 1-cycle pulse when spin_o is valid and the next computation can start
+// - swap_cnt_o: per core, number of replicas swapped into the core since en_i rose
+
+`include "common_cells/registers.svh"
+
+module replica_exchange #(
+    parameter int NUM_CORES = 2,
+    parameter int NUM_SPIN = 256,
+    parameter int SPIN_DEPTH = 2,
+    parameter int ENERGY_TOTAL_BIT = 32,
+    parameter int TEMP_BIT = 16,
+    parameter int INTERVAL_BIT = 8,
+    parameter int CNT_WIDTH = 16
+)(
+    input  logic clk_i,
+    input  logic rst_ni,
+    input  logic [NUM_CORES-1:0] en_i,
+    input  logic [NUM_CORES-1:0] done_i,
+    input  logic [NUM_CORES-1:0] [TEMP_BIT-1:0] pair_temp_i,
+    input  logic [NUM_CORES-1:0] [INTERVAL_BIT-1:0] interval_i,
+    input  logic [NUM_CORES-1:0] [SPIN_DEPTH-1:0] [NUM_SPIN-1:0] spin_i,
+    input  logic [NUM_CORES-1:0] [SPIN_DEPTH-1:0] [ENERGY_TOTAL_BIT-1:0] energy_i,
+    output logic [NUM_CORES-1:0] [SPIN_DEPTH-1:0] [NUM_SPIN-1:0] spin_o,
+    output logic [NUM_CORES-1:0] release_o,
+    output logic [NUM_CORES-1:0] [CNT_WIDTH-1:0] swap_cnt_o
+);
+    logic [NUM_CORES-1:0] en_dly1, en_posedge;
+    logic [NUM_CORES-1:0] arrived_q, arrived;
+    logic exchange;
+    logic phase_q;
+    logic [NUM_CORES-1:0] pair_due; // pair (c, c+1) is evaluated in this round, indexed by c
+    logic [NUM_CORES-1:0] [SPIN_DEPTH-1:0] swap_pair; // swap between core c and c+1, indexed by c
+    logic [NUM_CORES-1:0] [SPIN_DEPTH-1:0] swapped;
+    logic [NUM_CORES-1:0] [SPIN_DEPTH-1:0] [NUM_SPIN-1:0] spin_d;
+
+    // control logic
+    assign en_posedge = en_i & ~en_dly1;
+    assign arrived = (arrived_q | done_i) & en_i;
+    assign exchange = (|en_i) & (&(arrived | ~en_i));
+
+    `FFL(en_dly1, en_i, 1'b1, '0, clk_i, rst_ni)
+    `FFLARNC(arrived_q, arrived, 1'b1, exchange, '0, clk_i, rst_ni)
+    `FFL(release_o, exchange ? en_i : '0, 1'b1, '0, clk_i, rst_ni)
+
+    // alternate the pairing only if there is more than one pair candidate
+    if (NUM_CORES > 2) begin: gen_phase
+        `FFLARNC(phase_q, ~phase_q, exchange, ~(|en_i), 1'b0, clk_i, rst_ni)
+    end else begin: gen_no_phase
+        assign phase_q = 1'b0;
+    end
+
+    // round(-ln((k + 0.5) / 64) * 32), same table as acceptance_ctrl
+    localparam logic [7:0] NEG_LN_LUT [64] = '{
+        8'd155, 8'd120, 8'd104, 8'd93, 8'd85, 8'd79, 8'd73, 8'd69,
+        8'd65, 8'd61, 8'd58, 8'd55, 8'd52, 8'd50, 8'd48, 8'd45,
+        8'd43, 8'd41, 8'd40, 8'd38, 8'd36, 8'd35, 8'd33, 8'd32,
+        8'd31, 8'd29, 8'd28, 8'd27, 8'd26, 8'd25, 8'd24, 8'd23,
+        8'd22, 8'd21, 8'd20, 8'd19, 8'd18, 8'd17, 8'd16, 8'd15,
+        8'd15, 8'd14, 8'd13, 8'd12, 8'd12, 8'd11, 8'd10, 8'd10,
+        8'd9, 8'd8, 8'd8, 8'd7, 8'd6, 8'd6, 8'd5, 8'd5,
+        8'd4, 8'd3, 8'd3, 8'd2, 8'd2, 8'd1, 8'd1, 8'd0
+    };
+
+    // acceptance
+    for (genvar c = 0; c < NUM_CORES; c++) begin: gen_pair
+        if (c < NUM_CORES - 1) begin: gen_interval
+            logic paired;
+            logic [INTERVAL_BIT-1:0] round_cnt_q;
+            assign paired = en_i[c] & en_i[c+1] & ((c % 2) == phase_q);
+            assign pair_due[c] = paired & (round_cnt_q + 1'b1 >= interval_i[c]);
+            `FFLARNC(round_cnt_q, pair_due[c] ? '0 : round_cnt_q + 1'b1, exchange & paired, ~(|en_i), '0, clk_i, rst_ni)
+        end else begin: gen_no_interval
+            assign pair_due[c] = 1'b0;
+        end
+        for (genvar k = 0; k < SPIN_DEPTH; k++) begin: gen_slot
+            if (c < NUM_CORES - 1) begin: gen_accept
+                localparam logic [31:0] SEED = 32'h2545f491 * (c * SPIN_DEPTH + k + 1);
+                logic [31:0] rng_q, rng_x1, rng_x2;
+                logic [TEMP_BIT+7:0] metropolis_thr;
+                logic signed [ENERGY_TOTAL_BIT:0] energy_diff;
+                // xorshift32 RNG, advanced on every evaluation of the pair
+                assign rng_x1 = rng_q ^ (rng_q << 13);
+                assign rng_x2 = rng_x1 ^ (rng_x1 >> 17);
+                `FFL(rng_q, ~(|en_i) ? SEED : rng_x2 ^ (rng_x2 << 5), ~(|en_i) | (exchange & pair_due[c]), SEED, clk_i, rst_ni)
+                assign metropolis_thr = pair_temp_i[c] * NEG_LN_LUT[rng_q[31:26]];
+                assign energy_diff = $signed(energy_i[c+1][k]) - $signed(energy_i[c][k]);
+                assign swap_pair[c][k] = pair_due[c]
+                    & (energy_diff < $signed({1'b0, metropolis_thr >> 5}));
+            end else begin: gen_no_accept
+                assign swap_pair[c][k] = 1'b0;
+            end
+        end
+    end
+
+    // data path: pairs are disjoint, so each replica moves at most one core up or down
+    always_comb begin
+        for (int c = 0; c < NUM_CORES; c++) begin
+            for (int k = 0; k < SPIN_DEPTH; k++) begin
+                spin_d[c][k] = spin_i[c][k];
+                swapped[c][k] = 1'b0;
+                if (swap_pair[c][k]) begin
+                    spin_d[c][k] = spin_i[c+1][k];
+                    swapped[c][k] = 1'b1;
+                end else if (c > 0 && swap_pair[c-1][k]) begin
+                    spin_d[c][k] = spin_i[c-1][k];
+                    swapped[c][k] = 1'b1;
+                end
+            end
+        end
+    end
+
+    `FFL(spin_o, spin_d, exchange, '0, clk_i, rst_ni)
+
+    for (genvar c = 0; c < NUM_CORES; c++) begin: gen_swap_cnt
+        logic [$clog2(SPIN_DEPTH+1)-1:0] swap_num;
+        always_comb begin
+            swap_num = '0;
+            for (int k = 0; k < SPIN_DEPTH; k++) begin
+                swap_num = swap_num + swapped[c][k];
+            end
+        end
+        `FFLARNC(swap_cnt_o[c], swap_cnt_o[c] + swap_num, exchange & en_i[c], en_posedge[c], '0, clk_i, rst_ni)
+    end
+
+endmodule
@@ -5,6 +5,13 @@
 // Author: Jiacong Sun <jiacong.sun@kuleuven.be>
 
 // Behavior model for galena
+//
+// Spin dynamics, selected at compile time (see galena_pkg):
+// - GALENA_DYNAMIC=1: the next-state spins are computed from the onloaded J/h array and the written
+//   spins with the update rule GALENA_UPDATE_RULE (synchronous, sequential or noisy synchronous),
+//   GALENA_SWEEPS sweeps per spin write. Any problem instance can be simulated this way.
+// - DATA_FROM_FILE=1: the next-state spins are replayed from STATE_OUT_FILE_1/2.
+// - otherwise the written spins are read back unchanged.
 
 `timescale 1ns / 1ps
 
@@ -61,6 +68,8 @@ module galena #(
     logic [NUM_SPIN-1:0] spin_cache;
     logic [SPIN_ICON_DEPTH-1:0] [NUM_SPIN-1:0] state_out;
     logic [$clog2(SPIN_ICON_DEPTH)-1:0] j = 0;
+    int weight [WWL_WIDTH][NUM_SPIN]; // decoded data_array, used by the dynamic model
+    int unsigned iter_cnt = 0;
     real spin_delay = 0;
 
     // ========================================================================
@@ -74,6 +83,11 @@ module galena #(
             always_ff @(posedge wwl_i[i]) begin
                 if (wbl_floating_i == {WBL_WIDTH{1'b1}}) begin
                     data_array[i] <= wbl_i;
+                    if (DYNAMIC) begin
+                        for (int k = 0; k < NUM_SPIN; k++) begin
+                            weight[i][k] <= decode_weight(wbl_i[k*BIT_DATA +: BIT_DATA]);
+                        end
+                    end
                     if (`VERBOSE) begin
                         $info("[Time: %0t] Data is written to data_array[%0d]: 'h%h", $time, i, wbl_i);
                     end
@@ -98,7 +112,21 @@ module galena #(
 
     // Spin intenal cache behavior
     generate
-        if (DATA_FROM_FILE) begin
+        if (DYNAMIC) begin
+            always_ff @(posedge &write_spin_i) begin // the behavior model assumes write_spin_i is all-one or all-zero
+                logic [NUM_SPIN-1:0] spin_written, spin_next;
+                for (int i = 0; i < NUM_SPIN; i++) begin
+                    spin_written[i] = wbl_i[BIT_DATA*i + SPIN_WBL_OFFSET];
+                end
+                spin_next = next_state(weight, spin_written);
+                spin_cache <= spin_next;
+                iter_cnt <= iter_cnt + 1;
+                if (`VERBOSE) begin
+                    $info("[Time: %0t] Iteration %0d: spin cache is updated to 'h%h, energy %0d (written energy %0d)",
+                        $time, iter_cnt, spin_next, ising_energy(weight, spin_next), ising_energy(weight, spin_written));
+                end
+            end
+        end else if (DATA_FROM_FILE) begin
             initial begin
                 state_out = load_state_out_ref(`STATE_OUT_FILE_1, `STATE_OUT_FILE_2);
             end
@@ -26,6 +26,31 @@
 `define DATA_FROM_FILE 1
 `endif
 
+// Dynamic model: next-state spins are derived from the onloaded J/h and the written spins
+`ifndef GALENA_DYNAMIC
+`define GALENA_DYNAMIC 0
+`endif
+
+`ifndef GALENA_UPDATE_RULE
+`define GALENA_UPDATE_RULE 1 // 0: synchronous, 1: sequential (asynchronous), 2: synchronous with noise
+`endif
+
+`ifndef GALENA_SWEEPS
+`define GALENA_SWEEPS 1 // number of update sweeps per spin write
+`endif
+
+`ifndef GALENA_NOISE
+`define GALENA_NOISE 0 // noise amplitude on the local field (update rule 2)
+`endif
+
+`ifndef GALENA_H_SCALE
+`define GALENA_H_SCALE 1 // weight of h relative to J in the local field
+`endif
+
+`ifndef GALENA_DATA_IN_2C
+`define GALENA_DATA_IN_2C 0 // 1: J/h written in 2's complement (bypass_data_conversion), 0: analog format
+`endif
+
 package galena_pkg;
 
     // Parameters
@@ -38,6 +63,12 @@ package galena_pkg;
     parameter SPIN_WBL_OFFSET = `SPIN_WBL_OFFSET;
     parameter SPIN_ICON_DEPTH = `SPIN_ICON_DEPTH;
     parameter DATA_FROM_FILE = `DATA_FROM_FILE;
+    parameter DYNAMIC = `GALENA_DYNAMIC;
+    parameter UPDATE_RULE = `GALENA_UPDATE_RULE;
+    parameter NUM_SWEEPS = `GALENA_SWEEPS;
+    parameter NOISE_AMP = `GALENA_NOISE;
+    parameter H_SCALE = `GALENA_H_SCALE;
+    parameter DATA_IN_2C = `GALENA_DATA_IN_2C;
     parameter WWL_WIDTH = NUM_SPIN+1; // +1 for h
     parameter WBL_WIDTH = NUM_SPIN*BIT_DATA;
 
@@ -121,4 +152,74 @@ package galena_pkg;
         return states_out_ref;
     endfunction
 
+    // Function to decode one J/h entry of the data array into a signed integer.
+    // Analog format: bit 0 is the sign (1: positive), the upper bits are the magnitude.
+    function automatic int decode_weight(logic [BIT_DATA-1:0] data);
+        int magnitude;
+        if (DATA_IN_2C) begin
+            return $signed(data);
+        end
+        magnitude = data[BIT_DATA-1:1];
+        return data[0] ? magnitude : -magnitude;
+    endfunction
+
+    // Function to compute the local field of spin i: sum_j J_ij*s_j + H_SCALE*h_i (s = +1/-1 for 1/0).
+    // weight[i] holds J row i, weight[NUM_SPIN] holds h.
+    function automatic int local_field(
+        const ref int weight [WWL_WIDTH][NUM_SPIN],
+        input logic [NUM_SPIN-1:0] spin,
+        input int i
+    );
+        int field = H_SCALE * weight[NUM_SPIN][i];
+        for (int j = 0; j < NUM_SPIN; j++) begin
+            if (j != i) begin
+                field += spin[j] ? weight[i][j] : -weight[i][j];
+            end
+        end
+        return field;
+    endfunction
+
+    // Function to compute the next-state spins with the configured update rule. Each spin aligns
+    // with its local field (H = -0.5*sum_ij J_ij*s_i*s_j - H_SCALE*sum_i h_i*s_i is not increased
+    // by the sequential rule), and keeps its value when the field is zero.
+    function automatic logic [NUM_SPIN-1:0] next_state(
+        const ref int weight [WWL_WIDTH][NUM_SPIN],
+        input logic [NUM_SPIN-1:0] spin
+    );
+        logic [NUM_SPIN-1:0] spin_n = spin;
+        int field;
+        for (int sweep = 0; sweep < NUM_SWEEPS; sweep++) begin
+            for (int i = 0; i < NUM_SPIN; i++) begin
+                // the sequential rule sees the spins updated earlier in the sweep
+                field = local_field(weight, (UPDATE_RULE == 1) ? spin_n : spin, i);
+                if (UPDATE_RULE == 2) begin
+                    field += int'($urandom_range(2*NOISE_AMP, 0)) - NOISE_AMP;
+                end
+                if (field != 0) begin
+                    spin_n[i] = (field > 0);
+                end
+            end
+            spin = spin_n;
+        end
+        return spin_n;
+    endfunction
+
+    // Function to compute the Ising energy H of a spin vector (see next_state)
+    function automatic longint ising_energy(
+        const ref int weight [WWL_WIDTH][NUM_SPIN],
+        input logic [NUM_SPIN-1:0] spin
+    );
+        longint coupling = 0;
+        longint bias = 0;
+        for (int i = 0; i < NUM_SPIN; i++) begin
+            for (int j = 0; j < NUM_SPIN; j++) begin
+                if (j != i) begin
+                    coupling += (spin[i] == spin[j]) ? weight[i][j] : -weight[i][j];
+                end
+            end
+            bias += spin[i] ? weight[NUM_SPIN][i] : -weight[NUM_SPIN][i];
+        end
+        return -(coupling / 2) - H_SCALE * bias;
+    endfunction
+
 endpackage: galena_pkg
\ No newline at end of file
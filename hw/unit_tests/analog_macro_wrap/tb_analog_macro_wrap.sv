@@ -62,6 +62,7 @@ module tb_analog_macro_wrap;
     logic [$clog2(SYNCHRONIZER_PIPE_DEPTH)-1:0] synchronizer_wbl_pipe_num_i;
     logic [NUM_SPIN*BITDATA-1:0] wbl_floating_i;
     logic dt_cfg_enable_i;
+    logic dt_cfg_h_only_i;
     logic j_mem_ren_o;
     logic [J_ADDRESS_WIDTH-1:0] j_raddr_o;
     logic [NUM_SPIN*BITDATA*PARALLELISM-1:0] j_rdata_i, j_rdata_latched;
@@ -191,6 +192,7 @@ module tb_analog_macro_wrap;
         .debug_cycle_per_spin_read_i       (debug_cycle_per_spin_read_i      ),
         .debug_spin_read_num_i             (debug_spin_read_num_i            ),
         .dt_cfg_enable_i                   (dt_cfg_enable_i                  ),
+        .dt_cfg_h_only_i                   (dt_cfg_h_only_i                  ),
         .j_mem_ren_o                       (j_mem_ren_o                      ),
         .j_raddr_o                         (j_raddr_o                        ),
         .j_rdata_i                         (j_rdata_i                        ),
@@ -288,6 +290,7 @@ module tb_analog_macro_wrap;
         end
     end
     assign h_rdata_i = hbias_in_reg;
+    assign dt_cfg_h_only_i = 1'b0; // full J/h onloading
     // dly of debug en
     always_ff @(posedge clk_i or negedge rst_ni) begin
         if (!rst_ni) begin
@@ -141,6 +141,36 @@ module tb_analog_model;
         #(20 * CLKCYCLE);
         $display("[Time: %t] bct_read_o: 'h%h", $time, bct_read_o);
         feedback_i = {NUM_SPIN{1'b0}};
+
+        if (DYNAMIC) begin
+            // dynamic model: J = 0 and h = +1, so every spin must turn to 1
+            #(2 * CLKCYCLE);
+            wbl_floating_i = {WBL_WIDTH{1'b1}};
+            wbl_i = 'd0;
+            for (int i = 0; i < NUM_SPIN; i++) begin
+                wwl_i[i] = 1'b1;
+                #(2 * CLKCYCLE);
+                wwl_i[i] = 1'b0;
+            end
+            wbl_i = {NUM_SPIN{BIT_DATA'(3)}}; // +1 in analog format
+            wwl_i[NUM_SPIN] = 1'b1;
+            #(2 * CLKCYCLE);
+            wwl_i[NUM_SPIN] = 1'b0;
+            wbl_floating_i = 'd0;
+            wbl_i = 'd0; // all spins written as 0
+            #(2 * CLKCYCLE);
+            write_spin_i = {NUM_SPIN{1'b1}};
+            #(2 * CLKCYCLE);
+            write_spin_i = {NUM_SPIN{1'b0}};
+            feedback_i = {NUM_SPIN{1'b1}};
+            #(20 * CLKCYCLE);
+            if (bct_read_o != {NUM_SPIN{1'b1}}) begin
+                $error("[Time: %t] Dynamic model: bct_read_o is 'h%h, expected all ones", $time, bct_read_o);
+            end else begin
+                $display("[Time: %t] Dynamic model: bct_read_o is all ones as expected", $time);
+            end
+            feedback_i = {NUM_SPIN{1'b0}};
+        end
         #(2 * CLKCYCLE);
         $finish;
     end
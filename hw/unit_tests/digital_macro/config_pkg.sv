@@ -9,6 +9,19 @@
 `define True 1'b1
 `define False 1'b0
 
+// pipeline depths, can be overridden at compile time (swept by utils/autotest_digital_macro.py)
+`ifndef PipesMid
+`define PipesMid 1
+`endif
+
+`ifndef PipesJRead
+`define PipesJRead 0
+`endif
+
+`ifndef PipesFlipEngine
+`define PipesFlipEngine 0
+`endif
+
 // Configuration package for digital macro unit tests
 package config_pkg;
     // design-time parameters
@@ -17,8 +30,10 @@ package config_pkg;
     parameter int SCALING_BIT = 6;
     parameter int LITTLE_ENDIAN = `False; // True: little endian, False: big endian
     parameter int PIPESINTF = 1;
-    parameter int PIPESMID = 1;
+    parameter int PIPESMID = `PipesMid;
     parameter int PIPESFLIPFILTER = 1;
+    parameter int PIPESJREAD = `PipesJRead; // pipeline on the J memory read data
+    parameter int PIPESFLIPENGINE = `PipesFlipEngine; // pipeline after the flip mask
     parameter int PARALLELISM = 4;
     parameter int BypassDataConversion = `False;
     parameter int ENERGY_TOTAL_BIT = 32;
@@ -16,10 +16,13 @@ set HDL_FILES [ list \
     "${HDL_PATH}/digital_macro/digital_macro.sv" \
     "${HDL_PATH}/digital_macro/mem_to_handshake_fifo.sv" \
     "${HDL_PATH}/digital_macro/config_spin_ctrl.sv" \
+    "${HDL_PATH}/digital_macro/topk_buffer.sv" \
+    "${HDL_PATH}/digital_macro/block_best_tracker.sv" \
     "${HDL_PATH}/flip_filter/flip_filter.sv" \
     "${HDL_PATH}/flip_filter/dgt_raddr_manager.sv" \
     "${HDL_PATH}/flip_filter/customized_arbiter.sv" \
     "${HDL_PATH}/energy_monitor/energy_monitor.sv" \
+    "${HDL_PATH}/energy_monitor/energy_monitor_batch.sv" \
     "${HDL_PATH}/lib/bp_pipe.sv" \
     "${HDL_PATH}/energy_monitor/vector_caching.sv" \
     "${HDL_PATH}/energy_monitor/step_counter.sv" \
@@ -30,6 +33,7 @@ set HDL_FILES [ list \
     "${HDL_PATH}/flip_manager/flip_manager.sv" \
     "${HDL_PATH}/flip_manager/lagd_fifo_v3.sv" \
     "${HDL_PATH}/flip_manager/flip_engine.sv" \
+    "${HDL_PATH}/flip_manager/acceptance_ctrl.sv" \
     "${HDL_PATH}/flip_manager/energy_fifo_maintainer.sv" \
     "${HDL_PATH}/flip_manager/spin_fifo_maintainer.sv" \
     "${HDL_PATH}/analog_macro_wrap/analog_macro_wrap.sv" \
@@ -77,6 +77,7 @@ module tb_digital_macro;
     logic [ $clog2(SYNCHRONIZER_PIPEDEPTH)-1 : 0 ] synchronizer_pipe_num_i;
     logic [ $clog2(SYNCHRONIZER_PIPEDEPTH)-1 : 0 ] synchronizer_wbl_pipe_num_i;
     logic dt_cfg_enable_i, dt_cfg_idle_o;
+    logic dt_cfg_h_only_i;
     logic j_mem_ren_o;
     logic [ $clog2(NUM_SPIN / PARALLELISM)-1 : 0 ] j_raddr_o, dgt_weight_raddr_o;
     logic [ NUM_SPIN*BITJ*PARALLELISM-1 : 0 ] j_rdata_i, dgt_weight_i;
@@ -112,6 +113,21 @@ module tb_digital_macro;
     logic debug_spin_compute_en_i;
     logic infinite_icon_loop_en_i;
     logic multi_cmpt_mode_en_i;
+    logic multi_cmpt_hold_i;
+    logic cmpt_pause_i;
+    logic cmpt_resume_i;
+    logic em_batch_en_i;
+    logic [15:0] em_batch_timeout_i;
+    logic topk_en_i;
+    logic topk_clear_i;
+    logic [7:0] topk_k_i;
+    logic [7:0] topk_rd_idx_i;
+    logic pack_en_i;
+    logic pack_clear_i;
+    logic [3:0] pack_blocks_log2_i;
+    logic [7:0] pack_rd_idx_i;
+    logic oracle_en_i;
+    logic [1:0] accept_mode_i;
     logic [CC_COUNTER_BITWIDTH-1:0] cmpt_cycle_cnt_o;
     logic cmpt_cycle_cnt_maxed_o;
     logic cmpt_cycle_cnt_overflow_o;
@@ -183,6 +199,22 @@ module tb_digital_macro;
     assign debug_spin_read_num_i = 'd0;
     assign infinite_icon_loop_en_i = INFINITE_ICON_LOOP_EN;
     assign multi_cmpt_mode_en_i = `MultiCmptModeEn;
+    assign multi_cmpt_hold_i = 1'b0;
+    assign cmpt_pause_i = 1'b0;
+    assign cmpt_resume_i = 1'b0;
+    assign em_batch_en_i = 1'b0;
+    assign em_batch_timeout_i = 16'd1024;
+    assign topk_en_i = 1'b0;
+    assign topk_clear_i = 1'b0;
+    assign topk_k_i = 8'd0;
+    assign topk_rd_idx_i = 8'd0;
+    assign pack_en_i = 1'b0; // no block-diagonal packing
+    assign pack_clear_i = 1'b0;
+    assign pack_blocks_log2_i = 4'd0;
+    assign pack_rd_idx_i = 8'd0;
+    assign oracle_en_i = 1'b0; // no energy-oracle mode
+    assign accept_mode_i = 2'd0; // greedy
+    assign dt_cfg_h_only_i = 1'b0; // full J/h onloading
     assign cmpt_max_num_i = CmptMaxNum; // max number of computations in multi-cmpt mode
 
     always_comb begin
@@ -203,6 +235,8 @@ module tb_digital_macro;
         .PIPESINTF                       (PIPESINTF                       ),
         .PIPESMID                        (PIPESMID                        ),
         .PIPESFLIPFILTER                 (PIPESFLIPFILTER                 ),
+        .PIPESJREAD                      (PIPESJREAD                      ),
+        .PIPESFLIPENGINE                 (PIPESFLIPENGINE                 ),
         .SPIN_DEPTH                      (SPIN_DEPTH                      ),
         .FLIP_ICON_DEPTH                 (FLIP_ICON_DEPTH                 ),
         .COUNTER_BITWIDTH                (COUNTER_BITWIDTH                ),
@@ -246,6 +280,7 @@ module tb_digital_macro;
         .debug_cycle_per_spin_read_i     (debug_cycle_per_spin_read_i     ),
         .debug_spin_read_num_i           (debug_spin_read_num_i           ),
         .dt_cfg_enable_i                 (dt_cfg_enable_i                 ),
+        .dt_cfg_h_only_i                 (dt_cfg_h_only_i                 ),
         .j_mem_ren_o                     (j_mem_ren_o                     ),
         .j_raddr_o                       (j_raddr_o                       ),
         .j_rdata_i                       (j_rdata_i                       ),
@@ -254,6 +289,14 @@ module tb_digital_macro;
         .dt_cfg_idle_o                   (dt_cfg_idle_o                   ),
         .flush_i                         (flush_i                         ),
         .en_comparison_i                 (en_comparison_i                 ),
+        .accept_mode_i                   (accept_mode_i                   ),
+        .accept_t_start_i                (16'd0                           ),
+        .accept_t_min_i                  (16'd0                           ),
+        .accept_t_decay_shift_i          (4'd0                            ),
+        .accept_t_interval_i             (16'd0                           ),
+        .accept_seed_i                   (32'd1                           ),
+        .accept_temp_o                   (                                ),
+        .accept_uphill_cnt_o             (                                ),
         .cmpt_en_i                       (cmpt_en_i                       ),
         .cmpt_idle_o                     (cmpt_idle_o                     ),
         .host_readout_i                  (host_readout_i                  ),
@@ -262,9 +305,15 @@ module tb_digital_macro;
         .icon_last_raddr_plus_one_i      (icon_last_raddr_plus_one_i      ),
         .flip_rdata_i                    (flip_rdata_i                    ),
         .flip_disable_i                  (flip_disable_i                  ),
+        .ring_en_i                       (1'b0                            ),
+        .ring_fill_cnt_i                 ('0                              ),
+        .ring_total_i                    ('0                              ),
+        .ring_read_cnt_o                 (                                ),
+        .ring_stall_o                    (                                ),
         .dgt_weight_ren_o                (dgt_weight_ren_o                ),
         .dgt_weight_raddr_o              (dgt_weight_raddr_o              ),
         .dgt_addr_upper_bound_i          (dgt_addr_upper_bound_i          ),
+        .dgt_nz_block_mask_i             ('1                              ),
         .dgt_weight_i                    (dgt_weight_i                    ),
         .dgt_hbias_i                     (dgt_hbias_i                     ),
         .dgt_hscaling_i                  (dgt_hscaling_i                  ),
@@ -285,6 +334,29 @@ module tb_digital_macro;
         .energy_fifo_o                   (energy_fifo_o                   ),
         .spin_fifo_o                     (spin_fifo_o                     ),
         .enable_flip_detection_i         (enable_flip_detection_i         ),
+        .em_batch_en_i                   (em_batch_en_i                   ),
+        .em_batch_timeout_i              (em_batch_timeout_i              ),
+        .topk_en_i                       (topk_en_i                       ),
+        .topk_clear_i                    (topk_clear_i                    ),
+        .topk_k_i                        (topk_k_i                        ),
+        .topk_rd_idx_i                   (topk_rd_idx_i                   ),
+        .topk_count_o                    (                                ),
+        .topk_energy_o                   (                                ),
+        .topk_spin_o                     (                                ),
+        .pack_en_i                       (pack_en_i                       ),
+        .pack_clear_i                    (pack_clear_i                    ),
+        .pack_blocks_log2_i              (pack_blocks_log2_i              ),
+        .pack_rd_idx_i                   (pack_rd_idx_i                   ),
+        .pack_valid_o                    (                                ),
+        .pack_energy_o                   (                                ),
+        .pack_spin_o                     (                                ),
+        .oracle_en_i                     (oracle_en_i                     ),
+        .oracle_spin_valid_i             (1'b0                            ),
+        .oracle_spin_ready_o             (                                ),
+        .oracle_spin_i                   ('0                              ),
+        .oracle_energy_valid_o           (                                ),
+        .oracle_energy_ready_i           (1'b0                            ),
+        .oracle_energy_o                 (                                ),
         // debugging interface
         .debug_j_write_en_i              (debug_j_write_en_i              ),
         .debug_j_read_en_i               (debug_j_read_en_i               ),
@@ -317,9 +389,16 @@ module tb_digital_macro;
         // measurement purposes
         .infinite_icon_loop_en_i         (infinite_icon_loop_en_i         ),
         .multi_cmpt_mode_en_i            (multi_cmpt_mode_en_i            ),
+        .multi_cmpt_hold_i               (multi_cmpt_hold_i               ),
         .fm_upstream_handshake_counter_o (fm_upstream_handshake_counter_o ),
         .cycle_per_iter_recount_en_o     (cycle_per_iter_recount_en_o     ),
         .cmpt_max_num_i                  (cmpt_max_num_i                  ),
+        .cmpt_pause_i                    (cmpt_pause_i                    ),
+        .cmpt_resume_i                   (cmpt_resume_i                   ),
+        .resume_flip_raddr_i             ('0                              ),
+        .resume_energy_i                 ('0                              ),
+        .flip_raddr_q_o                  (                                ),
+        .spin_fifo_head_o                (                                ),
         .multi_cmpt_mode_idle_o          (multi_cmpt_mode_idle_o          ),
         .cmpt_idx_o                      (cmpt_idx_o                      ),
         .cycle_per_iteration_o           (cycle_per_iteration_o           ),
@@ -178,7 +178,9 @@ module tb_energy_monitor;
         .energy_o(energy_o),
         .spin_o(), // not connected in testbench
         .busy_o(), // not connected in testbench
-        .baseline_done_o() // not connected in testbench
+        .baseline_done_o(), // not connected in testbench
+        .blocks_log2_i('0), // no block packing in this testbench
+        .block_energy_o() // not connected in testbench
     );
 
     // Clock generation
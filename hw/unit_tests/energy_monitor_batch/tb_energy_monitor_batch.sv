@@ -0,0 +1,366 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// Batched energy monitor Testbench.
+// The weight stream sweeps a fixed random J matrix row by row, and every energy is checked
+// against a reference model, in spin order. Three phases are run, with a flush in between:
+// - batching off: the module must behave as energy_monitor,
+// - batching on, complete batches: BATCH spin vectors share each J sweep,
+// - batching on, incomplete batch: one spin more than a batch is sent and the spin stream then
+//   stops, so the last batch must be padded after BATCH_TIMEOUT idle cycles. The energy of the
+//   last spin must not arrive before the timeout, and the dummy energies must be dropped.
+
+`timescale 1ns / 1ps
+
+`ifndef DBG
+`define DBG 0
+`endif
+
+`ifndef VCD_FILE
+`define VCD_FILE "tb_energy_monitor_batch.vcd"
+`endif
+
+`define True 1'b1
+`define False 1'b0
+
+`ifndef BATCH // spin vectors per J sweep
+`define BATCH 2
+`endif
+
+`ifndef BATCH_TIMEOUT // idle cycles before an incomplete batch is padded
+`define BATCH_TIMEOUT 64
+`endif
+
+`ifndef NUM_TESTS // spin vectors per phase (rounded down to a multiple of BATCH when batching)
+`define NUM_TESTS 8
+`endif
+
+`ifndef PIPESINTF // number of pipeline stages at the input interface
+`define PIPESINTF 1
+`endif
+
+`ifndef PIPESMID // number of pipeline stages at mid adder tree
+`define PIPESMID 1
+`endif
+
+module tb_energy_monitor_batch;
+
+    // Testbench parameters
+    localparam int CLKCYCLE = 2; // clock cycle in ns
+    localparam int SPIN_LATENCY = 3; // cycles between two spins
+    localparam int DRAIN_CYCLES = 4000; // cycles to wait for the energies of a phase
+
+    // Module parameters
+    localparam int BITJ = 4;
+    localparam int BITH = 4;
+    localparam int NUM_SPIN = 256;
+    localparam int SCALING_BIT = 6;
+    localparam int PARALLELISM = 4;
+    localparam int ENERGY_TOTAL_BIT = 32;
+    localparam int LITTLE_ENDIAN = `False;
+    localparam int SPIN_DEPTH = 2;
+    localparam int H_IS_NEGATIVE = `False;
+    localparam int TIMEOUT_BIT = 16;
+
+    // Testbench internal signals
+    logic clk_i;
+    logic rst_ni;
+    logic en_i;
+    logic flush_i;
+    logic batch_en_i;
+    logic config_valid_i;
+    logic [$clog2(NUM_SPIN)-1:0] config_counter_i;
+    logic spin_valid_i;
+    logic [NUM_SPIN-1:0] spin_i;
+    logic spin_ready_o;
+    logic weight_valid_i;
+    logic [NUM_SPIN*BITJ*PARALLELISM-1:0] weight_i;
+    logic [BITH*PARALLELISM-1:0] hbias_i;
+    logic [SCALING_BIT*PARALLELISM-1:0] hscaling_i;
+    logic weight_ready_o;
+    logic energy_valid_o;
+    logic signed [ENERGY_TOTAL_BIT-1:0] energy_o;
+    logic [NUM_SPIN-1:0] spin_o;
+
+    // J matrix over spin bits (zero diagonal), bias and scaling factor of each spin bit
+    logic signed [BITJ-1:0] j_mat [NUM_SPIN][NUM_SPIN];
+    logic signed [BITH-1:0] h_vec [NUM_SPIN];
+    logic [SCALING_BIT-1:0] sf_vec [NUM_SPIN];
+    logic [$clog2(NUM_SPIN)-1:0] row_q; // first J row of the next weight beat
+
+    logic [NUM_SPIN-1:0] spin_queue [$];
+    logic [31:0] last_spin_cycle;
+    logic [31:0] cycle_cnt;
+    integer sent_count;
+    integer checked_count;
+    integer error_count;
+
+    // Module instantiation
+    energy_monitor_batch #(
+        .BITJ(BITJ),
+        .BITH(BITH),
+        .SPIN_DEPTH(SPIN_DEPTH),
+        .NUM_SPIN(NUM_SPIN),
+        .SCALING_BIT(SCALING_BIT),
+        .PARALLELISM(PARALLELISM),
+        .ENERGY_TOTAL_BIT(ENERGY_TOTAL_BIT),
+        .LITTLE_ENDIAN(LITTLE_ENDIAN),
+        .PIPESINTF(`PIPESINTF),
+        .PIPESMID(`PIPESMID),
+        .ENABLE_EXTERNAL_FINISH_SIGNAL(`False),
+        .H_IS_NEGATIVE(H_IS_NEGATIVE),
+        .BATCH(`BATCH),
+        .TIMEOUT_BIT(TIMEOUT_BIT)
+    ) dut (
+        .clk_i(clk_i),
+        .rst_ni(rst_ni),
+        .en_i(en_i),
+        .flush_i(flush_i),
+        .en_external_counter_i(1'b0),
+        .batch_en_i(batch_en_i),
+        .batch_timeout_i(TIMEOUT_BIT'(`BATCH_TIMEOUT)),
+        .config_valid_i(config_valid_i),
+        .config_counter_i(config_counter_i),
+        .config_ready_o(), // not connected in testbench
+        .spin_valid_i(spin_valid_i),
+        .spin_i(spin_i),
+        .spin_ready_o(spin_ready_o),
+        .weight_valid_i(weight_valid_i),
+        .weight_valid_parallel_i({PARALLELISM{1'b1}}), // always valid in this testbench
+        .external_counter_q_i({$clog2(NUM_SPIN){1'b1}}),
+        .external_finish_i(1'b0),
+        .double_weight_contri_i(1'b0),
+        .weight_i(weight_i),
+        .hbias_i(hbias_i),
+        .hscaling_i(hscaling_i),
+        .energy_baseline_in_i('d0),
+        .weight_ready_o(weight_ready_o),
+        .counter_spin_o(), // not connected in testbench
+        .energy_valid_o(energy_valid_o),
+        .energy_ready_i(1'b1), // energies are always accepted
+        .energy_baseline_out_o(), // not connected in testbench
+        .energy_o(energy_o),
+        .spin_o(spin_o),
+        .busy_o(), // not connected in testbench
+        .baseline_done_o(), // not connected in testbench
+        .blocks_log2_i('0), // no block packing in this testbench
+        .block_energy_o() // not connected in testbench
+    );
+
+    // Clock generation
+    initial begin
+        clk_i = 0;
+        forever #(CLKCYCLE/2) clk_i = ~clk_i;
+    end
+
+    // Reset generation
+    initial begin
+        rst_ni = 0;
+        #(10 * CLKCYCLE);
+        rst_ni = 1;
+    end
+
+    initial begin
+        if (`DBG) begin
+            $display("Debug mode enabled. Generating VCD waveform.");
+            $dumpfile(`VCD_FILE);
+            $dumpvars(4, tb_energy_monitor_batch);
+        end
+    end
+
+    // Random model
+    initial begin
+        for (int a = 0; a < NUM_SPIN; a++) begin
+            for (int b = 0; b < NUM_SPIN; b++) begin
+                j_mat[a][b] = (a == b) ? '0 : BITJ'($urandom());
+            end
+            h_vec[a] = BITH'($urandom());
+            sf_vec[a] = SCALING_BIT'(1 << $urandom_range(0, 4));
+        end
+    end
+
+    // ========================================================================
+    // Weight stream: J rows in order, row r holds the couplings of spin bit NUM_SPIN-1-r
+    // ========================================================================
+    always_comb begin
+        for (int i = 0; i < PARALLELISM; i++) begin
+            for (int b = 0; b < NUM_SPIN; b++) begin
+                weight_i[(i*NUM_SPIN + b)*BITJ +: BITJ] = j_mat[NUM_SPIN-1-(row_q+i)][b];
+            end
+            hbias_i[(PARALLELISM-1-i)*BITH +: BITH] = h_vec[NUM_SPIN-1-(row_q+i)];
+            hscaling_i[(PARALLELISM-1-i)*SCALING_BIT +: SCALING_BIT] = sf_vec[NUM_SPIN-1-(row_q+i)];
+        end
+    end
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (!rst_ni) begin
+            row_q <= '0;
+        end else if (flush_i) begin
+            row_q <= '0;
+        end else if (weight_valid_i && weight_ready_o) begin
+            row_q <= row_q + PARALLELISM;
+        end
+    end
+
+    // ========================================================================
+    // Reference behavior model and scoreboard
+    // ========================================================================
+    // E = 1/2 sum_ab J_ab s_a s_b + sum_a h_a sf_a s_a, with s = +1 for spin bit 1
+    function automatic logic signed [ENERGY_TOTAL_BIT-1:0] compute_energy(
+        input logic [NUM_SPIN-1:0] spin_vec
+    );
+        logic signed [ENERGY_TOTAL_BIT:0] energy_doubled;
+        logic signed [ENERGY_TOTAL_BIT:0] local_energy;
+        begin
+            energy_doubled = 0;
+            for (int a = 0; a < NUM_SPIN; a++) begin
+                local_energy = 2 * h_vec[a] * $signed({1'b0, sf_vec[a]});
+                for (int b = 0; b < NUM_SPIN; b++) begin
+                    local_energy += spin_vec[b] ? j_mat[a][b] : -j_mat[a][b];
+                end
+                energy_doubled += spin_vec[a] ? local_energy : -local_energy;
+            end
+            compute_energy = energy_doubled / 2;
+        end
+    endfunction
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (!rst_ni) begin
+            cycle_cnt <= 0;
+        end else begin
+            cycle_cnt <= cycle_cnt + 1;
+        end
+    end
+
+    always @(posedge clk_i) begin
+        if (rst_ni && spin_valid_i && spin_ready_o) begin
+            spin_queue.push_back(spin_i);
+            last_spin_cycle = cycle_cnt;
+        end
+        if (rst_ni && energy_valid_o) begin
+            if (spin_queue.size() == 0) begin
+                $error("Time: %0d ns, unexpected energy 'd%0d (dummy energy not dropped?)",
+                    $time, energy_o);
+                error_count++;
+            end else begin
+                logic [NUM_SPIN-1:0] spin_exp;
+                logic signed [ENERGY_TOTAL_BIT-1:0] energy_exp;
+                spin_exp = spin_queue.pop_front();
+                energy_exp = compute_energy(spin_exp);
+                if (energy_o !== energy_exp || spin_o !== spin_exp) begin
+                    $error("Time: %0d ns, Testcase [%0d] Energy mismatch: received 'd%0d, expected 'd%0d%s",
+                        $time, checked_count, energy_o, energy_exp,
+                        (spin_o !== spin_exp) ? " (spin out of order)" : "");
+                    error_count++;
+                end
+                checked_count++;
+            end
+        end
+    end
+
+    // ========================================================================
+    // Tasks
+    // ========================================================================
+    task automatic send_spins(input int num);
+        for (int n = 0; n < num; n++) begin
+            @(negedge clk_i);
+            spin_valid_i = 1;
+            for (int i = 0; i < NUM_SPIN; i++) spin_i[i] = $urandom() % 2;
+            do @(posedge clk_i); while (!spin_ready_o);
+            @(negedge clk_i);
+            spin_valid_i = 0;
+            sent_count++;
+            repeat(SPIN_LATENCY) @(posedge clk_i);
+        end
+    endtask
+
+    task automatic wait_energies(input string phase);
+        int waited = 0;
+        while (checked_count < sent_count && waited < DRAIN_CYCLES) begin
+            @(posedge clk_i);
+            waited++;
+        end
+        // extra cycles to catch dummy energies
+        repeat(100) @(posedge clk_i);
+        if (checked_count != sent_count) begin
+            $error("%s: %0d energies for %0d spins", phase, checked_count, sent_count);
+            error_count++;
+        end
+        $display("%s: %0d energies checked", phase, checked_count);
+    endtask
+
+    task automatic flush();
+        @(negedge clk_i);
+        flush_i = 1;
+        @(negedge clk_i);
+        flush_i = 0;
+        spin_queue.delete();
+        sent_count = 0;
+        checked_count = 0;
+    endtask
+
+    // ========================================================================
+    // Test sequence
+    // ========================================================================
+    initial begin
+        int num_batched;
+        logic [31:0] pad_wait;
+        en_i = 0;
+        flush_i = 0;
+        batch_en_i = 0;
+        config_valid_i = 0;
+        config_counter_i = 'd0;
+        spin_valid_i = 0;
+        spin_i = 'd0;
+        weight_valid_i = 0;
+        sent_count = 0;
+        checked_count = 0;
+        error_count = 0;
+        num_batched = (`NUM_TESTS / `BATCH) * `BATCH;
+        $display("Starting batched energy monitor testbench. BATCH: %0d, timeout: %0d cycles",
+            `BATCH, `BATCH_TIMEOUT);
+        wait(rst_ni);
+        repeat(10) @(posedge clk_i);
+        @(negedge clk_i);
+        en_i = 1;
+        config_valid_i = 1;
+        config_counter_i = 'd0;
+        repeat(10) @(negedge clk_i);
+        config_counter_i = 'd255;
+        @(negedge clk_i);
+        config_valid_i = 0;
+        weight_valid_i = 1;
+
+        // phase 1: batching off
+        send_spins(`NUM_TESTS);
+        wait_energies("Batch off");
+
+        // phase 2: complete batches
+        flush();
+        batch_en_i = 1;
+        send_spins(num_batched);
+        wait_energies("Batch on, full batches");
+
+        // phase 3: incomplete batch, padded after the timeout
+        flush();
+        send_spins(`BATCH + 1);
+        wait(checked_count == sent_count || cycle_cnt - last_spin_cycle > DRAIN_CYCLES);
+        pad_wait = cycle_cnt - last_spin_cycle;
+        if (`BATCH > 1 && pad_wait < `BATCH_TIMEOUT) begin
+            $error("Batch on, padding: last energy after %0d cycles, before the timeout", pad_wait);
+            error_count++;
+        end
+        wait_energies("Batch on, padding");
+        batch_en_i = 0;
+
+        $display("----------------------------------------");
+        $display("Scoreboard [Time %0d ns]: %0d errors", $time, error_count);
+        $display("----------------------------------------");
+        $finish;
+    end
+
+endmodule
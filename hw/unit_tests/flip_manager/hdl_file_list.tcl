@@ -12,6 +12,7 @@ set HDL_FILES [ list \
     "${HDL_PATH}/flip_manager/flip_engine.sv" \
     "${HDL_PATH}/flip_manager/lagd_fifo_v3.sv" \
     "${HDL_PATH}/lib/registers.svh" \
+    "${HDL_PATH}/flip_manager/acceptance_ctrl.sv" \
     "${HDL_PATH}/flip_manager/energy_fifo_maintainer.sv" \
     "${HDL_PATH}/flip_manager/spin_fifo_maintainer.sv" \
     "${HDL_PATH}/energy_monitor/step_counter.sv" \
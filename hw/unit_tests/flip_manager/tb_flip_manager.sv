@@ -13,6 +13,10 @@
 `define VCD_FILE "tb_flip_manager.vcd"
 `endif
 
+`ifndef FLIP_PIPES // number of pipeline stages after the flip mask
+`define FLIP_PIPES 0
+`endif
+
 module tb_flip_manager;
 
     // Module parameters
@@ -20,6 +24,7 @@ module tb_flip_manager;
     localparam int ENERGY_TOTAL_BIT = 32; // bit width of total energy
     localparam int SPIN_DEPTH = 2; // depth of spin/energy FIFOs
     localparam int FLIP_ICON_DEPTH = 1024; // number of entries in flip, can be odd and even number
+    localparam int FLIP_PIPES = `FLIP_PIPES; // pipeline stages after the flip mask
     localparam bit INFINITE_ICON_LOOP_EN = 0; // set to 1 to enable infinite icon loop for measurement
 
     // Testbench parameters
@@ -109,13 +114,23 @@ module tb_flip_manager;
         .NUM_SPIN(NUM_SPIN),
         .SPIN_DEPTH(SPIN_DEPTH),
         .ENERGY_TOTAL_BIT(ENERGY_TOTAL_BIT),
-        .FLIP_ICON_DEPTH(FLIP_ICON_DEPTH)
+        .FLIP_ICON_DEPTH(FLIP_ICON_DEPTH),
+        .FLIP_PIPES(FLIP_PIPES)
     ) dut (
         .clk_i(clk_i),
         .rst_ni(rst_ni),
         .en_i(en_i),
         .flush_i(flush_i),
         .en_comparison_i(en_comparison_i),
+        .accept_mode_i(2'd0),
+        .accept_t_start_i('0),
+        .accept_t_min_i('0),
+        .accept_t_decay_shift_i('0),
+        .accept_t_interval_i('0),
+        .accept_seed_i('0),
+        .accept_seed_load_i(1'b0),
+        .accept_temp_o(),
+        .accept_uphill_cnt_o(),
         .cmpt_en_i(cmpt_en_i),
         .cmpt_idle_o(cmpt_idle_o),
         .host_readout_i(host_readout_i),
@@ -135,6 +150,17 @@ module tb_flip_manager;
         .icon_last_raddr_plus_one_i(icon_last_raddr_plus_one_i),
         .flip_rdata_i(flip_rdata_i),
         .flip_disable_i(flip_disable_i),
+        .pause_i(1'b0),
+        .resume_i(1'b0),
+        .resume_flip_raddr_i('0),
+        .resume_energy_i('0),
+        .flip_raddr_q_o(),
+        .spin_fifo_head_o(),
+        .ring_en_i(1'b0),
+        .ring_fill_cnt_i('0),
+        .ring_total_i('0),
+        .ring_read_cnt_o(),
+        .ring_stall_o(),
         .energy_fifo_update_o(energy_fifo_update_o),
         .spin_fifo_update_o(spin_fifo_update_o),
         .energy_fifo_o(energy_fifo_o),
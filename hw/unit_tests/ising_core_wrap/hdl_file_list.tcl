@@ -15,6 +15,10 @@ set HDL_FILES [ list \
     "${HDL_PATH}/lagd_pkg.sv" \
     "${PROJECT_ROOT}/hw/tb/models/galena/galena_pkg.sv" \
     "${PROJECT_ROOT}/hw/tb/models/galena/galena.sv" \
+    "${HDL_PATH}/ising_core_wrap/j_precision_adapter.sv" \
+    "${HDL_PATH}/ising_core_wrap/restart_queue.sv" \
+    "${HDL_PATH}/ising_core_wrap/energy_oracle.sv" \
+    "${HDL_PATH}/ising_core_wrap/energy_histogram.sv" \
     "${HDL_PATH}/ising_core_wrap/ising_core_wrap.sv" \
     "${HDL_PATH}/memory_island/axi_to_mem_adapter.sv" \
     "${HDL_PATH}/memory_island/mem_multicut.sv" \
@@ -30,11 +34,14 @@ set HDL_FILES [ list \
     "[exec ${BENDER} path common_cells]/src/popcount.sv" \
     "${HDL_PATH}/digital_macro/digital_macro.sv" \
     "${HDL_PATH}/digital_macro/config_spin_ctrl.sv" \
+    "${HDL_PATH}/digital_macro/topk_buffer.sv" \
+    "${HDL_PATH}/digital_macro/block_best_tracker.sv" \
     "${HDL_PATH}/digital_macro/mem_to_handshake_fifo.sv" \
     "${HDL_PATH}/flip_filter/flip_filter.sv" \
     "${HDL_PATH}/flip_filter/dgt_raddr_manager.sv" \
     "${HDL_PATH}/flip_filter/customized_arbiter.sv" \
     "${HDL_PATH}/energy_monitor/energy_monitor.sv" \
+    "${HDL_PATH}/energy_monitor/energy_monitor_batch.sv" \
     "${HDL_PATH}/lib/bp_pipe.sv" \
     "${HDL_PATH}/energy_monitor/vector_caching.sv" \
     "${HDL_PATH}/energy_monitor/step_counter.sv" \
@@ -45,6 +52,7 @@ set HDL_FILES [ list \
     "${HDL_PATH}/flip_manager/flip_manager.sv" \
     "${HDL_PATH}/flip_manager/lagd_fifo_v3.sv" \
     "${HDL_PATH}/flip_manager/flip_engine.sv" \
+    "${HDL_PATH}/flip_manager/acceptance_ctrl.sv" \
     "${HDL_PATH}/flip_manager/energy_fifo_maintainer.sv" \
     "${HDL_PATH}/flip_manager/spin_fifo_maintainer.sv" \
     "${HDL_PATH}/analog_macro_wrap/analog_macro_wrap.sv" \
@@ -190,6 +190,12 @@ module tb_ising_core_wrap;
         .axi_s_rsp_j_o       (axi_ext_slv_rsp_0                     ),
         .axi_s_req_f_i       (axi_ext_slv_req_1                     ),
         .axi_s_rsp_f_o       (axi_ext_slv_rsp_1                     ),
+        .axi_s_req_jb_i      ('0                                    ),
+        .axi_s_rsp_jb_o      (                                      ),
+        .axi_s_req_fb_i      ('0                                    ),
+        .axi_s_rsp_fb_o      (                                      ),
+        .bcast_j_en_o        (                                      ),
+        .bcast_f_en_o        (                                      ),
         // Register interface
         .reg_s_req_i       (reg_ext_req                             ),
         .reg_s_rsp_o       (reg_ext_rsp                             ),
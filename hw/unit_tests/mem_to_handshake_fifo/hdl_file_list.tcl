@@ -0,0 +1,18 @@
+# Copyright 2025 KU Leuven.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+set PROJECT_ROOT ../../..
+set HDL_PATH ../../rtl
+
+set HDL_FILES [ list \
+    "./tb_mem_to_handshake_fifo.sv" \
+    "${HDL_PATH}/digital_macro/mem_to_handshake_fifo.sv" \
+    "${HDL_PATH}/ising_core_wrap/j_precision_adapter.sv" \
+    "${HDL_PATH}/flip_manager/lagd_fifo_v3.sv" \
+    "${HDL_PATH}/lib/bp_pipe.sv" \
+]
+
+set INCLUDE_DIRS [list \
+    "[exec bender path common_cells]/include" \
+]
@@ -0,0 +1,275 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Module description:
+// Memory to handshake FIFO Testbench.
+// The FIFO reads a J memory through j_precision_adapter, as the weight FIFO of the digital macro
+// does: the read data is flagged valid one cycle after the logical read, and in 2-bit mode the
+// adapter drops every second physical read. The downstream ready is random in a first phase and
+// always high in a second phase. The testbench checks:
+// - the data order (logical words 0 .. ADDR_UPPER_BOUND, wrapping) and the unpacked data,
+// - that the FIFO never overflows,
+// - with RDATA_PIPES > 0, that the read credit of the FIFO equals the number of returned reads not
+//   yet popped on every cycle,
+// - that reads are suppressed in 2-bit mode, and that one word per cycle is delivered when the
+//   downstream is always ready.
+
+`timescale 1ns / 1ps
+
+`ifndef DBG
+`define DBG 0
+`endif
+
+`ifndef VCD_FILE
+`define VCD_FILE "tb_mem_to_handshake_fifo.vcd"
+`endif
+
+`ifndef RDATA_PIPES // register stages on the read data
+`define RDATA_PIPES 1
+`endif
+
+`ifndef PRECISION_2B // 1: 2-bit packed J, 0: 4-bit J
+`define PRECISION_2B 1
+`endif
+
+`ifndef NUM_TESTS // words popped in the random ready phase
+`define NUM_TESTS 1000
+`endif
+
+module tb_mem_to_handshake_fifo;
+
+    // Testbench parameters
+    localparam int CLKCYCLE = 2; // clock cycle in ns
+    localparam int FULL_RATE_CYCLES = 64; // cycles of the always ready phase
+    localparam int WARMUP_CYCLES = 16; // cycles before the delivery rate is measured
+
+    // Module parameters
+    localparam int NUM_SPIN = 16;
+    localparam int BITJ = 4;
+    localparam int PARALLELISM = 2;
+    localparam int DEPTH = 2;
+    localparam int ADDR_WIDTH = $clog2(NUM_SPIN / PARALLELISM);
+    localparam int DATA_WIDTH = NUM_SPIN * BITJ * PARALLELISM;
+    localparam int NUM_WORDS = NUM_SPIN / PARALLELISM;
+    localparam int NUM_ELEM = NUM_SPIN * PARALLELISM;
+    localparam int FIFO_DEPTH = DEPTH + `RDATA_PIPES + (`RDATA_PIPES > 0);
+
+    // Testbench internal signals
+    logic clk_i;
+    logic rst_ni;
+    logic en_i;
+    logic ren;
+    logic [ADDR_WIDTH-1:0] raddr;
+    logic ren_dly1;
+    logic [DATA_WIDTH-1:0] rdata;
+    logic mem_ren;
+    logic [ADDR_WIDTH-1:0] mem_raddr;
+    logic [DATA_WIDTH-1:0] mem_rdata;
+    logic data_ready_i;
+    logic data_valid_o;
+    logic [DATA_WIDTH-1:0] data_o;
+    logic random_ready;
+
+    // logical words (sign-extended to BITJ bits) and physical memory
+    logic [DATA_WIDTH-1:0] word_ref [NUM_WORDS];
+    logic [DATA_WIDTH-1:0] mem [NUM_WORDS];
+
+    logic [ADDR_WIDTH-1:0] pop_addr;
+    integer credit_ref;
+    integer pop_count;
+    integer read_count;
+    integer mem_read_count;
+    integer error_count;
+
+    // Module instantiation
+    mem_to_handshake_fifo #(
+        .DEPTH(DEPTH),
+        .RDATA_PIPES(`RDATA_PIPES),
+        .ADDR_WIDTH(ADDR_WIDTH),
+        .DATA_WIDTH(DATA_WIDTH)
+    ) dut (
+        .clk_i(clk_i),
+        .rst_ni(rst_ni),
+        .en_i(en_i),
+        .flush_i(1'b0),
+        .addr_upper_bound_i(ADDR_WIDTH'(NUM_WORDS - 1)),
+        .mem_ren_o(ren),
+        .mem_raddr_o(raddr),
+        .mem_rdata_valid_i(ren_dly1),
+        .mem_rdata_i(rdata),
+        .data_ready_i(data_ready_i),
+        .data_valid_o(data_valid_o),
+        .data_o(data_o),
+        .debug_fifo_usage_o() // not connected in testbench
+    );
+
+    j_precision_adapter #(
+        .NUM_SPIN(NUM_SPIN),
+        .BITJ(BITJ),
+        .PARALLELISM(PARALLELISM),
+        .ADDR_WIDTH(ADDR_WIDTH)
+    ) u_j_precision_adapter (
+        .clk_i(clk_i),
+        .rst_ni(rst_ni),
+        .precision_2b_i(1'(`PRECISION_2B)),
+        .clear_i(1'b0),
+        .ren_i(ren),
+        .raddr_i(raddr),
+        .rdata_o(rdata),
+        .ren_o(mem_ren),
+        .raddr_o(mem_raddr),
+        .rdata_i(mem_rdata)
+    );
+
+    // Clock generation
+    initial begin
+        clk_i = 0;
+        forever #(CLKCYCLE/2) clk_i = ~clk_i;
+    end
+
+    // Reset generation
+    initial begin
+        rst_ni = 0;
+        #(10 * CLKCYCLE);
+        rst_ni = 1;
+    end
+
+    initial begin
+        if (`DBG) begin
+            $display("Debug mode enabled. Generating VCD waveform.");
+            $dumpfile(`VCD_FILE);
+            $dumpvars(4, tb_mem_to_handshake_fifo);
+        end
+    end
+
+    // Random 2-bit couplings: logical word w holds elements of value -2 .. 1
+    initial begin
+        logic [1:0] v;
+        for (int w = 0; w < NUM_WORDS; w++) begin
+            word_ref[w] = '0;
+            mem[w] = '0;
+        end
+        for (int w = 0; w < NUM_WORDS; w++) begin
+            for (int e = 0; e < NUM_ELEM; e++) begin
+                v = 2'($urandom());
+                word_ref[w][e*BITJ +: BITJ] = {{(BITJ-1){v[1]}}, v[0]};
+                if (`PRECISION_2B) begin
+                    mem[w/2][((w%2)*NUM_ELEM + e)*2 +: 2] = v;
+                end else begin
+                    mem[w][e*BITJ +: BITJ] = {{(BITJ-1){v[1]}}, v[0]};
+                end
+            end
+        end
+    end
+
+    // ========================================================================
+    // Memory model: one cycle latency, the output holds its data between reads
+    // ========================================================================
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (!rst_ni) begin
+            mem_rdata <= '0;
+            ren_dly1 <= 1'b0;
+        end else begin
+            if (mem_ren) mem_rdata <= mem[mem_raddr];
+            ren_dly1 <= ren;
+        end
+    end
+
+    // Downstream ready
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (!rst_ni) begin
+            data_ready_i <= 1'b0;
+        end else begin
+            data_ready_i <= random_ready ? 1'($urandom_range(0, 1)) : 1'b1;
+        end
+    end
+
+    // ========================================================================
+    // Scoreboard
+    // ========================================================================
+    always @(posedge clk_i) begin
+        if (rst_ni) begin
+            read_count += ren;
+            mem_read_count += mem_ren;
+            if (data_valid_o && data_ready_i) begin
+                if (data_o !== word_ref[pop_addr]) begin
+                    $error("Time: %0d ns, word %0d mismatch after %0d pops", $time, pop_addr, pop_count);
+                    error_count++;
+                end
+                pop_addr = (pop_addr == ADDR_WIDTH'(NUM_WORDS - 1)) ? '0 : pop_addr + 1'b1;
+                pop_count++;
+            end
+            if (dut.fifo_full && dut.fifo_push_en && !(data_valid_o && data_ready_i)) begin
+                $error("Time: %0d ns, push into a full FIFO", $time);
+                error_count++;
+            end
+            credit_ref = credit_ref + ren_dly1 - (data_valid_o && data_ready_i);
+            if (credit_ref > FIFO_DEPTH) begin
+                $error("Time: %0d ns, %0d reads outstanding for %0d entries", $time, credit_ref, FIFO_DEPTH);
+                error_count++;
+            end
+        end
+    end
+
+    if (`RDATA_PIPES > 0) begin: gen_credit_check
+        // credit_q is updated on this edge, compare after it settled
+        always @(negedge clk_i) begin
+            if (rst_ni && dut.gen_rdata_pipe.credit_q != credit_ref) begin
+                $error("Time: %0d ns, read credit %0d, expected %0d", $time,
+                    dut.gen_rdata_pipe.credit_q, credit_ref);
+                error_count++;
+            end
+        end
+    end
+
+    // ========================================================================
+    // Test sequence
+    // ========================================================================
+    initial begin
+        integer rate_pops;
+        en_i = 0;
+        random_ready = 1;
+        pop_addr = '0;
+        credit_ref = 0;
+        pop_count = 0;
+        read_count = 0;
+        mem_read_count = 0;
+        error_count = 0;
+        $display("Starting memory to handshake FIFO testbench. RDATA_PIPES: %0d, 2-bit J: %0d, FIFO depth: %0d",
+            `RDATA_PIPES, `PRECISION_2B, FIFO_DEPTH);
+        wait(rst_ni);
+        @(negedge clk_i);
+        en_i = 1;
+
+        // random downstream ready
+        wait(pop_count >= `NUM_TESTS);
+        $display("Random ready: %0d words popped, %0d reads, %0d memory reads", pop_count, read_count,
+            mem_read_count);
+
+        // always ready: one word per cycle
+        random_ready = 0;
+        repeat(WARMUP_CYCLES) @(posedge clk_i);
+        rate_pops = pop_count;
+        repeat(FULL_RATE_CYCLES) @(posedge clk_i);
+        rate_pops = pop_count - rate_pops;
+        $display("Always ready: %0d words in %0d cycles", rate_pops, FULL_RATE_CYCLES);
+        if (rate_pops < FULL_RATE_CYCLES - 1) begin
+            $error("Always ready: %0d words in %0d cycles, expected one per cycle", rate_pops,
+                FULL_RATE_CYCLES);
+            error_count++;
+        end
+        if (`PRECISION_2B && mem_read_count >= read_count) begin
+            $error("2-bit J: %0d memory reads for %0d reads, none suppressed", mem_read_count, read_count);
+            error_count++;
+        end
+
+        $display("----------------------------------------");
+        $display("Scoreboard [Time %0d ns]: %0d words, %0d errors", $time, pop_count, error_count);
+        $display("----------------------------------------");
+        $finish;
+    end
+
+endmodule
@@ -5,46 +5,56 @@
 // Author: Jiacong Sun <jiacong.sun@kuleuven.be>
 //
 // Header-only LAGD register configuration.
+// Control registers are written through the per-core shadow of lagd_core_shadow.h (generated from
+// lagd_core_regs.hjson), so field updates are single stores without reading the register back.
+// Registers updated per field must therefore not be written with reg32 directly.
 
 #pragma once
 
 #include "lagd_define.h"
 #include "lagd_core_reg.h"
 #include "lagd_reg_params.h"
+#include "lagd_core_shadow.h"
 #include "util.h"
 #include "printf.h"
 
+// xorshift64 pseudo-random generator for spin vectors and flip icons of the tests
+static uint64_t lagd_xorshift64(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
 // Configure counter registers
 static void lagd_configure_counters(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
     // Write counter configuration 1
     uint32_t cfg1 =
         ((CFG_TRANS_NUM & LAGD_CORE_COUNTER_CFG_1_CFG_TRANS_NUM_MASK) |
          ((CYCLE_PER_WWL_HIGH & LAGD_CORE_COUNTER_CFG_1_CYCLE_PER_WWL_HIGH_MASK) << 16));
-    *reg32(base, LAGD_CORE_COUNTER_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_counter_cfg_1(core, cfg1);
     // Write counter configuration 2
     uint32_t cfg2 =
         ((CYCLE_PER_WWL_LOW & LAGD_CORE_COUNTER_CFG_2_CYCLE_PER_WWL_LOW_MASK) |
          ((CYCLE_PER_SPIN_WRITE & LAGD_CORE_COUNTER_CFG_2_CYCLE_PER_SPIN_WRITE_MASK) << 16));
-    *reg32(base, LAGD_CORE_COUNTER_CFG_2_REG_OFFSET) = cfg2;
+    lagd_write_counter_cfg_2(core, cfg2);
     // Write counter configuration 3
     uint32_t cfg3 =
         ((CYCLE_PER_SPIN_COMPUTE & LAGD_CORE_COUNTER_CFG_3_CYCLE_PER_SPIN_COMPUTE_MASK) |
          ((DEBUG_CYCLE_PER_SPIN_READ & LAGD_CORE_COUNTER_CFG_3_DEBUG_CYCLE_PER_SPIN_READ_MASK)
           << 16));
-    *reg32(base, LAGD_CORE_COUNTER_CFG_3_REG_OFFSET) = cfg3;
+    lagd_write_counter_cfg_3(core, cfg3);
     // Write counter configuration 4
     uint32_t cfg4 =
         ((DEBUG_SPIN_READ_NUM & LAGD_CORE_COUNTER_CFG_4_DEBUG_SPIN_READ_NUM_MASK) |
          ((ICON_LAST_RADDR_PLUS_ONE & LAGD_CORE_COUNTER_CFG_4_ICON_LAST_RADDR_PLUS_ONE_MASK)
           << 16));
-    *reg32(base, LAGD_CORE_COUNTER_CFG_4_REG_OFFSET) = cfg4;
+    lagd_write_counter_cfg_4(core, cfg4);
 }
 
 // Configure cmpt_max_num register
 static void lagd_configure_cmpt_max_num(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    *reg32(base, LAGD_CORE_CMPT_MAX_NUM_REG_OFFSET) = CMPT_MAX_NUM;
+    lagd_write_cmpt_max_num(core, CMPT_MAX_NUM);
 }
 
 // Configure wwl_vdd_cfg registers
@@ -105,7 +115,6 @@ static void lagd_configure_debug_j_one_hot_wwl(unsigned core) {
 
 // Configure global_cfg_1 register
 static void lagd_configure_global_cfg_1(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
     uint32_t cfg1 =
         (((GCFG1_FLUSH_EN & 0x1) << LAGD_CORE_GLOBAL_CFG_1_FLUSH_EN_BIT) |
          ((GCFG1_EN_AW & 0x1) << LAGD_CORE_GLOBAL_CFG_1_EN_AW_BIT) |
@@ -136,12 +145,11 @@ static void lagd_configure_global_cfg_1(unsigned core) {
          ((GCFG1_WWL_VREAD_CFG_256 & 0x1) << LAGD_CORE_GLOBAL_CFG_1_WWL_VREAD_CFG_256_BIT) |
          ((GCFG1_SYNCHRONIZER_WBL_PIPE_NUM & LAGD_CORE_GLOBAL_CFG_1_SYNCHRONIZER_WBL_PIPE_NUM_MASK)
           << LAGD_CORE_GLOBAL_CFG_1_SYNCHRONIZER_WBL_PIPE_NUM_OFFSET));
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_global_cfg_1(core, cfg1);
 }
 
 // Configure global_cfg_2 register
 static void lagd_configure_global_cfg_2(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
     uint32_t cfg2 =
         (((GCFG2_CMPT_EN & 0x1) << LAGD_CORE_GLOBAL_CFG_2_CMPT_EN_BIT) |
          ((GCFG2_CONFIG_VALID_AW & 0x1) << LAGD_CORE_GLOBAL_CFG_2_CONFIG_VALID_AW_BIT) |
@@ -163,10 +171,9 @@ static void lagd_configure_global_cfg_2(unsigned core) {
           << LAGD_CORE_GLOBAL_CFG_2_CONFIG_SPIN_INITIAL_SKIP_1_BIT) |
          ((GCFG2_DGT_HSCALING & LAGD_CORE_GLOBAL_CFG_2_DGT_HSCALING_MASK)
           << LAGD_CORE_GLOBAL_CFG_2_DGT_HSCALING_OFFSET) |
-         ((GCFG2_ENERGY_FIFO_SEL & 0x1) << LAGD_CORE_GLOBAL_CFG_2_ENERGY_FIFO_SEL_BIT));
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET) = cfg2;
-    // printf("Core %u global_cfg_2: 0x%08x, addr 0x%08x\r\n", core, cfg2,
-    //        (uintptr_t)base + LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET);
+         ((GCFG2_ENERGY_FIFO_SEL & 0x1) << LAGD_CORE_GLOBAL_CFG_2_ENERGY_FIFO_SEL_BIT) |
+         ((GCFG2_J_PRECISION_2B & 0x1) << LAGD_CORE_GLOBAL_CFG_2_J_PRECISION_2B_BIT));
+    lagd_write_global_cfg_2(core, cfg2);
 }
 
 // Switch off config valid signals
@@ -174,30 +181,41 @@ static void lagd_configure_global_cfg_2(unsigned core) {
 // and: DEBUG_DT_CONFIGURE_ENABLE, DEBUG_SPIN_CONFIGURE_ENABLE in global_cfg_1 register (if they are
 // set).
 static void lagd_clear_config_valid(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg2 = *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET);
-    cfg2 &= ~((1 << LAGD_CORE_GLOBAL_CFG_2_CONFIG_VALID_AW_BIT) |
-              (1 << LAGD_CORE_GLOBAL_CFG_2_CONFIG_VALID_EM_BIT) |
-              (1 << LAGD_CORE_GLOBAL_CFG_2_CONFIG_VALID_FM_BIT));
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET) = cfg2;
-    // printf("Core %u global_cfg_2 after clearing config valid: 0x%08x\r\n", core, cfg2);
-
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 &= ~((1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_DT_CONFIGURE_ENABLE_BIT) |
-              (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_SPIN_CONFIGURE_ENABLE_BIT));
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
-    // printf("Core %u global_cfg_1 after clearing debug configure enable: 0x%08x\r\n", core, cfg1);
+    lagd_stage_global_cfg_2_config_valid_aw(core, 0);
+    lagd_stage_global_cfg_2_config_valid_em(core, 0);
+    lagd_stage_global_cfg_2_config_valid_fm(core, 0);
+    lagd_commit_global_cfg_2(core);
+    lagd_stage_global_cfg_1_debug_dt_configure_enable(core, 0);
+    lagd_stage_global_cfg_1_debug_spin_configure_enable(core, 0);
+    lagd_commit_global_cfg_1(core);
 }
 
 // Enable analog data onloading by setting DT_CFG_ENABLE bit in global_cfg_2 register
 static void lagd_enable_analog_onloading(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg2 = *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET);
-    cfg2 |= (1 << LAGD_CORE_GLOBAL_CFG_2_DT_CFG_ENABLE_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET) = cfg2;
+    lagd_write_global_cfg_2_dt_cfg_enable(core, 1);
+    // reset the register
+    lagd_write_global_cfg_2_dt_cfg_enable(core, 0);
+}
+
+// Re-program only the h row of the analog macro from the h_rdata registers (DT_CFG_H_ONLY), e.g.
+// after lagd_load_h_rdata. J stays as onloaded, so this takes one WWL pulse instead of a full
+// onloading. Wait for it with lagd_wait_for_analog_onloading_done.
+static void lagd_enable_h_onloading(unsigned core) {
+    lagd_stage_global_cfg_2_dt_cfg_h_only(core, 1);
+    lagd_stage_global_cfg_2_dt_cfg_enable(core, 1);
+    lagd_commit_global_cfg_2(core);
     // reset the register
-    cfg2 &= ~(1 << LAGD_CORE_GLOBAL_CFG_2_DT_CFG_ENABLE_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET) = cfg2;
+    lagd_stage_global_cfg_2_dt_cfg_h_only(core, 0);
+    lagd_stage_global_cfg_2_dt_cfg_enable(core, 0);
+    lagd_commit_global_cfg_2(core);
+}
+
+// Write the h_rdata registers (NUM_SPIN BIT_H-bit values, first element at the LSB of h[0])
+static void lagd_load_h_rdata(unsigned core, const uint32_t *h) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    for (int i = 0; i < NUM_SPIN * BIT_H / 32; i++) {
+        *reg32(base, LAGD_CORE_H_RDATA_0_REG_OFFSET + 4 * i) = h[i];
+    }
 }
 
 // Check and wait until analog data onloading is done by polling DT_CFG_IDLE bit in output_status
@@ -211,27 +229,19 @@ static void lagd_wait_for_analog_onloading_done(unsigned core) {
 
 // Enable computation by setting cmpt_en bit in global_cfg_2 register
 static void lagd_enable_computation(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg2 = *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET);
-    cfg2 |= (1 << LAGD_CORE_GLOBAL_CFG_2_CMPT_EN_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET) = cfg2;
+    lagd_write_global_cfg_2_cmpt_en(core, 1);
 }
 
 // Enable EN_EF to start energy monitor fifo after J memory onloading and before computation
 static void lagd_enable_energy_monitor_fifo(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 |= (1 << LAGD_CORE_GLOBAL_CFG_1_EN_EF_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_global_cfg_1_en_ef(core, 1);
 }
 
 // Enable computation with multi_cmpt_mode
 static void lagd_enable_computation_multi_cmpt_mode(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg2 = *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET);
-    cfg2 |= (1 << LAGD_CORE_GLOBAL_CFG_2_CMPT_EN_BIT) |
-            (1 << LAGD_CORE_GLOBAL_CFG_2_MULTI_CMPT_MODE_EN_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_2_REG_OFFSET) = cfg2;
+    lagd_stage_global_cfg_2_cmpt_en(core, 1);
+    lagd_stage_global_cfg_2_multi_cmpt_mode_en(core, 1);
+    lagd_commit_global_cfg_2(core);
 }
 
 // Check and wait until the computation starts by polling CMPT_IDLE bit in output_status register
@@ -469,72 +479,49 @@ static void lagd_print_cycle_all_cmpt(unsigned core) {
 
 // Enable debug_dt_configure_enable in global_cfg_1 register
 static void lagd_enable_debug_dt_configure_enable(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 |= (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_DT_CONFIGURE_ENABLE_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_global_cfg_1_debug_dt_configure_enable(core, 1);
 }
 
 // Enable debug_spin_configure_enable in global_cfg_1 register
 static void lagd_enable_debug_spin_configure_enable(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 |= (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_SPIN_CONFIGURE_ENABLE_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_global_cfg_1_debug_spin_configure_enable(core, 1);
 }
 
 // Enable debug_j_write_en
 static void lagd_enable_debug_j_write_en(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 |= (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_J_WRITE_EN_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_global_cfg_1_debug_j_write_en(core, 1);
 }
 
 // Enable debug_j_read_en
 static void lagd_enable_debug_j_read_en(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 |= (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_J_READ_EN_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_global_cfg_1_debug_j_read_en(core, 1);
 }
 
 // Enable debug_spin_write_en
 static void lagd_enable_debug_spin_write_en(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 |= (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_SPIN_WRITE_EN_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_global_cfg_1_debug_spin_write_en(core, 1);
 }
 
 // Enable debug_spin_compute_en
 static void lagd_enable_debug_spin_compute_en(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 |= (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_SPIN_COMPUTE_EN_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_global_cfg_1_debug_spin_compute_en(core, 1);
 }
 
 // Enable debug_spin_read_en
 static void lagd_enable_debug_spin_read_en(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 |= (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_SPIN_READ_EN_BIT);
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_write_global_cfg_1_debug_spin_read_en(core, 1);
 }
 
 // Disable all debug configure enable and debug output enable bits in global_cfg_1 register
 static void lagd_disable_all_debug_enable(unsigned core) {
-    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
-    uint32_t cfg1 = *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET);
-    cfg1 &= ~((1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_DT_CONFIGURE_ENABLE_BIT) |
-              (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_SPIN_CONFIGURE_ENABLE_BIT) |
-              (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_J_WRITE_EN_BIT) |
-              (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_J_READ_EN_BIT) |
-              (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_SPIN_WRITE_EN_BIT) |
-              (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_SPIN_COMPUTE_EN_BIT) |
-              (1 << LAGD_CORE_GLOBAL_CFG_1_DEBUG_SPIN_READ_EN_BIT));
-    *reg32(base, LAGD_CORE_GLOBAL_CFG_1_REG_OFFSET) = cfg1;
+    lagd_stage_global_cfg_1_debug_dt_configure_enable(core, 0);
+    lagd_stage_global_cfg_1_debug_spin_configure_enable(core, 0);
+    lagd_stage_global_cfg_1_debug_j_write_en(core, 0);
+    lagd_stage_global_cfg_1_debug_j_read_en(core, 0);
+    lagd_stage_global_cfg_1_debug_spin_write_en(core, 0);
+    lagd_stage_global_cfg_1_debug_spin_compute_en(core, 0);
+    lagd_stage_global_cfg_1_debug_spin_read_en(core, 0);
+    lagd_commit_global_cfg_1(core);
 }
 
 // Read out debug_wbl_read_data register and print the value
@@ -595,13 +582,85 @@ static int lagd_check_debug_wblb_read_data(unsigned core) {
     return fail;
 }
 
+// Get the base address of a J memory bank of a core
+static uintptr_t lagd_l1_j_mem_addr(unsigned core, unsigned bank) {
+    return (uintptr_t)IC_MEM_BASE_ADDR + (uintptr_t)core * IC_L1_MEM_SIZE_B +
+           (uintptr_t)bank * L1_J_MEM_SIZE_B;
+}
+
+// Get the base address of a flip memory bank of a core
+static uintptr_t lagd_l1_f_mem_addr(unsigned core, unsigned bank) {
+    return (uintptr_t)IC_J_MEM_END_ADDR + (uintptr_t)core * IC_L1_MEM_SIZE_B +
+           (uintptr_t)bank * L1_FLIP_MEM_SIZE_B;
+}
+
+// Get the base address of a J memory bank in the broadcast alias
+static uintptr_t lagd_bcast_j_mem_addr(unsigned bank) {
+    return (uintptr_t)IC_BCAST_BASE_ADDR + (uintptr_t)bank * L1_J_MEM_SIZE_B;
+}
+
+// Get the base address of a flip memory bank in the broadcast alias
+static uintptr_t lagd_bcast_f_mem_addr(unsigned bank) {
+    return (uintptr_t)IC_BCAST_BASE_ADDR + IC_L1_J_MEM_REGION_B +
+           (uintptr_t)bank * L1_FLIP_MEM_SIZE_B;
+}
+
+// Select the cores (bit c: core c) that receive the writes to the J and flip broadcast aliases
+// Only change the selection when no broadcast write is in flight. Reset: all cores.
+static void lagd_select_bcast(uint32_t j_mask, uint32_t f_mask) {
+    for (unsigned core = 0; core < NUM_ISING_CORES; core++) {
+        lagd_stage_bcast_cfg_bcast_j_en(core, (j_mask >> core) & 0x1);
+        lagd_stage_bcast_cfg_bcast_f_en(core, (f_mask >> core) & 0x1);
+        lagd_commit_bcast_cfg(core);
+    }
+}
+
+// Write num 64-bit words to a memory region of every selected core at once, through an alias
+static void lagd_bcast_write(uintptr_t alias, const uint64_t *src, unsigned num) {
+    volatile uint64_t *dst = (volatile uint64_t *)alias;
+    for (unsigned i = 0; i < num; i++) dst[i] = src[i];
+    // wait until every selected core has acknowledged the writes
+    fence();
+}
+
+// Load a J matrix image (num 64-bit words) into a J memory bank of the selected cores
+static void lagd_bcast_load_j_mem(unsigned bank, const uint64_t *src, unsigned num) {
+    lagd_bcast_write(lagd_bcast_j_mem_addr(bank), src, num);
+}
+
+// Load flip vectors (num 64-bit words) into a flip memory bank of the selected cores
+static void lagd_bcast_load_f_mem(unsigned bank, const uint64_t *src, unsigned num) {
+    lagd_bcast_write(lagd_bcast_f_mem_addr(bank), src, num);
+}
+
+// Select the J memory bank read by the next analog onloading (and the following computations)
+// Only effective when L1_NUM_BUFFERS = 2.
+static void lagd_select_j_mem_bank(unsigned core, unsigned bank) {
+    lagd_write_l1_mem_bank_j_mem_bank_sel(core, bank);
+}
+
+// Select the flip memory bank read by the next computation
+// Only effective when L1_NUM_BUFFERS = 2.
+static void lagd_select_flip_mem_bank(unsigned core, unsigned bank) {
+    lagd_write_l1_mem_bank_flip_mem_bank_sel(core, bank);
+}
+
+// Get the J memory bank currently used by onloading and the energy monitor
+static unsigned lagd_get_j_mem_bank_active(unsigned core) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t status = *reg32(base, LAGD_CORE_OUTPUT_STATUS_REG_OFFSET);
+    return (status >> LAGD_CORE_OUTPUT_STATUS_J_MEM_BANK_ACTIVE_BIT) & 0x1;
+}
+
+// Get the shadow J memory bank, i.e. the one that can be written during computation
+static unsigned lagd_get_j_mem_bank_shadow(unsigned core) {
+    return lagd_get_j_mem_bank_active(core) ^ (L1_NUM_BUFFERS > 1);
+}
+
 // Read out core's l1_j_mem and print the value
 // Each read is 4096 bits wide, accessed as 64x64-bit (AXI width)
 static void lagd_print_l1_j_mem(unsigned core, unsigned length) {
-    volatile uint64_t *base =
-        (volatile uint64_t *)((uintptr_t)IC_MEM_BASE_ADDR +
-                              (uintptr_t)core *
-                                  ((uintptr_t)L1_J_MEM_SIZE_B + (uintptr_t)L1_FLIP_MEM_SIZE_B));
+    volatile uint64_t *base = (volatile uint64_t *)lagd_l1_j_mem_addr(core, 0);
     for (unsigned i = 0; i < length; i++) {
         uint64_t data[IC_L1_J_MEM_DATA_WIDTH / 64]; // 64 x 64-bit = 4096 bits
         for (int j = 0; j < IC_L1_J_MEM_DATA_WIDTH / 64; j++) {
@@ -616,10 +675,7 @@ static void lagd_print_l1_j_mem(unsigned core, unsigned length) {
 // Read out core's l1_f_mem and print the value
 // Each read is IC_L1_FLIP_MEM_DATA_WIDTH (256) bits wide, accessed as 4x64-bit (AXI width)
 static void lagd_print_l1_f_mem(unsigned core, unsigned length) {
-    volatile uint64_t *base =
-        (volatile uint64_t *)((uintptr_t)IC_J_MEM_END_ADDR +
-                              (uintptr_t)core *
-                                  ((uintptr_t)L1_J_MEM_SIZE_B + (uintptr_t)L1_FLIP_MEM_SIZE_B));
+    volatile uint64_t *base = (volatile uint64_t *)lagd_l1_f_mem_addr(core, 0);
     for (unsigned i = 0; i < length; i++) {
         uint64_t data[IC_L1_FLIP_MEM_DATA_WIDTH / 64]; // 4 x 64-bit words
         for (int j = 0; j < IC_L1_FLIP_MEM_DATA_WIDTH / 64; j++) {
@@ -640,10 +696,7 @@ static int lagd_check_l1_f_mem(unsigned core, unsigned length) {
         0xd38a96512fb3daa2ULL, // bits [191:128]
         0x797a68f1635d4c26ULL  // bits [255:192]
     };
-    volatile uint64_t *base =
-        (volatile uint64_t *)((uintptr_t)IC_J_MEM_END_ADDR +
-                              (uintptr_t)core *
-                                  ((uintptr_t)L1_J_MEM_SIZE_B + (uintptr_t)L1_FLIP_MEM_SIZE_B));
+    volatile uint64_t *base = (volatile uint64_t *)lagd_l1_f_mem_addr(core, 0);
     for (unsigned i = 0; i < length; i++) {
         uint64_t data[IC_L1_FLIP_MEM_DATA_WIDTH / 64]; // 4 x 64-bit words
         for (int j = 0; j < IC_L1_FLIP_MEM_DATA_WIDTH / 64; j++) {
@@ -656,3 +709,557 @@ static int lagd_check_l1_f_mem(unsigned core, unsigned length) {
     }
     return fail;
 }
+
+// Get a flip memory word address of the bank selected for the next computation
+static volatile uint64_t *lagd_restart_queue_word(unsigned core, unsigned word) {
+    uint32_t sel = lagd_shadow_l1_mem_bank(core);
+    unsigned bank = (sel >> LAGD_CORE_L1_MEM_BANK_FLIP_MEM_BANK_SEL_BIT) & (L1_NUM_BUFFERS > 1);
+    return (volatile uint64_t *)lagd_l1_f_mem_addr(core, bank) +
+           (uintptr_t)word * (IC_L1_FLIP_MEM_DATA_WIDTH / 64);
+}
+
+// Number of restarts whose state and result lists fit in the flip memory behind word first_word
+// (the end of the flip icons): a restart takes 2 * SPIN_DEPTH + 1 words, so a 1024-word flip
+// memory holds about 100 restarts behind 512 icons with SPIN_DEPTH = 2, and about 200 without
+// icons. Longer campaigns must be run in rounds of at most this many restarts.
+static unsigned lagd_restart_queue_capacity(unsigned first_word) {
+    const unsigned words = L1_FLIP_MEM_SIZE_B / (IC_L1_FLIP_MEM_DATA_WIDTH / 8);
+    return first_word < words ? (words - first_word) / (2 * SPIN_DEPTH + 1) : 0;
+}
+
+// Check that the restart state and result lists of num_restarts restarts fit in the flip memory
+// Returns 0 if they fit. The lists only live in the flip memory, so num_restarts is bounded by
+// lagd_restart_queue_capacity. Accesses past the end are dropped by the core (see
+// lagd_get_restart_queue_overflow).
+static int lagd_check_restart_queue(unsigned state_base, unsigned result_base,
+                                    unsigned num_restarts) {
+    const unsigned words = L1_FLIP_MEM_SIZE_B / (IC_L1_FLIP_MEM_DATA_WIDTH / 8);
+    return state_base + num_restarts * SPIN_DEPTH > words ||
+           result_base + num_restarts * (SPIN_DEPTH + 1) > words;
+}
+
+// Configure the restart queue list addresses (flip memory word addresses)
+// The lists must not overlap the flip icons [0, ICON_LAST_RADDR_PLUS_ONE), and must fit in the
+// flip memory (lagd_check_restart_queue).
+static void lagd_configure_restart_queue(unsigned core, unsigned state_base, unsigned result_base) {
+    lagd_stage_restart_queue_addr_state_base(core, state_base);
+    lagd_stage_restart_queue_addr_result_base(core, result_base);
+    lagd_commit_restart_queue_addr(core);
+}
+
+// Write the SPIN_DEPTH initial spin vectors of restart idx into the restart state list
+// spins[k * NUM_SPIN / 64 + j] holds bits [64*j+63:64*j] of spin vector k.
+static void lagd_write_restart_state(unsigned core, unsigned state_base, unsigned idx,
+                                     const uint64_t *spins) {
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        volatile uint64_t *word = lagd_restart_queue_word(core, state_base + idx * SPIN_DEPTH + k);
+        for (int j = 0; j < NUM_SPIN / 64; j++) word[j] = spins[k * (NUM_SPIN / 64) + j];
+    }
+}
+
+// Read the SPIN_DEPTH initial spin vectors of restart idx back from the restart state list
+static void lagd_read_restart_state(unsigned core, unsigned state_base, unsigned idx,
+                                    uint64_t *spins) {
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        volatile uint64_t *word = lagd_restart_queue_word(core, state_base + idx * SPIN_DEPTH + k);
+        for (int j = 0; j < NUM_SPIN / 64; j++) spins[k * (NUM_SPIN / 64) + j] = word[j];
+    }
+}
+
+// Enable the restart queue and wait until the initial spins of restart 0 are loaded
+// Call before configuring the flip manager (CONFIG_VALID_FM).
+static void lagd_enable_restart_queue(unsigned core) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    lagd_write_restart_queue_cfg(core, 0);
+    lagd_write_restart_queue_cfg(core, 1);
+    while ((*reg32(base, LAGD_CORE_RESTART_QUEUE_STATUS_REG_OFFSET) &
+            (1 << LAGD_CORE_RESTART_QUEUE_STATUS_READY_BIT)) == 0)
+        ;
+}
+
+// Disable the restart queue (initial spins come from config_spin_initial_0/1 again)
+static void lagd_disable_restart_queue(unsigned core) {
+    lagd_write_restart_queue_cfg(core, 0);
+}
+
+// Get the number of results stored since the restart queue was enabled
+static unsigned lagd_get_restart_queue_store_cnt(unsigned core) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t status = *reg32(base, LAGD_CORE_RESTART_QUEUE_STATUS_REG_OFFSET);
+    return (status >> LAGD_CORE_RESTART_QUEUE_STATUS_STORE_CNT_OFFSET) &
+           LAGD_CORE_RESTART_QUEUE_STATUS_STORE_CNT_MASK;
+}
+
+// Check whether a restart list ran past the end of the flip memory since the queue was enabled
+// (a result was dropped, or a computation started from states that could not be fetched)
+static int lagd_get_restart_queue_overflow(unsigned core) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t status = *reg32(base, LAGD_CORE_RESTART_QUEUE_STATUS_REG_OFFSET);
+    return (status >> LAGD_CORE_RESTART_QUEUE_STATUS_OVERFLOW_BIT) & 0x1;
+}
+
+// Read the result of computation idx from the result list
+// spins uses the same layout as lagd_write_restart_state; energies gets SPIN_DEPTH values.
+static void lagd_read_restart_result(unsigned core, unsigned result_base, unsigned idx,
+                                     uint64_t *spins, int32_t *energies) {
+    unsigned first = result_base + idx * (SPIN_DEPTH + 1);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        volatile uint64_t *word = lagd_restart_queue_word(core, first + k);
+        for (int j = 0; j < NUM_SPIN / 64; j++) spins[k * (NUM_SPIN / 64) + j] = word[j];
+    }
+    volatile uint32_t *energy =
+        (volatile uint32_t *)lagd_restart_queue_word(core, first + SPIN_DEPTH);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) energies[k] = (int32_t)energy[k];
+}
+
+// Configure the replica exchange schedule: exchange every iters_per_exchange iterations
+// (flip icons per computation), num_exchanges times (one multi-cmpt computation per interval)
+// Cores should use the same schedule; a core that ends its multi-cmpt run early leaves the exchange
+// and the other cores keep exchanging among themselves.
+static void lagd_configure_replica_exchange_schedule(unsigned core, unsigned iters_per_exchange,
+                                                     unsigned num_exchanges) {
+    lagd_write_counter_cfg_4_icon_last_raddr_plus_one(core, iters_per_exchange);
+    lagd_write_cmpt_max_num(core, num_exchanges);
+}
+
+// Enable the replica exchange with the next (hotter) core and clear the swap counter
+// pair_temp is 1 / (beta(core) - beta(core + 1)) in energy units: replicas are swapped with the
+// Metropolis probability min(1, exp(-(E(core + 1) - E(core)) / pair_temp)) (0: only downhill
+// swaps). The pair is only evaluated after every interval-th computation (0 and 1: after each).
+static void lagd_enable_replica_exchange(unsigned core, unsigned pair_temp, unsigned interval) {
+    lagd_stage_replica_exchange_cfg_pair_temp(core, pair_temp);
+    lagd_stage_replica_exchange_cfg_interval(core, interval);
+    lagd_stage_replica_exchange_cfg_replica_exchange_en(core, 0);
+    lagd_commit_replica_exchange_cfg(core);
+    lagd_write_replica_exchange_cfg_replica_exchange_en(core, 1);
+}
+
+// Disable the replica exchange
+static void lagd_disable_replica_exchange(unsigned core) {
+    lagd_write_replica_exchange_cfg(core, 0);
+}
+
+// Get the number of replicas swapped into the core since the replica exchange was enabled
+static unsigned lagd_get_replica_exchange_swap_cnt(unsigned core) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t status = *reg32(base, LAGD_CORE_REPLICA_EXCHANGE_STATUS_REG_OFFSET);
+    return (status >> LAGD_CORE_REPLICA_EXCHANGE_STATUS_SWAP_CNT_OFFSET) &
+           LAGD_CORE_REPLICA_EXCHANGE_STATUS_SWAP_CNT_MASK;
+}
+
+// Enable the batched energy evaluation: one J sweep serves SPIN_DEPTH spin vectors
+// Batching needs flip detection off, so this clears it in global_cfg_1 (call it after
+// lagd_configure_global_cfg_1). An incomplete batch is padded after timeout idle cycles.
+static void lagd_enable_em_batch(unsigned core, unsigned timeout) {
+    lagd_write_global_cfg_1_enable_flip_detection(core, 0);
+    lagd_stage_em_batch_cfg_em_batch_timeout(core, timeout);
+    lagd_stage_em_batch_cfg_em_batch_en(core, 1);
+    lagd_commit_em_batch_cfg(core);
+}
+
+// Disable the batched energy evaluation (flip detection is left as configured)
+static void lagd_disable_em_batch(unsigned core) {
+    lagd_write_em_batch_cfg_em_batch_en(core, 0);
+}
+
+// Computation state of a core, saved by lagd_save_checkpoint
+// spins/energies are in pop order (slot 0 is popped first when resuming); spins[k][j] holds
+// bits [32*j+31:32*j] of spin vector k.
+typedef struct {
+    uint32_t spins[SPIN_DEPTH][NUM_SPIN / 32];
+    int32_t energies[SPIN_DEPTH];
+    uint32_t flip_raddr;
+    uint32_t cmpt_idx;
+    uint32_t cmpt_max_num;
+} lagd_checkpoint_t;
+
+static const uint32_t lagd_spin_fifo_data_offset[2] = {LAGD_CORE_SPIN_FIFO_DATA_0_0_REG_OFFSET,
+                                                       LAGD_CORE_SPIN_FIFO_DATA_1_0_REG_OFFSET};
+static const uint32_t lagd_energy_fifo_data_offset[2] = {LAGD_CORE_ENERGY_FIFO_DATA_0_REG_OFFSET,
+                                                         LAGD_CORE_ENERGY_FIFO_DATA_1_REG_OFFSET};
+static const uint32_t lagd_config_spin_initial_offset[2] = {
+    LAGD_CORE_CONFIG_SPIN_INITIAL_0_0_REG_OFFSET, LAGD_CORE_CONFIG_SPIN_INITIAL_1_0_REG_OFFSET};
+static const uint32_t lagd_resume_energy_offset[2] = {LAGD_CORE_RESUME_ENERGY_0_REG_OFFSET,
+                                                      LAGD_CORE_RESUME_ENERGY_1_REG_OFFSET};
+
+// Pause the running computation and wait until the core is idle
+// The spins in flight return first, so the spin and energy FIFOs hold a consistent state.
+// In multi_cmpt_mode, the pause also ends the remaining computations.
+static void lagd_pause_computation(unsigned core) {
+    lagd_write_checkpoint_cfg(core, 1 << LAGD_CORE_CHECKPOINT_CFG_PAUSE_REQ_BIT);
+    lagd_wait_for_computation_done(core);
+    // leave the computation enable low so the resumed computation gets a fresh start edge
+    lagd_stage_global_cfg_2_cmpt_en(core, 0);
+    lagd_stage_global_cfg_2_multi_cmpt_mode_en(core, 0);
+    lagd_commit_global_cfg_2(core);
+}
+
+// Save the state of a paused core (see lagd_pause_computation) and clear the pause request
+// The spin FIFO slots are rotated so that the slot popped next comes first. cmpt_idx is only
+// counted with the performance counters enabled (EN_PERF_COUNTER).
+static void lagd_save_checkpoint(unsigned core, lagd_checkpoint_t *ckpt) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t status = *reg32(base, LAGD_CORE_CHECKPOINT_STATUS_REG_OFFSET);
+    unsigned head = (status >> LAGD_CORE_CHECKPOINT_STATUS_SPIN_FIFO_HEAD_OFFSET) &
+                    LAGD_CORE_CHECKPOINT_STATUS_SPIN_FIFO_HEAD_MASK;
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        unsigned slot = (head + k) % SPIN_DEPTH;
+        for (int j = 0; j < NUM_SPIN / 32; j++)
+            ckpt->spins[k][j] = *reg32(base, lagd_spin_fifo_data_offset[slot] + 4 * j);
+        ckpt->energies[k] = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[slot]);
+    }
+    ckpt->flip_raddr = (status >> LAGD_CORE_CHECKPOINT_STATUS_FLIP_RADDR_OFFSET) &
+                       LAGD_CORE_CHECKPOINT_STATUS_FLIP_RADDR_MASK;
+    ckpt->cmpt_idx = *reg32(base, LAGD_CORE_CMPT_IDX_REG_OFFSET);
+    ckpt->cmpt_max_num = lagd_shadow_cmpt_max_num(core);
+    lagd_write_checkpoint_cfg(core, 0);
+}
+
+// Restore a checkpoint: the next computation start continues the saved computation
+// Call it instead of lagd_configure_initial_spins, after lagd_configure_counters /
+// lagd_configure_cmpt_max_num and before lagd_configure_global_cfg_2 (which loads the initial
+// spins and cmpt_max_num). In multi_cmpt_mode, only the remaining computations are run. The
+// J/flip memories and the other registers must hold the same configuration as when saving.
+static void lagd_restore_checkpoint(unsigned core, const lagd_checkpoint_t *ckpt) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        for (int j = 0; j < NUM_SPIN / 32; j++)
+            *reg32(base, lagd_config_spin_initial_offset[k] + 4 * j) = ckpt->spins[k][j];
+        *reg32(base, lagd_resume_energy_offset[k]) = (uint32_t)ckpt->energies[k];
+    }
+    if (ckpt->cmpt_idx != 0) lagd_write_cmpt_max_num(core, ckpt->cmpt_max_num + 1 - ckpt->cmpt_idx);
+    lagd_stage_checkpoint_cfg_resume_flip_raddr(core, ckpt->flip_raddr);
+    lagd_stage_checkpoint_cfg_resume_en(core, 1);
+    lagd_commit_checkpoint_cfg(core);
+}
+
+// Clear the resume request once the resumed computation has started
+static void lagd_clear_resume(unsigned core) {
+    lagd_write_checkpoint_cfg(core, 0);
+}
+
+// Solution read from the top-K buffer; spin[j] holds bits [32*j+31:32*j] of the spin vector
+typedef struct {
+    int32_t energy;
+    uint32_t spin[NUM_SPIN / 32];
+} lagd_solution_t;
+
+// Empty the top-K solutions buffer and enable it, keeping the k lowest-energy distinct spin
+// vectors (k is limited to the TopK entries of the hardware). The buffer then collects the
+// solutions of all following computations, including the restarts of multi_cmpt_mode.
+static void lagd_enable_topk(unsigned core, unsigned k) {
+    lagd_stage_topk_cfg_topk_en(core, 0);
+    lagd_stage_topk_cfg_topk_clear(core, 1);
+    lagd_stage_topk_cfg_topk_k(core, k);
+    lagd_commit_topk_cfg(core);
+    lagd_stage_topk_cfg_topk_clear(core, 0);
+    lagd_stage_topk_cfg_topk_en(core, 1);
+    lagd_commit_topk_cfg(core);
+}
+
+// Stop collecting solutions (the buffer content is kept)
+static void lagd_disable_topk(unsigned core) {
+    lagd_write_topk_cfg_topk_en(core, 0);
+}
+
+// Read the top-K buffer into sol, sorted by increasing energy, after the computation is done
+// Returns the number of solutions read (at most max_num).
+static unsigned lagd_read_topk(unsigned core, lagd_solution_t *sol, unsigned max_num) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    unsigned n = *reg32(base, LAGD_CORE_TOPK_STATUS_REG_OFFSET) &
+                 LAGD_CORE_TOPK_STATUS_TOPK_COUNT_MASK;
+    if (n > max_num) n = max_num;
+    for (unsigned i = 0; i < n; i++) {
+        lagd_write_topk_cfg_topk_rd_idx(core, i);
+        sol[i].energy = (int32_t)*reg32(base, LAGD_CORE_TOPK_ENERGY_REG_OFFSET);
+        for (int j = 0; j < NUM_SPIN / 32; j++)
+            sol[i].spin[j] = *reg32(base, LAGD_CORE_TOPK_SPIN_0_REG_OFFSET + 4 * j);
+    }
+    return n;
+}
+
+// Acceptance rules of new spin vectors (accept_cfg.accept_mode), used with en_comparison
+enum {
+    LAGD_ACCEPT_GREEDY = 0,     // strictly lower energy only
+    LAGD_ACCEPT_THRESHOLD = 1,  // energy increase below the temperature
+    LAGD_ACCEPT_METROPOLIS = 2, // energy increase delta with probability exp(-delta/T)
+};
+
+// Configure the acceptance rule and its cooling schedule. The temperature (in energy units) is
+// reloaded with t_start at the start of every computation and decreases by T >> decay_shift
+// every interval energy evaluations, down to t_min (decay_shift = 0 keeps it constant). The
+// Metropolis RNG is reseeded with seed whenever a computation is started by the host.
+static void lagd_configure_acceptance(unsigned core, unsigned mode, uint16_t t_start,
+                                      uint16_t t_min, unsigned decay_shift, uint16_t interval,
+                                      uint32_t seed) {
+    lagd_stage_accept_cfg_accept_mode(core, mode);
+    lagd_stage_accept_cfg_accept_t_decay_shift(core, decay_shift);
+    lagd_stage_accept_cfg_accept_t_interval(core, interval);
+    lagd_commit_accept_cfg(core);
+    lagd_stage_accept_temp_accept_t_start(core, t_start);
+    lagd_stage_accept_temp_accept_t_min(core, t_min);
+    lagd_commit_accept_temp(core);
+    lagd_write_accept_seed(core, seed);
+}
+
+// Current temperature of the acceptance rule
+static uint16_t lagd_get_accept_temp(unsigned core) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    return *reg32(base, LAGD_CORE_ACCEPT_STATUS_REG_OFFSET) &
+           LAGD_CORE_ACCEPT_STATUS_ACCEPT_TEMP_MASK;
+}
+
+// Number of new spins accepted without a lower energy in the last computation (saturating)
+static unsigned lagd_get_accept_uphill_cnt(unsigned core) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t status = *reg32(base, LAGD_CORE_ACCEPT_STATUS_REG_OFFSET);
+    return (status >> LAGD_CORE_ACCEPT_STATUS_ACCEPT_UPHILL_CNT_OFFSET) &
+           LAGD_CORE_ACCEPT_STATUS_ACCEPT_UPHILL_CNT_MASK;
+}
+
+// Enable block-diagonal packing of 2^blocks_log2 independent models (blocks_log2 is limited to
+// log2(PackBlocks) of the hardware). Block b owns the spin vector bits [b * size, (b + 1) * size)
+// with size = NUM_SPIN >> blocks_log2, and J must not couple spins of different blocks (see
+// compile_model.py, lagd_pack_mask_j). The per-block energies need flip detection off, so this
+// clears it in global_cfg_1 (call it after lagd_configure_global_cfg_1). The best spins of every
+// block are then tracked over all following computations.
+static void lagd_enable_pack(unsigned core, unsigned blocks_log2) {
+    lagd_write_global_cfg_1_enable_flip_detection(core, 0);
+    lagd_stage_pack_cfg_pack_en(core, 0);
+    lagd_stage_pack_cfg_pack_clear(core, 1);
+    lagd_stage_pack_cfg_pack_blocks_log2(core, blocks_log2);
+    lagd_commit_pack_cfg(core);
+    lagd_stage_pack_cfg_pack_clear(core, 0);
+    lagd_stage_pack_cfg_pack_en(core, 1);
+    lagd_commit_pack_cfg(core);
+}
+
+// Stop tracking the per-block best spins (the results are kept)
+static void lagd_disable_pack(unsigned core) {
+    lagd_write_pack_cfg_pack_en(core, 0);
+}
+
+// Read the packing results after the computation is done: the best energy of each of the
+// 2^blocks_log2 blocks into energy, and the best spins of all blocks, concatenated, into spin
+// Returns the mask of the blocks that have a result.
+static uint32_t lagd_read_pack(unsigned core, unsigned blocks_log2, int32_t *energy,
+                               uint32_t *spin) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t valid = *reg32(base, LAGD_CORE_PACK_STATUS_REG_OFFSET) &
+                     LAGD_CORE_PACK_STATUS_PACK_VALID_MASK;
+    for (unsigned b = 0; b < (1u << blocks_log2); b++) {
+        lagd_write_pack_cfg_pack_rd_idx(core, b);
+        energy[b] = (int32_t)*reg32(base, LAGD_CORE_PACK_ENERGY_REG_OFFSET);
+    }
+    for (int j = 0; j < NUM_SPIN / 32; j++)
+        spin[j] = *reg32(base, LAGD_CORE_PACK_SPIN_0_REG_OFFSET + 4 * j);
+    return valid;
+}
+
+// Extract the spins of block b from a packed spin vector: bit i of the block (variable i of
+// problem b of compile_model.py) goes to bit i % 32 of out[i / 32]
+static void lagd_pack_unpack_spin(const uint32_t *spin, unsigned blocks_log2, unsigned b,
+                                  uint32_t *out) {
+    const unsigned size = NUM_SPIN >> blocks_log2;
+    for (unsigned w = 0; w < (size + 31) / 32; w++) out[w] = 0;
+    for (unsigned i = 0; i < size; i++) {
+        unsigned k = b * size + i;
+        out[i / 32] |= ((spin[k / 32] >> (k % 32)) & 0x1) << (i % 32);
+    }
+}
+
+// Insert the spins of block b (laid out as by lagd_pack_unpack_spin) into a packed spin vector,
+// e.g. to build initial spins
+static void lagd_pack_insert_spin(uint32_t *spin, unsigned blocks_log2, unsigned b,
+                                  const uint32_t *in) {
+    const unsigned size = NUM_SPIN >> blocks_log2;
+    for (unsigned i = 0; i < size; i++) {
+        unsigned k = b * size + i;
+        spin[k / 32] &= ~(1u << (k % 32));
+        spin[k / 32] |= ((in[i / 32] >> (i % 32)) & 0x1) << (k % 32);
+    }
+}
+
+// Clear the couplings between spins of different blocks in a J image (layout of
+// gen_model_data.py with j_bits-bit elements, e.g. the model in the L1 J memory), so that it only
+// keeps the 2^blocks_log2 models on its diagonal blocks
+static void lagd_pack_mask_j(volatile uint64_t *j, unsigned j_bits, unsigned blocks_log2) {
+    const unsigned per_word = 64 / j_bits;
+    const unsigned words_per_row = NUM_SPIN / per_word;
+    const unsigned size = NUM_SPIN >> blocks_log2;
+    const uint64_t elem_mask = ((uint64_t)1 << j_bits) - 1;
+    // row/column m of the image is spin vector bit NUM_SPIN - 1 - m
+    for (unsigned m = 0; m < NUM_SPIN; m++) {
+        unsigned block = (NUM_SPIN - 1 - m) / size;
+        for (unsigned w = 0; w < words_per_row; w++) {
+            // word w holds the columns c0 to c0 + per_word - 1, MSB first
+            unsigned c0 = (words_per_row - 1 - w) * per_word;
+            uint64_t keep = 0;
+            for (unsigned t = 0; t < per_word; t++) {
+                if ((NUM_SPIN - 1 - (c0 + t)) / size == block)
+                    keep |= elem_mask << ((per_word - 1 - t) * j_bits);
+            }
+            j[m * words_per_row + w] &= keep;
+        }
+    }
+}
+
+// Write spin vector idx of an energy-oracle batch into the spin vector list
+// spin[j] holds bits [64*j+63:64*j] of the spin vector (the layout of the spin_fifo_data words).
+static void lagd_write_oracle_spin(unsigned core, unsigned src_base, unsigned idx,
+                                   const uint64_t *spin) {
+    volatile uint64_t *word = lagd_restart_queue_word(core, src_base + idx);
+    for (int j = 0; j < NUM_SPIN / 64; j++) word[j] = spin[j];
+}
+
+// Switch the core to energy-oracle mode: the analog loop and flip detection are turned off, so the
+// energy monitor evaluates spin vectors from the flip memory against the J/h of the L1 J memory
+// and h_rdata. Call after the configuration, with the energy monitor FIFO enabled and the
+// computation done.
+static void lagd_enable_oracle(unsigned core) {
+    lagd_stage_global_cfg_1_en_analog_loop(core, 0);
+    lagd_stage_global_cfg_1_enable_flip_detection(core, 0);
+    lagd_commit_global_cfg_1(core);
+}
+
+// Evaluate the num spin vectors at src_base (flip memory word addresses) and wait until their
+// energies are stored at dst_base, 8 per word (see lagd_read_oracle_energy)
+// The lists must not overlap the flip icons [0, ICON_LAST_RADDR_PLUS_ONE).
+static void lagd_oracle_run(unsigned core, unsigned src_base, unsigned dst_base, unsigned num) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    lagd_stage_oracle_addr_src_base(core, src_base);
+    lagd_stage_oracle_addr_dst_base(core, dst_base);
+    lagd_commit_oracle_addr(core);
+    lagd_stage_oracle_cfg_oracle_num(core, num);
+    lagd_stage_oracle_cfg_oracle_en(core, 0);
+    lagd_commit_oracle_cfg(core);
+    lagd_write_oracle_cfg_oracle_en(core, 1);
+    while ((*reg32(base, LAGD_CORE_ORACLE_STATUS_REG_OFFSET) &
+            (1 << LAGD_CORE_ORACLE_STATUS_DONE_BIT)) == 0)
+        ;
+    lagd_write_oracle_cfg_oracle_en(core, 0);
+}
+
+// Read the energy of spin vector idx of the last batch from the energy list
+static int32_t lagd_read_oracle_energy(unsigned core, unsigned dst_base, unsigned idx) {
+    volatile uint32_t *energy =
+        (volatile uint32_t *)lagd_restart_queue_word(core, dst_base + idx / 8);
+    return (int32_t)energy[idx % 8];
+}
+
+// Enable the flip memory ring buffer for a flip schedule of total icons, longer than the flip
+// memory: the first size icons of the flip memory are read circularly, and the host refills the
+// slots behind the read pointer (lagd_flip_ring_refill). The ring_low/ring_high flags of
+// flip_mem_ren_raddr tell when the fill level reaches low_wm/high_wm icons. Call before the
+// configuration is applied (the read count is cleared with the flip manager).
+static void lagd_enable_flip_ring(unsigned core, unsigned size, uint32_t total, unsigned low_wm,
+                                  unsigned high_wm) {
+    lagd_write_counter_cfg_4_icon_last_raddr_plus_one(core, size);
+    lagd_write_flip_ring_fill(core, 0);
+    lagd_write_flip_ring_total(core, total);
+    lagd_stage_flip_ring_cfg_ring_low_wm(core, low_wm);
+    lagd_stage_flip_ring_cfg_ring_high_wm(core, high_wm);
+    lagd_stage_flip_ring_cfg_ring_en(core, 1);
+    lagd_commit_flip_ring_cfg(core);
+}
+
+// Stop reading the flip memory as a ring buffer
+static void lagd_disable_flip_ring(unsigned core) {
+    lagd_write_flip_ring_cfg_ring_en(core, 0);
+}
+
+// Number of icons of the schedule read from the flip ring so far
+static uint32_t lagd_get_flip_ring_read_cnt(unsigned core) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    return *reg32(base, LAGD_CORE_FLIP_RING_STATUS_REG_OFFSET);
+}
+
+// Copy the next icons of the schedule (NUM_SPIN/64 words per icon, e.g. in L2 or DRAM) into the
+// free slots of a ring of size icons, up to total icons, and publish them to the flip engine.
+// *filled is the number of icons written so far; returns the number of icons copied.
+// The copy of contiguous slots can be handed to the DMA instead, the fill count must then only be
+// written once the transfer is done.
+static unsigned lagd_flip_ring_refill(unsigned core, unsigned size, const uint64_t *schedule,
+                                      uint32_t total, uint32_t *filled) {
+    uint32_t read = lagd_get_flip_ring_read_cnt(core);
+    unsigned copied = 0;
+    while (*filled < total && *filled - read < size) {
+        volatile uint64_t *word = lagd_restart_queue_word(core, *filled % size);
+        const uint64_t *icon = schedule + (uintptr_t)*filled * (NUM_SPIN / 64);
+        for (int j = 0; j < NUM_SPIN / 64; j++) word[j] = icon[j];
+        (*filled)++;
+        copied++;
+    }
+    if (copied) {
+        fence();
+        lagd_write_flip_ring_fill(core, *filled);
+    }
+    return copied;
+}
+
+// Compute the non-zero block bitmap of a model for zero-block skipping: bit a of nz[a / 32] is
+// set when J memory word a (rows a * PARALLELISM to a * PARALLELISM + PARALLELISM - 1 of a J image
+// in the layout of gen_model_data.py with j_bits-bit elements) or the h of its spins (h_rdata
+// layout) is non-zero. At least one bit is always set.
+static void lagd_compute_j_nz_bitmap(const volatile uint64_t *j, unsigned j_bits, const uint32_t *h,
+                                     uint32_t *nz) {
+    const unsigned words_per_row = NUM_SPIN * j_bits / 64;
+    const uint32_t h_mask = (1u << BIT_H) - 1;
+    for (unsigned i = 0; i < NUM_SPIN / PARALLELISM / 32; i++) nz[i] = 0;
+    // row m of the image is spin vector bit NUM_SPIN - 1 - m
+    for (unsigned m = 0; m < NUM_SPIN; m++) {
+        unsigned a = m / PARALLELISM;
+        unsigned k = NUM_SPIN - 1 - m;
+        uint64_t row = (h[k * BIT_H / 32] >> (k * BIT_H % 32)) & h_mask;
+        for (unsigned w = 0; w < words_per_row; w++) row |= j[m * words_per_row + w];
+        if (row) nz[a / 32] |= 1u << (a % 32);
+    }
+    uint32_t any = 0;
+    for (unsigned i = 0; i < NUM_SPIN / PARALLELISM / 32; i++) any |= nz[i];
+    if (!any) nz[0] = 1;
+}
+
+// Write the non-zero block bitmap: with flip detection, the J memory words whose bit is cleared
+// are not read by the energy evaluations, which then take one cycle per flipped non-zero block.
+// The bitmap must be rewritten whenever J or h changes (all ones disables the skipping).
+static void lagd_load_j_nz_bitmap(unsigned core, const uint32_t *nz) {
+    for (unsigned i = 0; i < NUM_SPIN / PARALLELISM / 32; i++)
+        lagd_write_j_nz_bitmap(core, i, nz[i]);
+}
+
+// Reset the final-energy histogram and enable it: bin b counts the final energies in
+// [base + b * 2^shift, base + (b + 1) * 2^shift), b < num_bins (at most the HIST_BINS bins of the
+// hardware). Every final energy of all following computations is binned, including the restarts
+// of multi_cmpt_mode, so the statistics of a whole campaign are read out once.
+static void lagd_enable_hist(unsigned core, int32_t base, unsigned shift, unsigned num_bins) {
+    lagd_stage_hist_cfg_hist_en(core, 0);
+    lagd_stage_hist_cfg_hist_clear(core, 1);
+    lagd_stage_hist_cfg_hist_shift(core, shift);
+    lagd_stage_hist_cfg_hist_num_bins(core, num_bins);
+    lagd_commit_hist_cfg(core);
+    lagd_write_hist_base(core, (uint32_t)base);
+    lagd_stage_hist_cfg_hist_clear(core, 0);
+    lagd_stage_hist_cfg_hist_en(core, 1);
+    lagd_commit_hist_cfg(core);
+}
+
+// Stop binning final energies (the counts are kept)
+static void lagd_disable_hist(unsigned core) {
+    lagd_write_hist_cfg_hist_en(core, 0);
+}
+
+// Read the first num_bins bins of the histogram into cnt, and the number of final energies
+// below the first and above the last bin into *under and *over. Returns the total count.
+static uint32_t lagd_read_hist(unsigned core, uint32_t *cnt, unsigned num_bins, uint32_t *under,
+                               uint32_t *over) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    *under = *reg32(base, LAGD_CORE_HIST_UNDER_REG_OFFSET);
+    *over = *reg32(base, LAGD_CORE_HIST_OVER_REG_OFFSET);
+    uint32_t total = *under + *over;
+    for (unsigned b = 0; b < num_bins; b++) {
+        lagd_write_hist_cfg_hist_rd_idx(core, b);
+        cnt[b] = *reg32(base, LAGD_CORE_HIST_COUNT_REG_OFFSET);
+        total += cnt[b];
+    }
+    return total;
+}
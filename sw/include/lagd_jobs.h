@@ -0,0 +1,247 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Header-only job streaming from a corpus in far memory (e.g. external DRAM).
+//
+// The corpus is an array of job records, stride = sizeof(lagd_job_hdr_t) + j_bytes bytes apart:
+//
+//   | lagd_job_hdr_t (job id, h_rdata words, SPIN_DEPTH initial spin vectors) | J image |
+//
+// where the J image is in the layout of gen_model_data.py (j_bytes = 0: no J image, the jobs
+// reuse the J that is already in the L1 J memory, e.g. for multi-start or h sweeps). One result
+// record (lagd_job_result_t) per job is written back to a result array in far memory.
+//
+// The corpus is read as a stream of LAGD_JOBS_CHUNK_B-byte chunks through a ring of chunks in L2:
+// - lagd_jobs_prefetch fetches the next chunks into the free ring slots with the DMA,
+// - lagd_jobs_stage takes a job from the ring: the header is copied by the CVA6, the J image is
+//   copied by the DMA into a J memory bank of the core, and consumed chunks are released,
+// - lagd_jobs_retire copies the best spin vector of the energy FIFO into one of two result
+//   buffers and writes it back with the DMA behind the next computation.
+// lagd_jobs_run chains these on a core and keeps prefetching while the core computes. With
+// L1_NUM_BUFFERS = 2 the J image of the next job is staged into the shadow J bank during the
+// computation; otherwise it is staged between two computations (from L2, so no far memory
+// latency is exposed).
+//
+// The DMA is the Cheshire iDMA (dif/dma.h): sys_dma_memcpy returns the id of the transfer and the
+// done register holds the id of the last finished one. Define LAGD_JOBS_DMA=0 to copy with the
+// CVA6 instead.
+
+#pragma once
+
+#include "lagd_common.h"
+
+#ifndef LAGD_JOBS_DMA
+#define LAGD_JOBS_DMA 1
+#endif
+
+#if LAGD_JOBS_DMA
+#include "dif/dma.h"
+#endif
+
+// Chunk size of the L2 ring (multiple of 64 bytes)
+#ifndef LAGD_JOBS_CHUNK_B
+#define LAGD_JOBS_CHUNK_B 4096
+#endif
+
+#define LAGD_JOBS_MAX_CHUNKS 16 // max chunks of the L2 ring
+
+typedef struct {
+    uint32_t job_id;                          // returned in the result record
+    uint32_t rsvd;                            // reserved (0)
+    uint32_t h[NUM_SPIN * BIT_H / 32];        // h_rdata words
+    uint32_t spin[SPIN_DEPTH][NUM_SPIN / 32]; // initial spin vectors of the spin FIFO slots
+} __attribute__((aligned(64))) lagd_job_hdr_t;
+
+typedef struct {
+    uint32_t job_id;              // job_id of the job header
+    int32_t energy;               // lowest energy of the energy FIFO
+    uint32_t spin[NUM_SPIN / 32]; // spin vector of energy
+} __attribute__((aligned(8))) lagd_job_result_t;
+
+typedef struct {
+    uintptr_t corpus;                        // first job record
+    uintptr_t results;                       // first result record
+    unsigned num_jobs;                       // number of jobs of the corpus
+    unsigned j_bytes;                        // J image bytes per job record (0: J is reused)
+    unsigned stride;                         // bytes per job record
+    uint8_t *ring;                           // L2 ring, num_chunks * LAGD_JOBS_CHUNK_B bytes
+    unsigned num_chunks;                     // 2 to LAGD_JOBS_MAX_CHUNKS
+    uint32_t total;                          // chunks of the corpus
+    uint32_t issued;                         // chunks fetched into the ring so far
+    uint32_t released;                       // chunks fully consumed so far
+    uint64_t chunk_id[LAGD_JOBS_MAX_CHUNKS]; // transfer id of the fetch of each ring slot
+    lagd_job_result_t res[2];                // result write-back buffers
+    uint64_t res_id[2];                      // transfer id of the write-back of each buffer
+} lagd_jobs_t;
+
+// Start a copy of size bytes (multiple of 8) and return its transfer id
+static inline uint64_t lagd_jobs_copy(uintptr_t dst, uintptr_t src, size_t size) {
+#if LAGD_JOBS_DMA
+    fence();
+    return sys_dma_memcpy(dst, src, size);
+#else
+    for (size_t i = 0; i < size / 8; i++)
+        ((volatile uint64_t *)dst)[i] = ((volatile uint64_t *)src)[i];
+    return 0;
+#endif
+}
+
+// Check whether the copy with transfer id is done
+static inline int lagd_jobs_copy_done(uint64_t id) {
+#if LAGD_JOBS_DMA
+    return *sys_dma_done_ptr() >= id;
+#else
+    return 1;
+#endif
+}
+
+// Wait for the copy with transfer id
+static inline void lagd_jobs_copy_wait(uint64_t id) {
+    while (!lagd_jobs_copy_done(id))
+        ;
+    fence();
+}
+
+// Set up a job stream over num_jobs job records at corpus, with a ring of num_chunks chunks at
+// ring (64-byte aligned, in L2). The results are written to num_jobs result records at results.
+static void lagd_jobs_init(lagd_jobs_t *q, uintptr_t corpus, uintptr_t results, unsigned num_jobs,
+                           unsigned j_bytes, uint8_t *ring, unsigned num_chunks) {
+    q->corpus = corpus;
+    q->results = results;
+    q->num_jobs = num_jobs;
+    q->j_bytes = j_bytes;
+    q->stride = sizeof(lagd_job_hdr_t) + j_bytes;
+    q->ring = ring;
+    q->num_chunks = num_chunks;
+    q->total = (num_jobs * q->stride + LAGD_JOBS_CHUNK_B - 1) / LAGD_JOBS_CHUNK_B;
+    q->issued = 0;
+    q->released = 0;
+    q->res_id[0] = q->res_id[1] = 0;
+}
+
+// Fetch the next chunks of the corpus into the free ring slots; returns the number of chunks
+static unsigned lagd_jobs_prefetch(lagd_jobs_t *q) {
+    const uint32_t bytes = q->num_jobs * q->stride;
+    unsigned fetched = 0;
+    while (q->issued < q->total && q->issued - q->released < q->num_chunks) {
+        uint32_t g = q->issued;
+        uint32_t size = bytes - g * LAGD_JOBS_CHUNK_B;
+        if (size > LAGD_JOBS_CHUNK_B) size = LAGD_JOBS_CHUNK_B;
+        q->chunk_id[g % q->num_chunks] =
+            lagd_jobs_copy((uintptr_t)(q->ring + (g % q->num_chunks) * LAGD_JOBS_CHUNK_B),
+                           q->corpus + (uintptr_t)g * LAGD_JOBS_CHUNK_B, size);
+        q->issued++;
+        fetched++;
+    }
+    return fetched;
+}
+
+// Take job n from the ring (jobs are taken in order): copy its header to hdr and its J image into
+// J memory bank of core. Returns when the J image is in place.
+static void lagd_jobs_stage(lagd_jobs_t *q, unsigned n, unsigned core, unsigned bank,
+                            lagd_job_hdr_t *hdr) {
+    const uint32_t start = n * q->stride;
+    const uint32_t end = start + q->stride;
+    const uint32_t hdr_end = start + sizeof(lagd_job_hdr_t);
+    const uintptr_t j_dst = lagd_l1_j_mem_addr(core, bank);
+    uint64_t j_id = 0;
+    for (uint32_t g = start / LAGD_JOBS_CHUNK_B; g * LAGD_JOBS_CHUNK_B < end; g++) {
+        uint8_t *slot = q->ring + (g % q->num_chunks) * LAGD_JOBS_CHUNK_B;
+        uint32_t a = g * LAGD_JOBS_CHUNK_B > start ? g * LAGD_JOBS_CHUNK_B : start;
+        uint32_t b = (g + 1) * LAGD_JOBS_CHUNK_B < end ? (g + 1) * LAGD_JOBS_CHUNK_B : end;
+        while (q->issued <= g) lagd_jobs_prefetch(q);
+        lagd_jobs_copy_wait(q->chunk_id[g % q->num_chunks]);
+        // header part
+        for (uint32_t i = a; i < b && i < hdr_end; i++)
+            ((uint8_t *)hdr)[i - start] = slot[i - g * LAGD_JOBS_CHUNK_B];
+        // J image part
+        if (b > hdr_end) {
+            uint32_t ja = a > hdr_end ? a : hdr_end;
+            uintptr_t src = (uintptr_t)(slot + (ja - g * LAGD_JOBS_CHUNK_B));
+            j_id = lagd_jobs_copy(j_dst + (ja - hdr_end), src, b - ja);
+        }
+        // release the chunk once it is consumed, and refill the ring
+        if (b == (g + 1) * LAGD_JOBS_CHUNK_B) {
+            lagd_jobs_copy_wait(j_id);
+            q->released = g + 1;
+            lagd_jobs_prefetch(q);
+        }
+    }
+    lagd_jobs_copy_wait(j_id);
+}
+
+// Start the computation of a staged job: select its J bank, load h and the initial spins, onload
+// and start. The energy monitor FIFO must be enabled.
+static void lagd_jobs_start(unsigned core, unsigned bank, const lagd_job_hdr_t *hdr) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    // leave the computation enable low so the computation gets a fresh start edge
+    lagd_write_global_cfg_2_cmpt_en(core, 0);
+    lagd_select_j_mem_bank(core, bank);
+    lagd_load_h_rdata(core, hdr->h);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        for (int j = 0; j < NUM_SPIN / 32; j++)
+            *reg32(base, lagd_config_spin_initial_offset[k] + 4 * j) = hdr->spin[k][j];
+    }
+    lagd_write_global_cfg_2_config_valid_fm(core, 1);
+    lagd_write_global_cfg_2_config_valid_fm(core, 0);
+    lagd_enable_analog_onloading(core);
+    lagd_wait_for_analog_onloading_done(core);
+    lagd_enable_computation(core);
+}
+
+// Check whether the computation of core is done
+static inline int lagd_jobs_core_idle(unsigned core) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    return (*reg32(base, LAGD_CORE_OUTPUT_STATUS_REG_OFFSET) >>
+            LAGD_CORE_OUTPUT_STATUS_CMPT_IDLE_BIT) & 0x1;
+}
+
+// Write the result of job n (lowest energy of the energy FIFO of core and its spin vector) back
+// to result record n
+static void lagd_jobs_retire(lagd_jobs_t *q, unsigned core, unsigned n, uint32_t job_id) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    lagd_job_result_t *r = &q->res[n % 2];
+    unsigned best = 0;
+    // the buffer is reused every other job
+    lagd_jobs_copy_wait(q->res_id[n % 2]);
+    r->energy = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[0]);
+    for (unsigned k = 1; k < SPIN_DEPTH; k++) {
+        int32_t e = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]);
+        if (e < r->energy) {
+            r->energy = e;
+            best = k;
+        }
+    }
+    for (int j = 0; j < NUM_SPIN / 32; j++)
+        r->spin[j] = *reg32(base, lagd_spin_fifo_data_offset[best] + 4 * j);
+    r->job_id = job_id;
+    q->res_id[n % 2] = lagd_jobs_copy(q->results + (uintptr_t)n * sizeof(lagd_job_result_t),
+                                      (uintptr_t)r, sizeof(lagd_job_result_t));
+}
+
+// Run all jobs of the stream on a core, configured as in lagd_scompute with the energy monitor
+// FIFO enabled (computation not started). Returns when all results are written back.
+static void lagd_jobs_run(lagd_jobs_t *q, unsigned core) {
+    static lagd_job_hdr_t hdr[2];
+    // the J images alternate between the banks when the next one can be staged meanwhile
+    const int swap = q->j_bytes && L1_NUM_BUFFERS > 1;
+    unsigned bank = lagd_get_j_mem_bank_active(core);
+    if (q->num_jobs == 0) return;
+    lagd_jobs_prefetch(q);
+    lagd_jobs_stage(q, 0, core, bank, &hdr[0]);
+    for (unsigned n = 0; n < q->num_jobs; n++) {
+        int next = n + 1 < q->num_jobs;
+        lagd_jobs_start(core, bank, &hdr[n % 2]);
+        if (next && swap) lagd_jobs_stage(q, n + 1, core, bank ^ 1, &hdr[(n + 1) % 2]);
+        // keep the ring filled while the core computes
+        while (!lagd_jobs_core_idle(core)) lagd_jobs_prefetch(q);
+        lagd_jobs_retire(q, core, n, hdr[n % 2].job_id);
+        if (next && !swap) lagd_jobs_stage(q, n + 1, core, bank, &hdr[(n + 1) % 2]);
+        if (swap) bank ^= 1;
+    }
+    lagd_jobs_copy_wait(q->res_id[0]);
+    lagd_jobs_copy_wait(q->res_id[1]);
+}
@@ -0,0 +1,144 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Header-only Lagrangian outer loop for constrained problems, run on the CVA6.
+//
+// The problem is H(s) (the onloaded J and the base bias h0) subject to linear constraints
+// a_k . s = b_k or a_k . s <= b_k, with s_i = +1 for spin bit 1 and -1 for spin bit 0. Between
+// the inner solves only the bias changes, so J is onloaded once and every outer step is:
+//   1. run the computation and read the lowest-energy spin vector of the energy FIFO,
+//   2. stop when every constraint holds, else update the multipliers with the violations
+//      g_k = a_k . s - b_k: lambda_k += step * g_k (inequality multipliers are kept >= 0),
+//   3. fold the multipliers into the bias, h_i = h0_i - round(sum_k lambda_k a_ki), saturated to
+//      BIT_H bits (HIsNegative = 1: H = -0.5 sum J s s - sum h s, so the core minimises
+//      H + sum_k lambda_k (a_k . s - b_k)),
+//   4. rewrite h_rdata, re-program only the h row (lagd_enable_h_onloading) and restart from the
+//      best spin vector.
+// Multipliers and the step are fixed point with LAGD_LAGRANGE_FRAC fractional bits.
+
+#pragma once
+
+#include "lagd_common.h"
+
+#ifndef LAGD_LAGRANGE_FRAC
+#define LAGD_LAGRANGE_FRAC 8
+#endif
+
+typedef struct {
+    unsigned num_con;    // number of constraints
+    const int8_t *a;     // num_con x NUM_SPIN coefficients, row major
+    const int32_t *b;    // num_con right-hand sides
+    const uint8_t *ineq; // per constraint, 1 for a_k . s <= b_k (NULL: all equalities)
+    const uint32_t *h0;  // base bias in the h_rdata layout (e.g. model_h_data)
+    int32_t step;        // multiplier step size
+    int32_t *lambda;     // num_con multipliers, in/out
+    int32_t *viol;       // num_con violations of the last best spin vector, out
+} lagd_lagrange_t;
+
+// Spin i of a spin vector as +1/-1
+static inline int lagd_spin_sign(const uint32_t *spin, unsigned i) {
+    return ((spin[i / 32] >> (i % 32)) & 1) ? 1 : -1;
+}
+
+// Read the lowest-energy spin vector of the energy FIFO into spin and return its energy
+static int32_t lagd_read_best_spin(unsigned core, uint32_t *spin) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    unsigned best = 0;
+    int32_t best_energy = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[0]);
+    for (unsigned k = 1; k < SPIN_DEPTH; k++) {
+        int32_t e = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]);
+        if (e < best_energy) {
+            best_energy = e;
+            best = k;
+        }
+    }
+    for (int j = 0; j < NUM_SPIN / 32; j++)
+        spin[j] = *reg32(base, lagd_spin_fifo_data_offset[best] + 4 * j);
+    return best_energy;
+}
+
+// Compute the violations of spin into p->viol and return the number of violated constraints
+static unsigned lagd_lagrange_violations(const lagd_lagrange_t *p, const uint32_t *spin) {
+    unsigned num = 0;
+    for (unsigned k = 0; k < p->num_con; k++) {
+        const int8_t *a = &p->a[k * NUM_SPIN];
+        int32_t g = -p->b[k];
+        for (unsigned i = 0; i < NUM_SPIN; i++) g += a[i] * lagd_spin_sign(spin, i);
+        p->viol[k] = g;
+        if (g > 0 || (g < 0 && !(p->ineq && p->ineq[k]))) num++;
+    }
+    return num;
+}
+
+// Subgradient step of the multipliers with the last violations
+static void lagd_lagrange_update(const lagd_lagrange_t *p) {
+    for (unsigned k = 0; k < p->num_con; k++) {
+        int32_t l = p->lambda[k] + p->step * p->viol[k];
+        if (p->ineq && p->ineq[k] && l < 0) l = 0;
+        p->lambda[k] = l;
+    }
+}
+
+// Fold the multipliers into the bias: h = h0 - round(sum_k lambda_k a_k), saturated
+static void lagd_lagrange_build_h(const lagd_lagrange_t *p, uint32_t *h) {
+    const int32_t h_max = (1 << (BIT_H - 1)) - 1;
+    const int32_t h_min = -(1 << (BIT_H - 1));
+    const unsigned per_word = 32 / BIT_H;
+    for (unsigned w = 0; w < NUM_SPIN * BIT_H / 32; w++) h[w] = 0;
+    for (unsigned i = 0; i < NUM_SPIN; i++) {
+        unsigned shift = (i % per_word) * BIT_H;
+        // sign-extend h0_i
+        int32_t v = (int32_t)(p->h0[i / per_word] << (32 - BIT_H - shift)) >> (32 - BIT_H);
+        int32_t acc = 0;
+        for (unsigned k = 0; k < p->num_con; k++) acc += p->lambda[k] * p->a[k * NUM_SPIN + i];
+        v -= (acc + (1 << (LAGD_LAGRANGE_FRAC - 1))) >> LAGD_LAGRANGE_FRAC;
+        if (v > h_max) v = h_max;
+        if (v < h_min) v = h_min;
+        h[i / per_word] |= ((uint32_t)v & ((1u << BIT_H) - 1)) << shift;
+    }
+}
+
+// Load spin as the initial value of every spin FIFO slot (this also resets the energy FIFO)
+static void lagd_lagrange_reload_spins(unsigned core, const uint32_t *spin) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        for (int j = 0; j < NUM_SPIN / 32; j++)
+            *reg32(base, lagd_config_spin_initial_offset[k] + 4 * j) = spin[j];
+    }
+    lagd_write_global_cfg_2_config_valid_fm(core, 1);
+    lagd_write_global_cfg_2_config_valid_fm(core, 0);
+}
+
+// Run at most max_iter inner solves of the outer loop on a core with J/h onloaded, the initial
+// spins configured and the energy monitor FIFO enabled (computation not started yet). The
+// multipliers start from p->lambda. On return, best holds the last best spin vector and
+// *num_viol its number of violated constraints (0: feasible).
+// Returns the number of inner solves.
+static unsigned lagd_lagrange_run(unsigned core, const lagd_lagrange_t *p, unsigned max_iter,
+                                  uint32_t *best, unsigned *num_viol) {
+    static uint32_t h[NUM_SPIN * BIT_H / 32];
+    unsigned iter = 0;
+    *num_viol = 0;
+    while (iter < max_iter) {
+        // inner solve
+        lagd_enable_computation(core);
+        lagd_wait_for_computation_done(core);
+        // leave the computation enable low so the next solve gets a fresh start edge
+        lagd_write_global_cfg_2_cmpt_en(core, 0);
+        iter++;
+        lagd_read_best_spin(core, best);
+        *num_viol = lagd_lagrange_violations(p, best);
+        if (*num_viol == 0 || iter == max_iter) break;
+        // multiplier update and h-only re-onloading
+        lagd_lagrange_update(p);
+        lagd_lagrange_build_h(p, h);
+        lagd_load_h_rdata(core, h);
+        lagd_lagrange_reload_spins(core, best);
+        lagd_enable_h_onloading(core);
+        lagd_wait_for_analog_onloading_done(core);
+    }
+    return iter;
+}
@@ -0,0 +1,222 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Header-only software annealing worker, run on the CVA6.
+//
+// The worker solves the same job as an Ising core: the packed J image of gen_model_data.py (e.g.
+// model_j_data or the L1 J memory of a core, j_bits-bit elements), h in the h_rdata layout (e.g.
+// model_h_data), the h scaling factor and an initial spin vector. Its energies follow the energy
+// monitor (HIsNegative = 1), so they compare directly with the energy FIFO:
+//   E(s) = -sum_i s_i (sum_j J_ij s_j + 2 * hscaling * h_i), s_i = +1 for spin bit 1, -1 for 0,
+// where row/column m of the J image is spin vector bit NUM_SPIN - 1 - m.
+//
+// Moves are single spin flips. The worker keeps the local fields
+//   f_k = sum_{j != k} (J_kj + J_jk) s_j + 2 * hscaling * h_k,
+// so flipping spin k changes the energy by 2 s_k f_k, and a flip costs one J row and one J column.
+// Two searches are provided:
+// - lagd_soft_anneal: random single-flip proposals with the acceptance rules of the cores
+//   (greedy, threshold accepting or Metropolis with the same -ln u table, temperature schedule and
+//   xorshift32 RNG as acceptance_ctrl, see lagd_configure_acceptance),
+// - lagd_soft_tabu: tabu search, every step flips the best non-tabu spin (a tabu spin is allowed
+//   when it gives a new best energy). With tenure 0 it is a steepest descent to a local minimum,
+//   which polishes a hardware solution before it is reported.
+// Both can run while a core computes (lagd_soft_anneal_while_busy), so the host is an extra worker
+// instead of polling lagd_wait_for_computation_done.
+
+#pragma once
+
+#include "lagd_common.h"
+
+// Search mode of lagd_soft_cfg_t, next to the acceptance rules LAGD_ACCEPT_*
+#define LAGD_SOFT_TABU 3
+
+typedef struct {
+    const volatile uint64_t *j; // J image, gen_model_data.py layout
+    unsigned j_bits;            // bits per J element
+    const uint32_t *h;          // h in the h_rdata layout (BIT_H bits per element)
+    unsigned hscaling;          // h scaling factor (GCFG2_DGT_HSCALING)
+} lagd_soft_model_t;
+
+typedef struct {
+    unsigned mode;        // LAGD_ACCEPT_GREEDY/THRESHOLD/METROPOLIS or LAGD_SOFT_TABU
+    uint16_t t_start;     // acceptance: start temperature (energy units)
+    uint16_t t_min;       // acceptance: minimum temperature
+    unsigned decay_shift; // acceptance: T -= T >> decay_shift every interval steps (0: constant)
+    uint16_t interval;    // acceptance: steps between two cooling steps
+    uint32_t seed;        // acceptance: RNG seed (0 is replaced by 1)
+    unsigned tenure;      // tabu: number of steps a flipped spin stays tabu
+    unsigned steps;       // number of steps (flip proposals, or flips for tabu)
+} lagd_soft_cfg_t;
+
+typedef struct {
+    int32_t field[NUM_SPIN];      // local fields f_k of spin
+    uint32_t spin[NUM_SPIN / 32]; // current spin vector
+    uint32_t best[NUM_SPIN / 32]; // lowest-energy spin vector so far
+    int32_t energy;               // energy of spin
+    int32_t best_energy;          // energy of best
+    uint32_t rng;                 // RNG state
+    uint16_t temp;                // current temperature
+    uint16_t step_cnt;            // steps since the last cooling step
+} lagd_soft_state_t;
+
+// round(-ln((k + 0.5) / 64) * 32), as in acceptance_ctrl
+static const uint8_t lagd_soft_neg_ln[64] = {
+    155, 120, 104, 93, 85, 79, 73, 69, 65, 61, 58, 55, 52, 50, 48, 45,
+    43,  41,  40,  38, 36, 35, 33, 32, 31, 29, 28, 27, 26, 25, 24, 23,
+    22,  21,  20,  19, 18, 17, 16, 15, 15, 14, 13, 12, 12, 11, 10, 10,
+    9,   8,   8,   7,  6,  6,  5,  5,  4,  3,  3,  2,  2,  1,  1,  0,
+};
+
+// J_kl of the model (k, l: spin vector bits), sign-extended
+static inline int32_t lagd_soft_j(const lagd_soft_model_t *m, unsigned k, unsigned l) {
+    const unsigned words_per_row = NUM_SPIN * m->j_bits / 64;
+    // in the 64-bit words of a row, spin bit l is element l from the LSB of the row
+    unsigned bit = l * m->j_bits;
+    uint64_t w = m->j[(NUM_SPIN - 1 - k) * words_per_row + bit / 64] >> (bit % 64);
+    return (int32_t)((int64_t)(w << (64 - m->j_bits)) >> (64 - m->j_bits));
+}
+
+// h_k of the model, sign-extended
+static inline int32_t lagd_soft_h(const lagd_soft_model_t *m, unsigned k) {
+    unsigned bit = k * BIT_H;
+    return (int32_t)(m->h[bit / 32] << (32 - BIT_H - bit % 32)) >> (32 - BIT_H);
+}
+
+static inline int lagd_soft_sign(const uint32_t *spin, unsigned i) {
+    return ((spin[i / 32] >> (i % 32)) & 1) ? 1 : -1;
+}
+
+// Energy of a spin vector, as computed by the energy monitor
+static int32_t lagd_soft_energy(const lagd_soft_model_t *m, const uint32_t *spin) {
+    int32_t e = 0;
+    for (unsigned i = 0; i < NUM_SPIN; i++) {
+        int32_t local = 2 * (int32_t)m->hscaling * lagd_soft_h(m, i);
+        for (unsigned j = 0; j < NUM_SPIN; j++)
+            local += lagd_soft_j(m, i, j) * lagd_soft_sign(spin, j);
+        e += lagd_soft_sign(spin, i) * local;
+    }
+    return -e;
+}
+
+// Start a search from spin: compute the local fields and the energy
+static void lagd_soft_init(const lagd_soft_model_t *m, const lagd_soft_cfg_t *cfg,
+                           lagd_soft_state_t *st, const uint32_t *spin) {
+    for (int j = 0; j < NUM_SPIN / 32; j++) st->spin[j] = st->best[j] = spin[j];
+    for (unsigned k = 0; k < NUM_SPIN; k++) {
+        int32_t f = 2 * (int32_t)m->hscaling * lagd_soft_h(m, k);
+        for (unsigned j = 0; j < NUM_SPIN; j++) {
+            if (j != k)
+                f += (lagd_soft_j(m, k, j) + lagd_soft_j(m, j, k)) * lagd_soft_sign(spin, j);
+        }
+        st->field[k] = f;
+    }
+    st->energy = st->best_energy = lagd_soft_energy(m, spin);
+    st->rng = cfg->seed ? cfg->seed : 1;
+    st->temp = cfg->t_start;
+    st->step_cnt = 0;
+}
+
+// Flip spin k and update the energy, the local fields and the best solution
+static void lagd_soft_flip(const lagd_soft_model_t *m, lagd_soft_state_t *st, unsigned k) {
+    int s_old = lagd_soft_sign(st->spin, k);
+    st->energy += 2 * s_old * st->field[k];
+    st->spin[k / 32] ^= 1u << (k % 32);
+    for (unsigned l = 0; l < NUM_SPIN; l++) {
+        if (l != k) st->field[l] -= 2 * s_old * (lagd_soft_j(m, l, k) + lagd_soft_j(m, k, l));
+    }
+    if (st->energy < st->best_energy) {
+        st->best_energy = st->energy;
+        for (int j = 0; j < NUM_SPIN / 32; j++) st->best[j] = st->spin[j];
+    }
+}
+
+// Advance the xorshift32 RNG
+static inline uint32_t lagd_soft_rng(lagd_soft_state_t *st) {
+    uint32_t x = st->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    st->rng = x;
+    return x;
+}
+
+// Run cfg->steps random single-flip proposals with the acceptance rule cfg->mode (a proposal is
+// accepted when its energy change is below the threshold of acceptance_ctrl)
+static void lagd_soft_anneal(const lagd_soft_model_t *m, const lagd_soft_cfg_t *cfg,
+                             lagd_soft_state_t *st) {
+    for (unsigned n = 0; n < cfg->steps; n++) {
+        uint32_t r = lagd_soft_rng(st);
+        unsigned k = r % NUM_SPIN;
+        int32_t delta = 2 * lagd_soft_sign(st->spin, k) * st->field[k];
+        int32_t thr = 0;
+        if (cfg->mode == LAGD_ACCEPT_THRESHOLD) thr = st->temp;
+        if (cfg->mode == LAGD_ACCEPT_METROPOLIS) thr = (st->temp * lagd_soft_neg_ln[r >> 26]) >> 5;
+        if (delta < thr) lagd_soft_flip(m, st, k);
+        // cooling schedule
+        if (cfg->decay_shift && ++st->step_cnt >= cfg->interval) {
+            uint16_t t = st->temp - (st->temp >> cfg->decay_shift);
+            st->temp = t < cfg->t_min ? cfg->t_min : t;
+            st->step_cnt = 0;
+        }
+    }
+}
+
+// Run at most cfg->steps tabu search steps; returns the number of flips. A step flips the spin
+// with the lowest energy change among the non-tabu ones (or any spin giving a new best energy).
+// With cfg->tenure = 0 the search stops at the first local minimum.
+static unsigned lagd_soft_tabu(const lagd_soft_model_t *m, const lagd_soft_cfg_t *cfg,
+                               lagd_soft_state_t *st) {
+    static uint32_t tabu_until[NUM_SPIN];
+    unsigned n;
+    for (unsigned k = 0; k < NUM_SPIN; k++) tabu_until[k] = 0;
+    for (n = 0; n < cfg->steps; n++) {
+        unsigned best_k = NUM_SPIN;
+        int32_t best_delta = INT32_MAX;
+        for (unsigned k = 0; k < NUM_SPIN; k++) {
+            int32_t delta = 2 * lagd_soft_sign(st->spin, k) * st->field[k];
+            int aspiration = st->energy + delta < st->best_energy;
+            if ((tabu_until[k] <= n || aspiration) && delta < best_delta) {
+                best_delta = delta;
+                best_k = k;
+            }
+        }
+        if (best_k == NUM_SPIN || (cfg->tenure == 0 && best_delta >= 0)) break;
+        lagd_soft_flip(m, st, best_k);
+        tabu_until[best_k] = n + 1 + cfg->tenure;
+    }
+    return n;
+}
+
+// Polish a spin vector (e.g. the best one of a core, lagd_read_best_spin) with a steepest descent
+// to the nearest local minimum; returns its energy
+static int32_t lagd_soft_polish(const lagd_soft_model_t *m, uint32_t *spin) {
+    static lagd_soft_state_t st;
+    lagd_soft_cfg_t cfg = {.mode = LAGD_SOFT_TABU, .tenure = 0, .steps = NUM_SPIN};
+    lagd_soft_init(m, &cfg, &st, spin);
+    lagd_soft_tabu(m, &cfg, &st);
+    for (int j = 0; j < NUM_SPIN / 32; j++) spin[j] = st.best[j];
+    return st.best_energy;
+}
+
+// Run the search in chunks of chunk steps until the computation of core is done (CMPT_IDLE), so
+// the CVA6 works on its own copy of a job instead of polling. Returns the number of chunks.
+static unsigned lagd_soft_anneal_while_busy(unsigned core, const lagd_soft_model_t *m,
+                                            const lagd_soft_cfg_t *cfg, lagd_soft_state_t *st,
+                                            unsigned chunk) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    lagd_soft_cfg_t c = *cfg;
+    unsigned chunks = 0;
+    c.steps = chunk;
+    do {
+        if (c.mode == LAGD_SOFT_TABU)
+            lagd_soft_tabu(m, &c, st);
+        else
+            lagd_soft_anneal(m, &c, st);
+        chunks++;
+    } while ((*reg32(base, LAGD_CORE_OUTPUT_STATUS_REG_OFFSET) &
+              (1 << LAGD_CORE_OUTPUT_STATUS_CMPT_IDLE_BIT)) == 0);
+    return chunks;
+}
@@ -0,0 +1,155 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Header-only binary result stream over the Cheshire UART.
+//
+// Instead of printf-formatting every sample, results are sent as framed binary records:
+//
+//   | 0xA5 | 0x5A | type | core | job_id[15:0] | len[15:0] | payload (len bytes) | crc16 |
+//
+// All multi-byte fields are little endian. crc16 is CRC-16/CCITT-FALSE (poly 0x1021, init
+// 0xFFFF) over type..payload. Register words are sent raw; field decoding is done on the host
+// by sw/utils/lagd_stream.py.
+//
+// For simulation transcripts (where the UART model prints line by line), define
+// LAGD_STREAM_HEX=1 so each frame is sent as one '@'-prefixed hex line instead.
+
+#pragma once
+
+#include "lagd_define.h"
+#include "lagd_core_reg.h"
+#include "util.h"
+#include "dif/uart.h"
+#include "params.h"
+
+#ifndef LAGD_STREAM_HEX
+#define LAGD_STREAM_HEX 0
+#endif
+
+// Frame constants (keep in sync with sw/utils/lagd_stream.py)
+#define LAGD_STREAM_SYNC_0 0xA5
+#define LAGD_STREAM_SYNC_1 0x5A
+#define LAGD_STREAM_MAX_WORDS 64 // max register words per log record
+
+// Record types
+#define LAGD_REC_ENERGY 0x01         // energy_fifo_data_0/1
+#define LAGD_REC_SPINS 0x02          // spin_fifo_data_0/1
+#define LAGD_REC_COUNTERS 0x03       // cmpt_idx, cycle_per_cmpt_and_iter, cycle_all_cmpt_lsb/msb
+#define LAGD_REC_CYCLE_LOG 0x04      // first sample idx + cycle_per_cmpt_and_iter samples
+#define LAGD_REC_ENERGY_DBG_LOG 0x05 // first sample idx + energy_fifo_dbg_0 samples
+#define LAGD_REC_END 0x0F            // end of job
+
+// Update CRC-16/CCITT-FALSE with one byte
+static inline uint16_t lagd_stream_crc16(uint16_t crc, uint8_t byte) {
+    crc ^= (uint16_t)byte << 8;
+    for (int i = 0; i < 8; i++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    return crc;
+}
+
+// Send one byte, either raw or as two hex digits
+static inline void lagd_stream_put(uint8_t byte) {
+    if (LAGD_STREAM_HEX) {
+        static const char hex[] = "0123456789abcdef";
+        uart_write(&__base_uart, hex[byte >> 4]);
+        uart_write(&__base_uart, hex[byte & 0xf]);
+    } else {
+        uart_write(&__base_uart, byte);
+    }
+}
+
+// Send one byte and accumulate it into the frame CRC
+static inline void lagd_stream_put_crc(uint16_t *crc, uint8_t byte) {
+    *crc = lagd_stream_crc16(*crc, byte);
+    lagd_stream_put(byte);
+}
+
+// Send one frame whose payload is an optional 16-bit header followed by 32-bit words
+static void lagd_stream_send(uint8_t type, unsigned core, uint16_t job_id, int has_hdr,
+                             uint16_t hdr, const uint32_t *words, unsigned num_words) {
+    uint16_t crc = 0xFFFF;
+    uint16_t len = (has_hdr ? 2 : 0) + 4 * num_words;
+    if (LAGD_STREAM_HEX) uart_write(&__base_uart, '@');
+    lagd_stream_put(LAGD_STREAM_SYNC_0);
+    lagd_stream_put(LAGD_STREAM_SYNC_1);
+    lagd_stream_put_crc(&crc, type);
+    lagd_stream_put_crc(&crc, (uint8_t)core);
+    lagd_stream_put_crc(&crc, job_id & 0xff);
+    lagd_stream_put_crc(&crc, job_id >> 8);
+    lagd_stream_put_crc(&crc, len & 0xff);
+    lagd_stream_put_crc(&crc, len >> 8);
+    if (has_hdr) {
+        lagd_stream_put_crc(&crc, hdr & 0xff);
+        lagd_stream_put_crc(&crc, hdr >> 8);
+    }
+    for (unsigned i = 0; i < num_words; i++) {
+        for (int b = 0; b < 4; b++) lagd_stream_put_crc(&crc, (words[i] >> (8 * b)) & 0xff);
+    }
+    lagd_stream_put(crc & 0xff);
+    lagd_stream_put(crc >> 8);
+    if (LAGD_STREAM_HEX) {
+        uart_write(&__base_uart, '\r');
+        uart_write(&__base_uart, '\n');
+    }
+}
+
+// Stream energy_fifo_data_0/1
+static void lagd_stream_energy_fifo_data(unsigned core, uint16_t job_id) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t words[2];
+    words[0] = *reg32(base, LAGD_CORE_ENERGY_FIFO_DATA_0_REG_OFFSET);
+    words[1] = *reg32(base, LAGD_CORE_ENERGY_FIFO_DATA_1_REG_OFFSET);
+    lagd_stream_send(LAGD_REC_ENERGY, core, job_id, 0, 0, words, 2);
+}
+
+// Stream spin_fifo_data_0/1 (word[0]=bits31:0 first)
+static void lagd_stream_spin_fifo_data(unsigned core, uint16_t job_id) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t words[2 * NUM_SPIN / 32];
+    for (int i = 0; i < NUM_SPIN / 32; i++) {
+        words[i] = *reg32(base, LAGD_CORE_SPIN_FIFO_DATA_0_0_REG_OFFSET + 4 * i);
+        words[NUM_SPIN / 32 + i] = *reg32(base, LAGD_CORE_SPIN_FIFO_DATA_1_0_REG_OFFSET + 4 * i);
+    }
+    lagd_stream_send(LAGD_REC_SPINS, core, job_id, 0, 0, words, 2 * NUM_SPIN / 32);
+}
+
+// Stream cmpt_idx and cycle performance counters
+static void lagd_stream_counters(unsigned core, uint16_t job_id) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint32_t words[4];
+    words[0] = *reg32(base, LAGD_CORE_CMPT_IDX_REG_OFFSET);
+    words[1] = *reg32(base, LAGD_CORE_CYCLE_PER_CMPT_AND_ITER_REG_OFFSET);
+    words[2] = *reg32(base, LAGD_CORE_CYCLE_ALL_CMPT_LSB_REG_OFFSET);
+    words[3] = *reg32(base, LAGD_CORE_CYCLE_ALL_CMPT_MSB_REG_OFFSET);
+    lagd_stream_send(LAGD_REC_COUNTERS, core, job_id, 0, 0, words, 4);
+}
+
+// Stream a sample log in chunks of LAGD_STREAM_MAX_WORDS, each tagged with its first index
+static void lagd_stream_log(uint8_t type, unsigned core, uint16_t job_id, unsigned sample_count,
+                            const uint32_t *log_buf) {
+    for (unsigned i = 0; i < sample_count; i += LAGD_STREAM_MAX_WORDS) {
+        unsigned n = sample_count - i;
+        if (n > LAGD_STREAM_MAX_WORDS) n = LAGD_STREAM_MAX_WORDS;
+        lagd_stream_send(type, core, job_id, 1, (uint16_t)i, &log_buf[i], n);
+    }
+}
+
+// Stream the cycle_per_cmpt_and_iter log from lagd_monitor_cycle_per_iteration
+static void lagd_stream_cycle_per_iteration(unsigned core, uint16_t job_id,
+                                            unsigned sample_count, const uint32_t *log_buf) {
+    lagd_stream_log(LAGD_REC_CYCLE_LOG, core, job_id, sample_count, log_buf);
+}
+
+// Stream the energy_fifo_dbg_0 log from lagd_monitor_energy_fifo_dbg_0
+static void lagd_stream_energy_fifo_dbg(unsigned core, uint16_t job_id, unsigned sample_count,
+                                        const uint32_t *e_log_buf) {
+    lagd_stream_log(LAGD_REC_ENERGY_DBG_LOG, core, job_id, sample_count, e_log_buf);
+}
+
+// Mark the end of a job and flush the UART
+static void lagd_stream_end(unsigned core, uint16_t job_id) {
+    lagd_stream_send(LAGD_REC_END, core, job_id, 0, 0, 0, 0);
+    uart_write_flush(&__base_uart);
+}
@@ -0,0 +1,135 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Header-only phase timing of a LAGD job with the CLINT mtime.
+//
+// LAGD_TIME_BEGIN(core, phase) / LAGD_TIME_END(core, phase) bracket the phases of a job (register
+// configuration, analog onloading, computation, readout). Each END appends one record (job,
+// core, phase, start, duration in mtime ticks) to a preallocated ring buffer of
+// LAGD_TIMING_RING records; the oldest records are overwritten when it is full. A mark costs
+// one mtime read and a few stores, nothing is printed until the end of the job:
+//   lagd_timing_report(rtc_freq)  count/min/mean/p99/max per core and phase, in us
+//   lagd_timing_dump(rtc_freq)    raw records as "TIMING" lines for sw/utils/lagd_timing.py
+// Timing is opt-in: with LAGD_TIMING=0 (default) the macros compile to nothing.
+
+#pragma once
+
+#include "lagd_define.h"
+#include "util.h"
+#include "printf.h"
+#include "dif/clint.h"
+
+#ifndef LAGD_TIMING
+#define LAGD_TIMING 0
+#endif
+
+// Number of records kept (power of two)
+#ifndef LAGD_TIMING_RING
+#define LAGD_TIMING_RING 256
+#endif
+
+// Phases of a job (keep in sync with PHASES in sw/utils/lagd_timing.py)
+enum {
+    LAGD_PHASE_CONFIG = 0,  // register configuration
+    LAGD_PHASE_ONLOAD = 1,  // analog onloading, until dt_cfg_idle
+    LAGD_PHASE_COMPUTE = 2, // computation, until cmpt_idle
+    LAGD_PHASE_READOUT = 3, // result readout and reporting
+    LAGD_NUM_PHASES
+};
+
+static const char *const lagd_phase_name[LAGD_NUM_PHASES] = {"config", "onload", "compute",
+                                                             "readout"};
+
+typedef struct {
+    uint32_t start; // mtime[31:0] at LAGD_TIME_BEGIN
+    uint32_t ticks; // duration in mtime ticks
+    uint16_t job;
+    uint8_t core;
+    uint8_t phase;
+} lagd_timing_rec_t;
+
+static lagd_timing_rec_t lagd_timing_ring[LAGD_TIMING_RING];
+static uint32_t lagd_timing_cnt;
+static uint16_t lagd_timing_job;
+static uint64_t lagd_timing_open[NUM_ISING_CORES][LAGD_NUM_PHASES];
+
+#if LAGD_TIMING
+#define LAGD_TIME_BEGIN(core, phase) lagd_timing_begin(core, phase)
+#define LAGD_TIME_END(core, phase) lagd_timing_end(core, phase)
+#else
+#define LAGD_TIME_BEGIN(core, phase) ((void)0)
+#define LAGD_TIME_END(core, phase) ((void)0)
+#endif
+
+// Tag the following records with a job id
+static inline void lagd_timing_set_job(uint16_t job) {
+    lagd_timing_job = job;
+}
+
+// Timestamp the start of a phase
+static inline void lagd_timing_begin(unsigned core, unsigned phase) {
+    lagd_timing_open[core][phase] = clint_get_mtime();
+}
+
+// Timestamp the end of a phase and record it
+static inline void lagd_timing_end(unsigned core, unsigned phase) {
+    uint64_t t = clint_get_mtime();
+    lagd_timing_rec_t *rec = &lagd_timing_ring[lagd_timing_cnt++ & (LAGD_TIMING_RING - 1)];
+    rec->start = (uint32_t)lagd_timing_open[core][phase];
+    rec->ticks = (uint32_t)(t - lagd_timing_open[core][phase]);
+    rec->job = lagd_timing_job;
+    rec->core = (uint8_t)core;
+    rec->phase = (uint8_t)phase;
+}
+
+// Number of records in the ring buffer
+static inline unsigned lagd_timing_num_records(void) {
+    return lagd_timing_cnt < LAGD_TIMING_RING ? lagd_timing_cnt : LAGD_TIMING_RING;
+}
+
+// Print count, min, mean, p99 and max of every core and phase, in us
+static void lagd_timing_report(uint32_t rtc_freq) {
+    static uint32_t sorted[LAGD_TIMING_RING];
+    unsigned num = lagd_timing_num_records();
+    printf("Phase timing (%u records, rtc %u Hz):\r\n", num, rtc_freq);
+    for (unsigned core = 0; core < NUM_ISING_CORES; core++) {
+        for (unsigned phase = 0; phase < LAGD_NUM_PHASES; phase++) {
+            // insertion sort of the durations of this core and phase
+            unsigned n = 0;
+            uint64_t sum = 0;
+            for (unsigned r = 0; r < num; r++) {
+                const lagd_timing_rec_t *rec = &lagd_timing_ring[r];
+                if (rec->core != core || rec->phase != phase) continue;
+                uint32_t d = rec->ticks;
+                unsigned i = n++;
+                for (; i > 0 && sorted[i - 1] > d; i--) sorted[i] = sorted[i - 1];
+                sorted[i] = d;
+                sum += d;
+            }
+            if (n == 0) continue;
+            unsigned p99 = (99 * n + 99) / 100 - 1;
+            printf("  core %u %-8s n %4u  min %8llu  mean %8llu  p99 %8llu  max %8llu us\r\n",
+                   core, lagd_phase_name[phase], n,
+                   (uint64_t)sorted[0] * 1000000ULL / rtc_freq,
+                   sum * 1000000ULL / rtc_freq / n,
+                   (uint64_t)sorted[p99] * 1000000ULL / rtc_freq,
+                   (uint64_t)sorted[n - 1] * 1000000ULL / rtc_freq);
+        }
+    }
+}
+
+// Print the raw records, oldest first, for sw/utils/lagd_timing.py
+// Format: "TIMING <job> <core> <phase> <start> <ticks>", preceded by "TIMING_RTC <rtc_freq>".
+static void lagd_timing_dump(uint32_t rtc_freq) {
+    unsigned num = lagd_timing_num_records();
+    unsigned first = lagd_timing_cnt - num;
+    printf("TIMING_RTC %u\r\n", rtc_freq);
+    for (unsigned i = 0; i < num; i++) {
+        const lagd_timing_rec_t *rec = &lagd_timing_ring[(first + i) & (LAGD_TIMING_RING - 1)];
+        printf("TIMING %u %u %s %u %u\r\n", rec->job, rec->core, lagd_phase_name[rec->phase],
+               rec->start, rec->ticks);
+    }
+}
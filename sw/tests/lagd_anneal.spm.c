@@ -0,0 +1,121 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Annealed acceptance: the computation of lagd_scompute is run three times from the same initial
+// spins: with the default acceptance (baseline), with LAGD_ACCEPT_GREEDY and the cooling schedule
+// below, and with the acceptance rule ACCEPT_MODE (default Metropolis) and a geometric cooling
+// schedule from ACCEPT_T_START down to ACCEPT_T_MIN. The greedy run must reproduce the final
+// energies of the baseline without accepting any uphill move. The ACCEPT_MODE run must accept at
+// least one uphill move, and its temperature must have stayed within [ACCEPT_T_MIN,
+// ACCEPT_T_START].
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// Acceptance rule and cooling schedule
+#ifndef ACCEPT_MODE
+#define ACCEPT_MODE LAGD_ACCEPT_METROPOLIS
+#endif
+#ifndef ACCEPT_T_START
+#define ACCEPT_T_START 256
+#endif
+#ifndef ACCEPT_T_MIN
+#define ACCEPT_T_MIN 1
+#endif
+#ifndef ACCEPT_DECAY_SHIFT
+#define ACCEPT_DECAY_SHIFT 3
+#endif
+#ifndef ACCEPT_INTERVAL
+#define ACCEPT_INTERVAL 4
+#endif
+#ifndef ACCEPT_SEED
+#define ACCEPT_SEED 0x1234567
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+// Run the computation from the initial spins and keep its energy FIFO
+static void lagd_anneal_run(unsigned core, int32_t *energy) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    lagd_configure_initial_spins(core);
+    lagd_write_global_cfg_2_config_valid_fm(core, 1);
+    lagd_write_global_cfg_2_config_valid_fm(core, 0);
+    lagd_enable_computation(core);
+    lagd_wait_for_computation_done(core);
+    lagd_write_global_cfg_2_cmpt_en(core, 0);
+    lagd_print_energy_fifo_data(core);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++)
+        energy[k] = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]);
+}
+
+int main(void) {
+    int32_t energy_base[SPIN_DEPTH], energy_greedy[SPIN_DEPTH], energy_anneal[SPIN_DEPTH];
+    unsigned errors = 0;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+
+    // baseline, then greedy with a cooling schedule, which must not change anything
+    lagd_anneal_run(CORE_TESTED, energy_base);
+    lagd_configure_acceptance(CORE_TESTED, LAGD_ACCEPT_GREEDY, ACCEPT_T_START, ACCEPT_T_MIN,
+                              ACCEPT_DECAY_SHIFT, ACCEPT_INTERVAL, ACCEPT_SEED);
+    lagd_anneal_run(CORE_TESTED, energy_greedy);
+    unsigned uphill_greedy = lagd_get_accept_uphill_cnt(CORE_TESTED);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) errors += energy_greedy[k] != energy_base[k];
+    errors += uphill_greedy != 0;
+
+    // annealed run
+    lagd_configure_acceptance(CORE_TESTED, ACCEPT_MODE, ACCEPT_T_START, ACCEPT_T_MIN,
+                              ACCEPT_DECAY_SHIFT, ACCEPT_INTERVAL, ACCEPT_SEED);
+    lagd_anneal_run(CORE_TESTED, energy_anneal);
+    uint16_t temp = lagd_get_accept_temp(CORE_TESTED);
+    unsigned uphill = lagd_get_accept_uphill_cnt(CORE_TESTED);
+    printf("Final temperature: %u, uphill moves accepted: %u (greedy: %u)\r\n", temp, uphill,
+           uphill_greedy);
+    errors += temp < ACCEPT_T_MIN || temp > ACCEPT_T_START;
+    if (ACCEPT_MODE != LAGD_ACCEPT_GREEDY) errors += uphill == 0;
+    if (errors) {
+        printf("Anneal check failed: %u errors\r\n", errors);
+    } else {
+        printf("Anneal check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
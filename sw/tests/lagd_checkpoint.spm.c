@@ -0,0 +1,91 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Checkpoint and resume: the computation is paused part-way, its state is saved to memory, and
+// the computation is resumed from the checkpoint. The final energies must match the ones of an
+// uninterrupted computation (lagd_scompute).
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// Number of register polls between the computation start and the pause
+#ifndef PAUSE_DELAY
+#define PAUSE_DELAY 256
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+int main(void) {
+    static lagd_checkpoint_t ckpt;
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)CORE_TESTED * IC_NUM_REGS);
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+
+    // start computation and pause it part-way
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    lagd_enable_computation(CORE_TESTED);
+    lagd_wait_for_computation_start(CORE_TESTED);
+    for (unsigned i = 0; i < PAUSE_DELAY; i++) (void)*reg32(base, LAGD_CORE_CMPT_IDX_REG_OFFSET);
+    lagd_pause_computation(CORE_TESTED);
+    lagd_save_checkpoint(CORE_TESTED, &ckpt);
+    printf("Paused at flip icon %u\r\n", ckpt.flip_raddr);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++)
+        printf("Checkpoint energy %u: 0x%08x\r\n", k, (uint32_t)ckpt.energies[k]);
+
+    // resume from the checkpoint (the analog macro keeps J, no onloading needed)
+    lagd_restore_checkpoint(CORE_TESTED, &ckpt);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    lagd_clear_config_valid(CORE_TESTED);
+    lagd_enable_computation(CORE_TESTED);
+    lagd_wait_for_computation_start(CORE_TESTED);
+    lagd_clear_resume(CORE_TESTED);
+    lagd_wait_for_computation_done(CORE_TESTED);
+
+    // print and check final output
+    lagd_print_energy_fifo_data(CORE_TESTED);
+    int fail = lagd_check_energy_fifo_data(CORE_TESTED);
+    if (fail) {
+        printf("Energy mismatch after resume\r\n");
+    } else {
+        printf("Energy match after resume\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return fail;
+}
@@ -0,0 +1,127 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// L1 double buffering (L1_NUM_BUFFERS = 2): the computation of lagd_scompute is run on bank 0 (the
+// bank filled by the ELF loader) as the single-buffer reference. It is then run again on bank 0
+// while the host copies the J image and the flip icons into the shadow bank 1. The J image and the
+// flip icons of bank 0 are cleared, the banks are swapped, and the computation is onloaded and run
+// from bank 1. Its energy FIFO must match the reference run.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+// Run the computation from the initial spins; when shadow is set, fill the shadow bank with the
+// J image and the flip icons of bank 0 meanwhile
+static void lagd_dbuf_run(unsigned core, int32_t *energy, int shadow) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    lagd_configure_initial_spins(core);
+    lagd_write_global_cfg_2_config_valid_fm(core, 1);
+    lagd_write_global_cfg_2_config_valid_fm(core, 0);
+    lagd_enable_computation(core);
+    if (shadow) {
+        volatile uint64_t *j0 = (volatile uint64_t *)lagd_l1_j_mem_addr(core, 0);
+        volatile uint64_t *j1 = (volatile uint64_t *)lagd_l1_j_mem_addr(core, 1);
+        volatile uint64_t *f0 = (volatile uint64_t *)lagd_l1_f_mem_addr(core, 0);
+        volatile uint64_t *f1 = (volatile uint64_t *)lagd_l1_f_mem_addr(core, 1);
+        for (unsigned i = 0; i < MODEL_J_LEN; i++) j1[i] = j0[i];
+        for (unsigned i = 0; i < MODEL_F_LEN; i++) f1[i] = f0[i];
+        fence();
+    }
+    lagd_wait_for_computation_done(core);
+    lagd_write_global_cfg_2_cmpt_en(core, 0);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++)
+        energy[k] = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]);
+}
+
+int main(void) {
+    int32_t energy_ref[SPIN_DEPTH], energy_bg[SPIN_DEPTH], energy_swap[SPIN_DEPTH];
+    unsigned errors = 0;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+#if L1_NUM_BUFFERS > 1
+    // register configuration, bank 0 for J and flip icons
+    lagd_select_j_mem_bank(CORE_TESTED, 0);
+    lagd_select_flip_mem_bank(CORE_TESTED, 0);
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+
+    // single-buffer reference, then the same run with the shadow bank filled meanwhile
+    lagd_dbuf_run(CORE_TESTED, energy_ref, 0);
+    lagd_dbuf_run(CORE_TESTED, energy_bg, 1);
+
+    // clear bank 0 so that a run still reading its J image or its flip icons cannot pass, then
+    // swap and onload from bank 1
+    volatile uint64_t *j0 = (volatile uint64_t *)lagd_l1_j_mem_addr(CORE_TESTED, 0);
+    volatile uint64_t *f0 = (volatile uint64_t *)lagd_l1_f_mem_addr(CORE_TESTED, 0);
+    for (unsigned i = 0; i < MODEL_J_LEN; i++) j0[i] = 0;
+    for (unsigned i = 0; i < MODEL_F_LEN; i++) f0[i] = 0;
+    fence();
+    lagd_select_j_mem_bank(CORE_TESTED, 1);
+    lagd_select_flip_mem_bank(CORE_TESTED, 1);
+    lagd_enable_analog_onloading(CORE_TESTED);
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+    lagd_dbuf_run(CORE_TESTED, energy_swap, 0);
+    lagd_print_energy_fifo_data(CORE_TESTED);
+
+    // check the active banks and the energies
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)CORE_TESTED * IC_NUM_REGS);
+    uint32_t status = *reg32(base, LAGD_CORE_OUTPUT_STATUS_REG_OFFSET);
+    errors += lagd_get_j_mem_bank_active(CORE_TESTED) != 1;
+    errors += ((status >> LAGD_CORE_OUTPUT_STATUS_FLIP_MEM_BANK_ACTIVE_BIT) & 0x1) != 1;
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        errors += energy_bg[k] != energy_ref[k];
+        errors += energy_swap[k] != energy_ref[k];
+    }
+    lagd_select_j_mem_bank(CORE_TESTED, 0);
+    lagd_select_flip_mem_bank(CORE_TESTED, 0);
+    if (errors) {
+        printf("Double buffering check failed: %u errors\r\n", errors);
+    } else {
+        printf("Double buffering check passed\r\n");
+    }
+#else
+    (void)energy_ref;
+    (void)energy_bg;
+    (void)energy_swap;
+    printf("Double buffering test skipped: build with L1_NUM_BUFFERS=2\r\n");
+#endif
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
@@ -7,6 +7,12 @@
 #define VERIFICATION_TEST 1
 #endif
 
+// Load the model of CORE_TESTED into the other cores with one write through the broadcast
+// aliases, instead of preloading a separate copy per core
+#ifndef BCAST_LOAD
+#define BCAST_LOAD 0
+#endif
+
 // cheshire headers
 #include "regs/cheshire.h"
 #include "dif/clint.h"
@@ -18,23 +24,34 @@
 // lagd headers
 #include "model_j_data.h"
 #include "model_f_data.h"
+#if !BCAST_LOAD
 #include "model_j_data_sec.h"
 #include "model_f_data_sec.h"
+#endif
 #include "lagd_reg_params.h"
 #include "lagd_common.h"
 #include "lagd_scompute.h"
+#include "lagd_timing.h"
 
 int main(void) {
     unsigned i;
     int fail = 0;
     // UART init
-    // uint64_t t0 = clint_get_mtime();
     uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
     uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
     uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
 
+    if (BCAST_LOAD) {
+        // copy the model of CORE_TESTED into all other cores at once
+        uint32_t others = ((1u << NUM_ISING_CORES) - 1) & ~(1u << CORE_TESTED);
+        lagd_select_bcast(others, others);
+        lagd_bcast_load_j_mem(0, model_j_data, MODEL_J_LEN);
+        lagd_bcast_load_f_mem(0, model_f_data, MODEL_F_LEN);
+    }
+
     // register configuration
     for (i = 0; i < NUM_ISING_CORES; i++) {
+        LAGD_TIME_BEGIN(i, LAGD_PHASE_CONFIG);
         lagd_configure_initial_spins(i);
         lagd_configure_cmpt_max_num(i);
         lagd_configure_counters(i);
@@ -47,22 +64,32 @@ int main(void) {
         lagd_configure_global_cfg_2(i);
         // clear config valid
         lagd_clear_config_valid(i);
+        LAGD_TIME_END(i, LAGD_PHASE_CONFIG);
     }
     for (i = 0; i < NUM_ISING_CORES; i++) {
         // start analog onloading
+        LAGD_TIME_BEGIN(i, LAGD_PHASE_ONLOAD);
         lagd_enable_analog_onloading(i);
         // wait for analog onloading to finish
         lagd_wait_for_analog_onloading_done(i);
+        LAGD_TIME_END(i, LAGD_PHASE_ONLOAD);
     }
 
     for (i = 0; i < NUM_ISING_CORES; i++) {
         // start computation
+        LAGD_TIME_BEGIN(i, LAGD_PHASE_COMPUTE);
         lagd_enable_energy_monitor_fifo(i);
         lagd_enable_computation(i);
     }
     for (i = 0; i < NUM_ISING_CORES; i++) {
         // wait for computation to finish
         lagd_wait_for_computation_done(i);
+        LAGD_TIME_END(i, LAGD_PHASE_COMPUTE);
+    }
+    if (LAGD_TIMING) {
+        // phase timing report and raw records (parse with sw/utils/lagd_timing.py)
+        lagd_timing_report(rtc_freq);
+        lagd_timing_dump(rtc_freq);
     }
     // check final output
     if (VERIFICATION_TEST) {
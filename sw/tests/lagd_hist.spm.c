@@ -0,0 +1,143 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Final-energy histogram: the multi-start campaign of lagd_restart is run with the histogram
+// enabled, and the histogram is read out once at the end. It must hold every final energy of the
+// campaign and match the histogram of the results stored by the restart queue.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+#ifndef NUM_RESTARTS
+#define NUM_RESTARTS 64
+#endif
+
+// Histogram: HIST_NUM_BINS bins of 2^HIST_SHIFT starting at HIST_BASE
+#ifndef HIST_BASE
+#define HIST_BASE (-16384)
+#endif
+#ifndef HIST_SHIFT
+#define HIST_SHIFT 10
+#endif
+#ifndef HIST_NUM_BINS
+#define HIST_NUM_BINS 32
+#endif
+
+// Flip memory layout: flip icons in [0, NUM_ICONS), then restart states, then results
+#ifndef NUM_ICONS
+#define NUM_ICONS 512
+#endif
+#define STATE_BASE NUM_ICONS
+#define RESULT_BASE (STATE_BASE + NUM_RESTARTS * SPIN_DEPTH)
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+int main(void) {
+    unsigned errors = 0;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+#if HIST_BINS >= HIST_NUM_BINS
+    uint64_t spins[SPIN_DEPTH * NUM_SPIN / 64];
+    int32_t energies[SPIN_DEPTH];
+    static uint32_t hist[HIST_NUM_BINS];
+    static uint32_t ref[HIST_NUM_BINS];
+    uint32_t under, over, ref_under = 0, ref_over = 0;
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+    // restart states
+    for (unsigned r = 0; r < NUM_RESTARTS; r++) {
+        for (unsigned i = 0; i < SPIN_DEPTH * NUM_SPIN / 64; i++) spins[i] = lagd_xorshift64(&seed);
+        lagd_write_restart_state(CORE_TESTED, STATE_BASE, r, spins);
+    }
+    lagd_configure_restart_queue(CORE_TESTED, STATE_BASE, RESULT_BASE);
+    lagd_enable_restart_queue(CORE_TESTED);
+
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_write_cmpt_max_num(CORE_TESTED, NUM_RESTARTS - 1);
+    lagd_write_counter_cfg_4_icon_last_raddr_plus_one(CORE_TESTED, NUM_ICONS);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+
+    // run the whole campaign with the histogram enabled
+    lagd_enable_hist(CORE_TESTED, HIST_BASE, HIST_SHIFT, HIST_NUM_BINS);
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    lagd_enable_computation_multi_cmpt_mode(CORE_TESTED);
+    lagd_wait_for_computation_multi_cmpt_mode_done(CORE_TESTED);
+    lagd_disable_hist(CORE_TESTED);
+
+    // one readout for the whole campaign
+    uint32_t total = lagd_read_hist(CORE_TESTED, hist, HIST_NUM_BINS, &under, &over);
+    printf("Histogram: %u final energies, %u below, %u above\r\n", total, under, over);
+    for (unsigned b = 0; b < HIST_NUM_BINS; b++) {
+        if (hist[b])
+            printf("  [%d, %d): %u\r\n", HIST_BASE + ((int32_t)b << HIST_SHIFT),
+                   HIST_BASE + ((int32_t)(b + 1) << HIST_SHIFT), hist[b]);
+    }
+
+    // reference histogram of the stored results
+    unsigned stored = lagd_get_restart_queue_store_cnt(CORE_TESTED);
+    for (unsigned r = 0; r < stored; r++) {
+        lagd_read_restart_result(CORE_TESTED, RESULT_BASE, r, spins, energies);
+        for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+            int64_t d = (int64_t)energies[k] - HIST_BASE;
+            if (d < 0)
+                ref_under++;
+            else if ((d >> HIST_SHIFT) >= HIST_NUM_BINS)
+                ref_over++;
+            else
+                ref[d >> HIST_SHIFT]++;
+        }
+    }
+    lagd_disable_restart_queue(CORE_TESTED);
+
+    errors = (stored != NUM_RESTARTS) + (total != stored * SPIN_DEPTH) +
+             (under != ref_under) + (over != ref_over);
+    for (unsigned b = 0; b < HIST_NUM_BINS; b++) errors += (hist[b] != ref[b]);
+    // an index past the last bin reads out 0 instead of aliasing to a bin
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)CORE_TESTED * IC_NUM_REGS);
+    lagd_write_hist_cfg_hist_rd_idx(CORE_TESTED, 0xff);
+    errors += (*reg32(base, LAGD_CORE_HIST_COUNT_REG_OFFSET) != 0);
+    if (errors) {
+        printf("Histogram check failed: %u errors\r\n", errors);
+    } else {
+        printf("Histogram check passed\r\n");
+    }
+#else
+    printf("Histogram test skipped: build with HIST_BINS >= %u\r\n", HIST_NUM_BINS);
+#endif
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// 2-bit J precision: model_j_data_2b is the model quantised and packed at 2 bits by
+// gen_model_data.py --j-bits 2 (placed in the J memory of the other core by the ELF loader). The
+// computation of lagd_scompute is run twice on the same couplings: first with the 2-bit image
+// widened to the 4-bit layout (j_precision_2b = 0), then with the 2-bit image itself
+// (j_precision_2b = 1). Both runs use the h and scaling factor of the 2-bit model, which follow
+// J when it had to be rescaled to fit 2 bits. Both runs must end with the same energy FIFO.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_j_data_2b.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+// Widen a 2-bit J image to the 4-bit layout (element e of a row sits at bit e * j_bits of the row)
+static void lagd_j2b_widen(volatile uint64_t *dst, const volatile uint64_t *src) {
+    for (unsigned r = 0; r < NUM_SPIN; r++) {
+        const volatile uint64_t *s = src + r * (NUM_SPIN * 2 / 64);
+        volatile uint64_t *d = dst + r * (NUM_SPIN * 4 / 64);
+        for (unsigned w = 0; w < NUM_SPIN * 4 / 64; w++) {
+            uint64_t word = 0;
+            for (unsigned t = 0; t < 16; t++) {
+                unsigned e = w * 16 + t;
+                uint64_t v = (s[e / 32] >> (e % 32 * 2)) & 0x3;
+                // sign-extend to 4 bits
+                word |= (v | ((v & 0x2) ? 0xc : 0x0)) << (t * 4);
+            }
+            d[w] = word;
+        }
+    }
+    fence();
+}
+
+// Onload J from the J memory of the core and run the computation, keep its energy FIFO
+static void lagd_j2b_run(unsigned core, unsigned precision_2b, int32_t *energy) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    lagd_write_global_cfg_2_j_precision_2b(core, precision_2b);
+    lagd_enable_analog_onloading(core);
+    lagd_wait_for_analog_onloading_done(core);
+    lagd_configure_initial_spins(core);
+    lagd_write_global_cfg_2_config_valid_fm(core, 1);
+    lagd_write_global_cfg_2_config_valid_fm(core, 0);
+    lagd_enable_computation(core);
+    lagd_wait_for_computation_done(core);
+    lagd_write_global_cfg_2_cmpt_en(core, 0);
+    lagd_print_energy_fifo_data(core);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++)
+        energy[k] = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]);
+}
+
+int main(void) {
+    int32_t energy_4b[SPIN_DEPTH], energy_2b[SPIN_DEPTH];
+    volatile uint64_t *j = (volatile uint64_t *)lagd_l1_j_mem_addr(CORE_TESTED, 0);
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // h term of the 2-bit model
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)CORE_TESTED * IC_NUM_REGS);
+    for (unsigned i = 0; i < MODEL_H_U32_LEN_2B; i++)
+        *reg32(base, LAGD_CORE_H_RDATA_0_REG_OFFSET + 4 * i) = model_h_data_2b[i];
+    lagd_write_global_cfg_2_dgt_hscaling(CORE_TESTED, model_scaling_factor_2b);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+
+    // 4-bit run on the widened 2-bit couplings
+    lagd_j2b_widen(j, model_j_data_2b);
+    lagd_j2b_run(CORE_TESTED, 0, energy_4b);
+
+    // 2-bit run on the packed image
+    for (unsigned i = 0; i < MODEL_J_LEN_2B; i++) j[i] = model_j_data_2b[i];
+    fence();
+    lagd_j2b_run(CORE_TESTED, 1, energy_2b);
+
+    // check the energies
+    unsigned errors = 0;
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) errors += energy_4b[k] != energy_2b[k];
+    if (errors) {
+        printf("2-bit J check failed: %u errors\r\n", errors);
+    } else {
+        printf("2-bit J check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
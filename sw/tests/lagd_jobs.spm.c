@@ -0,0 +1,114 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Job streaming: a corpus of NUM_JOBS jobs (job id, h and initial spins, J of model_j_data kept in
+// the L1 J memory) is streamed to the core through an L2 ring of RING_CHUNKS chunks by
+// lagd_jobs_run, and the results are written back to a result array. The corpus and the results
+// are placed at CORPUS_ADDR / RESULTS_ADDR when given (e.g. in DRAM), and in L2 otherwise. Every
+// result must carry the id of its job and an energy equal to the energy of its spin vector.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+#ifndef NUM_JOBS
+#define NUM_JOBS 8
+#endif
+
+// L2 ring: RING_CHUNKS chunks of LAGD_JOBS_CHUNK_B bytes
+#ifndef RING_CHUNKS
+#define RING_CHUNKS 2
+#endif
+#ifndef LAGD_JOBS_CHUNK_B
+#define LAGD_JOBS_CHUNK_B 512
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+#include "lagd_jobs.h"
+#include "lagd_soft.h"
+
+int main(void) {
+    static lagd_jobs_t q;
+    static uint8_t ring[RING_CHUNKS * LAGD_JOBS_CHUNK_B] __attribute__((aligned(64)));
+#ifdef CORPUS_ADDR
+    lagd_job_hdr_t *corpus = (lagd_job_hdr_t *)CORPUS_ADDR;
+    lagd_job_result_t *results = (lagd_job_result_t *)RESULTS_ADDR;
+#else
+    static lagd_job_hdr_t corpus[NUM_JOBS];
+    static lagd_job_result_t results[NUM_JOBS];
+#endif
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // corpus: job 0 starts from the initial spins of lagd_scompute, the others from random spins
+    for (unsigned n = 0; n < NUM_JOBS; n++) {
+        corpus[n].job_id = 0x100 + n;
+        corpus[n].rsvd = 0;
+        for (int i = 0; i < NUM_SPIN * BIT_H / 32; i++) corpus[n].h[i] = model_h_data[i];
+        for (int j = 0; j < NUM_SPIN / 32; j++) {
+            uint64_t r = lagd_xorshift64(&seed);
+            corpus[n].spin[0][j] = n ? (uint32_t)r : spin_initial_0[j];
+            corpus[n].spin[1][j] = n ? (uint32_t)(r >> 32) : spin_initial_1[j];
+        }
+    }
+    fence();
+
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+
+    // stream the jobs (each job is onloaded by lagd_jobs_start)
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    lagd_jobs_init(&q, (uintptr_t)corpus, (uintptr_t)results, NUM_JOBS, 0, ring, RING_CHUNKS);
+    lagd_jobs_run(&q, CORE_TESTED);
+
+    // check the results
+    const lagd_soft_model_t model = {
+        .j = model_j_data,
+        .j_bits = MODEL_J_BITS,
+        .h = model_h_data,
+        .hscaling = GCFG2_DGT_HSCALING,
+    };
+    unsigned errors = 0;
+    for (unsigned n = 0; n < NUM_JOBS; n++) {
+        printf("Job 0x%x: energy 0x%08x\r\n", results[n].job_id, (uint32_t)results[n].energy);
+        if (results[n].job_id != corpus[n].job_id) errors++;
+        if (lagd_soft_energy(&model, results[n].spin) != results[n].energy) errors++;
+    }
+    if (errors) {
+        printf("Job streaming check failed: %u errors\r\n", errors);
+    } else {
+        printf("Job streaming check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Lagrangian outer loop: the model of lagd_scompute is solved under the balance constraint
+// sum_i s_i = 0 (as many +1 as -1 spins). J is onloaded once; between the inner solves only the
+// h row is re-programmed with the updated multiplier (lagd_lagrange_run). The test prints the
+// multiplier and the violation of the last best spin vector, and passes when the constraint holds
+// within LAGRANGE_ITERS inner solves.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// Maximum number of inner solves
+#ifndef LAGRANGE_ITERS
+#define LAGRANGE_ITERS 8
+#endif
+
+// Multiplier step size (LAGD_LAGRANGE_FRAC fractional bits)
+#ifndef LAGRANGE_STEP
+#define LAGRANGE_STEP 4
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+#include "lagd_lagrange.h"
+
+int main(void) {
+    static int8_t a[NUM_SPIN];
+    static const int32_t b[1] = {0};
+    static int32_t lambda[1] = {0};
+    static int32_t viol[1];
+    static uint32_t best[NUM_SPIN / 32];
+    unsigned num_viol;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // balance constraint
+    for (int i = 0; i < NUM_SPIN; i++) a[i] = 1;
+    const lagd_lagrange_t prob = {
+        .num_con = 1,
+        .a = a,
+        .b = b,
+        .ineq = NULL,
+        .h0 = model_h_data,
+        .step = LAGRANGE_STEP,
+        .lambda = lambda,
+        .viol = viol,
+    };
+
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading (J and h0, once)
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+
+    // outer loop
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    unsigned iters = lagd_lagrange_run(CORE_TESTED, &prob, LAGRANGE_ITERS, best, &num_viol);
+
+    printf("Inner solves: %u, lambda: %d, violation: %d\r\n", iters, lambda[0], viol[0]);
+    printf("Best spin:");
+    for (int j = NUM_SPIN / 32 - 1; j >= 0; j--) printf(" %08x", best[j]);
+    printf("\r\n");
+    if (num_viol) {
+        printf("Lagrangian check failed\r\n");
+    } else {
+        printf("Lagrangian check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return num_viol ? 1 : 0;
+}
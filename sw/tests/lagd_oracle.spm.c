@@ -0,0 +1,114 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Energy-oracle mode: after the computation of lagd_scompute, the core is switched to
+// energy-oracle mode and evaluates a batch of spin vectors written to the flip memory by the host:
+// the SPIN_DEPTH final spin vectors of the spin FIFO, followed by NUM_RANDOM random ones. The
+// oracle energies of the final spin vectors must match the energies of the energy FIFO.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+#ifndef NUM_RANDOM
+#define NUM_RANDOM 14
+#endif
+
+// Flip memory layout: flip icons in [0, NUM_ICONS), then the spin vectors, then the energies
+#ifndef NUM_ICONS
+#define NUM_ICONS 512
+#endif
+#define NUM_VECTORS (SPIN_DEPTH + NUM_RANDOM)
+#define SRC_BASE NUM_ICONS
+#define DST_BASE (SRC_BASE + NUM_VECTORS)
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+int main(void) {
+    uint64_t spin[NUM_SPIN / 64];
+    int32_t fifo_energy[SPIN_DEPTH];
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)CORE_TESTED * IC_NUM_REGS);
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // register configuration (flip detection off, as in energy-oracle mode)
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_write_counter_cfg_4_icon_last_raddr_plus_one(CORE_TESTED, NUM_ICONS);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_write_global_cfg_1_enable_flip_detection(CORE_TESTED, 0);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+
+    // start computation
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    lagd_enable_computation(CORE_TESTED);
+    lagd_wait_for_computation_done(CORE_TESTED);
+    lagd_write_global_cfg_2_cmpt_en(CORE_TESTED, 0);
+    lagd_print_energy_fifo_data(CORE_TESTED);
+
+    // batch: the final spin vectors, then random spin vectors
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        fifo_energy[k] = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]);
+        for (int j = 0; j < NUM_SPIN / 64; j++) {
+            uint64_t lo = *reg32(base, lagd_spin_fifo_data_offset[k] + 8 * j);
+            uint64_t hi = *reg32(base, lagd_spin_fifo_data_offset[k] + 8 * j + 4);
+            spin[j] = lo | (hi << 32);
+        }
+        lagd_write_oracle_spin(CORE_TESTED, SRC_BASE, k, spin);
+    }
+    for (unsigned k = SPIN_DEPTH; k < NUM_VECTORS; k++) {
+        for (int j = 0; j < NUM_SPIN / 64; j++) spin[j] = lagd_xorshift64(&seed);
+        lagd_write_oracle_spin(CORE_TESTED, SRC_BASE, k, spin);
+    }
+    fence();
+
+    // evaluate the batch
+    lagd_enable_oracle(CORE_TESTED);
+    lagd_oracle_run(CORE_TESTED, SRC_BASE, DST_BASE, NUM_VECTORS);
+
+    // check the energies
+    unsigned errors = 0;
+    for (unsigned k = 0; k < NUM_VECTORS; k++) {
+        int32_t e = lagd_read_oracle_energy(CORE_TESTED, DST_BASE, k);
+        printf("Vector %u: energy 0x%08x\r\n", k, (uint32_t)e);
+        if (k < SPIN_DEPTH && e != fifo_energy[k]) errors++;
+    }
+    if (errors) {
+        printf("Energy oracle check failed: %u errors\r\n", errors);
+    } else {
+        printf("Energy oracle check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Block-diagonal packing: the couplings between the 2^PACK_LOG2 blocks of the model in the L1 J
+// memory are cleared, so the core holds independent models on the diagonal of J. The computation
+// of lagd_scompute is then run with packing enabled. Every block must report a best energy, and
+// since the block energies of any spin vector add up to its total energy, the per-block best
+// energies must not add up to more than the final energies in the energy FIFO.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// log2 of the number of packed blocks
+#ifndef PACK_LOG2
+#define PACK_LOG2 1
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+int main(void) {
+    static int32_t energy[1 << PACK_LOG2];
+    static uint32_t spin[NUM_SPIN / 32];
+    static uint32_t block_spin[NUM_SPIN / 32];
+    unsigned errors = 0;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+#if PACK_BLOCKS >= (1 << PACK_LOG2)
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)CORE_TESTED * IC_NUM_REGS);
+    // make the model block-diagonal
+    lagd_pack_mask_j((volatile uint64_t *)lagd_l1_j_mem_addr(CORE_TESTED, 0), MODEL_J_BITS,
+                     PACK_LOG2);
+    fence();
+
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_enable_pack(CORE_TESTED, PACK_LOG2);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+
+    // start computation with the per-block best spins tracked
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    lagd_enable_computation(CORE_TESTED);
+    lagd_wait_for_computation_done(CORE_TESTED);
+    lagd_disable_pack(CORE_TESTED);
+
+    // print the final output and the per-block results
+    lagd_print_energy_fifo_data(CORE_TESTED);
+    uint32_t valid = lagd_read_pack(CORE_TESTED, PACK_LOG2, energy, spin);
+    int32_t sum = 0;
+    for (unsigned b = 0; b < (1u << PACK_LOG2); b++) {
+        lagd_pack_unpack_spin(spin, PACK_LOG2, b, block_spin);
+        printf("Block %u: energy 0x%08x, spin", b, (uint32_t)energy[b]);
+        for (int j = (NUM_SPIN >> PACK_LOG2) / 32 - 1; j >= 0; j--) printf(" %08x", block_spin[j]);
+        printf("\r\n");
+        sum += energy[b];
+    }
+
+    // check the per-block results
+    errors = (valid != (1u << (1u << PACK_LOG2)) - 1);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        int32_t e = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]);
+        if (sum > e) errors++;
+    }
+    if (errors) {
+        printf("Packing check failed: %u errors\r\n", errors);
+    } else {
+        printf("Packing check passed\r\n");
+    }
+#else
+    (void)energy;
+    (void)spin;
+    (void)block_spin;
+    printf("Packing test skipped: build with PACK_BLOCKS >= %u\r\n", 1u << PACK_LOG2);
+#endif
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,154 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Parallel tempering on all cores: every core runs the same model, core i at a higher flip rate
+// (temperature) than core i-1, and the replicas are exchanged on-chip (Metropolis acceptance) after
+// every EXCHANGE_INTERVAL computations.
+// The campaign is run twice: with NUM_EXCHANGES for every core, then with the hottest core
+// stopping halfway, which must leave the exchange instead of stalling the other cores. Both runs
+// must finish within PT_TIMEOUT status polls, with consistent swap counters.
+
+#ifndef ITERS_PER_EXCHANGE
+#define ITERS_PER_EXCHANGE 128
+#endif
+
+#ifndef NUM_EXCHANGES
+#define NUM_EXCHANGES 15
+#endif
+
+// Pair temperature 1 / (beta_i - beta_i+1) of the exchange in energy units (0: only swap when the
+// hotter replica is lower in energy)
+#ifndef EXCHANGE_PAIR_TEMP
+#define EXCHANGE_PAIR_TEMP 64
+#endif
+
+// Computations between two exchanges of a pair
+#ifndef EXCHANGE_INTERVAL
+#define EXCHANGE_INTERVAL 1
+#endif
+
+// Status polls per core before a campaign is reported as stalled
+#ifndef PT_TIMEOUT
+#define PT_TIMEOUT 10000000
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "model_j_data_sec.h"
+#include "model_f_data_sec.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+// Raise the flip rate of a core: add about level/16 random extra flips per spin to each icon
+static void lagd_heat_flip_icons(unsigned core, unsigned level, uint64_t seed) {
+    volatile uint64_t *icons = (volatile uint64_t *)lagd_l1_f_mem_addr(core, 0);
+    for (unsigned i = 0; i < ITERS_PER_EXCHANGE * (NUM_SPIN / 64); i++) {
+        uint64_t extra = 0;
+        for (unsigned l = 0; l < level; l++)
+            extra |= lagd_xorshift64(&seed) & lagd_xorshift64(&seed) & lagd_xorshift64(&seed) &
+                     lagd_xorshift64(&seed);
+        icons[i] |= extra;
+    }
+}
+
+// Run the campaign on all cores with the given number of exchanges of the hottest core, and
+// check it; returns the number of errors
+static unsigned lagd_pt_run(unsigned last_exchanges) {
+    unsigned i, errors = 0, swaps = 0;
+    for (i = 0; i < NUM_ISING_CORES; i++) {
+        unsigned exchanges = (i == NUM_ISING_CORES - 1) ? last_exchanges : NUM_EXCHANGES;
+        lagd_configure_initial_spins(i);
+        lagd_configure_replica_exchange_schedule(i, ITERS_PER_EXCHANGE, exchanges);
+        lagd_enable_replica_exchange(i, EXCHANGE_PAIR_TEMP, EXCHANGE_INTERVAL);
+        lagd_clear_config_valid(i);
+    }
+
+    // run all replicas; the cores wait for each other at every exchange
+    for (i = 0; i < NUM_ISING_CORES; i++) {
+        lagd_enable_energy_monitor_fifo(i);
+        lagd_enable_computation_multi_cmpt_mode(i);
+    }
+    for (i = 0; i < NUM_ISING_CORES; i++) {
+        void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)i * IC_NUM_REGS);
+        unsigned polls = 0;
+        while ((*reg32(base, LAGD_CORE_OUTPUT_STATUS_REG_OFFSET) &
+                (1 << LAGD_CORE_OUTPUT_STATUS_MULTI_CMPT_MODE_IDLE_BIT)) == 0 &&
+               polls < PT_TIMEOUT)
+            polls++;
+        if (polls == PT_TIMEOUT) {
+            printf("core %u: campaign stalled\r\n", i);
+            errors++;
+        }
+        lagd_write_global_cfg_2_cmpt_en(i, 0);
+        lagd_write_global_cfg_2_multi_cmpt_mode_en(i, 0);
+    }
+
+    // every swap moves one replica into each core of a pair, at most SPIN_DEPTH per exchange
+    for (i = 0; i < NUM_ISING_CORES; i++) {
+        unsigned cnt = lagd_get_replica_exchange_swap_cnt(i);
+        unsigned exchanges = (i == NUM_ISING_CORES - 1) ? last_exchanges : NUM_EXCHANGES;
+        printf("core %u: swaps in: %u\r\n", i, cnt);
+        lagd_print_energy_fifo_data(i);
+        errors += cnt > (exchanges + 1) * SPIN_DEPTH;
+        swaps += cnt;
+        lagd_disable_replica_exchange(i);
+    }
+    errors += swaps % 2;
+    return errors;
+}
+
+int main(void) {
+    unsigned i;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // temperature ladder: core 0 keeps the original flip schedule
+    for (i = 1; i < NUM_ISING_CORES; i++) lagd_heat_flip_icons(i, i, 0x9e3779b97f4a7c15ULL * i);
+
+    // register configuration
+    for (i = 0; i < NUM_ISING_CORES; i++) {
+        lagd_configure_counters(i);
+        lagd_configure_wwl_vdd_cfg(i);
+        lagd_configure_wwl_vread_cfg(i);
+        lagd_configure_spin_wwl_strobe(i);
+        lagd_configure_spin_feedback(i);
+        lagd_configure_h_rdata(i);
+        lagd_configure_global_cfg_1(i);
+        lagd_configure_global_cfg_2(i);
+        // clear config valid
+        lagd_clear_config_valid(i);
+    }
+    for (i = 0; i < NUM_ISING_CORES; i++) {
+        // start analog onloading
+        lagd_enable_analog_onloading(i);
+        // wait for analog onloading to finish
+        lagd_wait_for_analog_onloading_done(i);
+    }
+
+    // same schedule on every core; the coldest core holds the best replicas
+    unsigned errors = lagd_pt_run(NUM_EXCHANGES);
+    // the hottest core stops halfway
+    errors += lagd_pt_run(NUM_EXCHANGES / 2);
+    if (errors) {
+        printf("Parallel tempering check failed: %u errors\r\n", errors);
+    } else {
+        printf("Parallel tempering check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
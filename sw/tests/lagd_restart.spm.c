@@ -0,0 +1,161 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Multi-start campaign with the restart queue: every computation of multi_cmpt_mode starts from
+// its own initial spins taken from the flip memory, and stores its result there. Afterwards
+// CHECK_RESTARTS of the restarts are run again on their own, from their queued states loaded
+// through the initial spin registers: each must reproduce its stored result, which shows that
+// result n comes from restart state n. The lists must fit in the flip memory without overflow.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+#ifndef NUM_RESTARTS
+#define NUM_RESTARTS 64
+#endif
+
+#ifndef CHECK_RESTARTS
+#define CHECK_RESTARTS 4
+#endif
+
+// Flip memory layout: flip icons in [0, NUM_ICONS), then restart states, then results
+#ifndef NUM_ICONS
+#define NUM_ICONS 512
+#endif
+#define STATE_BASE NUM_ICONS
+#define RESULT_BASE (STATE_BASE + NUM_RESTARTS * SPIN_DEPTH)
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+// Run restart idx on its own from its queued states (restart queue disabled) and compare the
+// final spin and energy FIFOs with its stored result; returns the number of mismatches
+static unsigned lagd_restart_recheck(unsigned core, unsigned idx) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    uint64_t state[SPIN_DEPTH * NUM_SPIN / 64], spins[SPIN_DEPTH * NUM_SPIN / 64];
+    int32_t energies[SPIN_DEPTH];
+    unsigned errors = 0;
+    lagd_read_restart_state(core, STATE_BASE, idx, state);
+    lagd_read_restart_result(core, RESULT_BASE, idx, spins, energies);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        for (int j = 0; j < NUM_SPIN / 32; j++)
+            *reg32(base, lagd_config_spin_initial_offset[k] + 4 * j) =
+                (uint32_t)(state[k * (NUM_SPIN / 64) + j / 2] >> (32 * (j % 2)));
+    }
+    lagd_write_global_cfg_2_config_valid_fm(core, 1);
+    lagd_write_global_cfg_2_config_valid_fm(core, 0);
+    lagd_enable_computation(core);
+    lagd_wait_for_computation_done(core);
+    lagd_write_global_cfg_2_cmpt_en(core, 0);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+        errors += (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]) != energies[k];
+        for (int j = 0; j < NUM_SPIN / 32; j++)
+            errors += *reg32(base, lagd_spin_fifo_data_offset[k] + 4 * j) !=
+                      (uint32_t)(spins[k * (NUM_SPIN / 64) + j / 2] >> (32 * (j % 2)));
+    }
+    return errors;
+}
+
+int main(void) {
+    uint64_t spins[SPIN_DEPTH * NUM_SPIN / 64];
+    int32_t energies[SPIN_DEPTH];
+    unsigned errors = 0;
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    if (lagd_check_restart_queue(STATE_BASE, RESULT_BASE, NUM_RESTARTS)) {
+        printf("Restart lists do not fit in the flip memory: %u restarts, at most %u\r\n",
+               NUM_RESTARTS, lagd_restart_queue_capacity(STATE_BASE));
+        uart_write_flush(&__base_uart);
+        return 1;
+    }
+
+    // restart states
+    for (unsigned r = 0; r < NUM_RESTARTS; r++) {
+        for (unsigned i = 0; i < SPIN_DEPTH * NUM_SPIN / 64; i++) spins[i] = lagd_xorshift64(&seed);
+        lagd_write_restart_state(CORE_TESTED, STATE_BASE, r, spins);
+    }
+    lagd_configure_restart_queue(CORE_TESTED, STATE_BASE, RESULT_BASE);
+    lagd_enable_restart_queue(CORE_TESTED);
+
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_write_cmpt_max_num(CORE_TESTED, NUM_RESTARTS - 1);
+    lagd_write_counter_cfg_4_icon_last_raddr_plus_one(CORE_TESTED, NUM_ICONS);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+
+    // run the whole campaign
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    lagd_enable_computation_multi_cmpt_mode(CORE_TESTED);
+    lagd_wait_for_computation_multi_cmpt_mode_done(CORE_TESTED);
+
+    // collect results
+    unsigned stored = lagd_get_restart_queue_store_cnt(CORE_TESTED);
+    unsigned best_idx = 0;
+    int32_t best_energy = 0;
+    for (unsigned r = 0; r < stored; r++) {
+        lagd_read_restart_result(CORE_TESTED, RESULT_BASE, r, spins, energies);
+        for (unsigned k = 0; k < SPIN_DEPTH; k++) {
+            if ((r == 0 && k == 0) || energies[k] < best_energy) {
+                best_energy = energies[k];
+                best_idx = r;
+            }
+        }
+    }
+    errors += lagd_get_restart_queue_overflow(CORE_TESTED);
+    lagd_disable_restart_queue(CORE_TESTED);
+    printf("restarts stored: %u/%u, best energy: %d (restart %u)\r\n", stored, NUM_RESTARTS,
+           best_energy, best_idx);
+    errors += stored != NUM_RESTARTS;
+
+    // single computations from the queued states of a few restarts
+    lagd_stage_global_cfg_2_cmpt_en(CORE_TESTED, 0);
+    lagd_stage_global_cfg_2_multi_cmpt_mode_en(CORE_TESTED, 0);
+    lagd_commit_global_cfg_2(CORE_TESTED);
+    for (unsigned c = 0; c < CHECK_RESTARTS && c < stored; c++) {
+        unsigned r = CHECK_RESTARTS > 1 ? c * (stored - 1) / (CHECK_RESTARTS - 1) : 0;
+        unsigned e = lagd_restart_recheck(CORE_TESTED, r);
+        if (e) printf("restart %u: result does not match its initial state\r\n", r);
+        errors += e;
+    }
+
+    if (errors) {
+        printf("Restart queue check failed: %u errors\r\n", errors);
+    } else {
+        printf("Restart queue check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,98 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Flip ring buffer: the computation of lagd_scompute is run with a flip schedule of MODEL_F_VECS
+// icons, held in L2, that does not fit in the RING_SIZE icons of the flip memory used as a ring.
+// The host keeps refilling the ring whenever its fill level drops to the low watermark, until the
+// whole schedule is written. The flip engine must never read an icon that was not written yet.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// Flip memory slots used by the ring and its watermarks (icons)
+#ifndef RING_SIZE
+#define RING_SIZE 256
+#endif
+#define RING_LOW_WM (RING_SIZE / 4)
+#define RING_HIGH_WM (RING_SIZE * 3 / 4)
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+int main(void) {
+    uint32_t filled = 0;
+    unsigned refills = 0;
+    unsigned stalls = 0;
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)CORE_TESTED * IC_NUM_REGS);
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // ring configuration and first fill
+    lagd_enable_flip_ring(CORE_TESTED, RING_SIZE, MODEL_F_VECS, RING_LOW_WM, RING_HIGH_WM);
+    lagd_flip_ring_refill(CORE_TESTED, RING_SIZE, model_f_data, MODEL_F_VECS, &filled);
+
+    // register configuration (the icon count is set by the ring)
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_write_counter_cfg_4_icon_last_raddr_plus_one(CORE_TESTED, RING_SIZE);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+
+    // start computation and stream the rest of the schedule
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    lagd_enable_computation(CORE_TESTED);
+    lagd_wait_for_computation_start(CORE_TESTED);
+    while ((*reg32(base, LAGD_CORE_OUTPUT_STATUS_REG_OFFSET) &
+            (1 << LAGD_CORE_OUTPUT_STATUS_CMPT_IDLE_BIT)) == 0) {
+        uint32_t flags = *reg32(base, LAGD_CORE_FLIP_MEM_REN_RADDR_REG_OFFSET);
+        if (flags & (1 << LAGD_CORE_FLIP_MEM_REN_RADDR_RING_STALL_BIT)) stalls++;
+        if ((flags & (1 << LAGD_CORE_FLIP_MEM_REN_RADDR_RING_LOW_BIT)) && filled < MODEL_F_VECS)
+            refills += lagd_flip_ring_refill(CORE_TESTED, RING_SIZE, model_f_data, MODEL_F_VECS,
+                                             &filled) != 0;
+    }
+    lagd_disable_flip_ring(CORE_TESTED);
+    lagd_print_energy_fifo_data(CORE_TESTED);
+
+    // check the ring counters
+    uint32_t read = lagd_get_flip_ring_read_cnt(CORE_TESTED);
+    printf("Ring: %u icons written, %u read, %u refills, %u stalls seen\r\n", filled, read,
+           refills, stalls);
+    unsigned errors = (read > filled) + (filled > MODEL_F_VECS);
+    if (errors) {
+        printf("Flip ring check failed: %u errors\r\n", errors);
+    } else {
+        printf("Flip ring check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
@@ -15,6 +15,23 @@
 #define ENERGY_MONITOR 1
 #endif
 
+#ifndef BINARY_STREAM
+#define BINARY_STREAM 0
+#endif
+
+#ifndef JOB_ID
+#define JOB_ID 0
+#endif
+
+// Batched (J-stationary) energy evaluation, runs with flip detection off
+#ifndef EM_BATCH
+#define EM_BATCH 0
+#endif
+
+#ifndef EM_BATCH_TIMEOUT
+#define EM_BATCH_TIMEOUT 1024
+#endif
+
 // cheshire headers
 #include "regs/cheshire.h"
 #include "dif/clint.h"
@@ -29,16 +46,19 @@
 #include "lagd_reg_params.h"
 #include "lagd_common.h"
 #include "lagd_scompute.h"
+#include "lagd_stream.h"
+#include "lagd_timing.h"
 
 int main(void) {
     static uint32_t log_buf[MAX_SAMPLES];
     // UART init
-    // uint64_t t0 = clint_get_mtime();
     uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
     uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
     uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
 
     // register configuration
+    lagd_timing_set_job(JOB_ID);
+    LAGD_TIME_BEGIN(CORE_TESTED, LAGD_PHASE_CONFIG);
     lagd_configure_initial_spins(CORE_TESTED);
     lagd_configure_cmpt_max_num(CORE_TESTED);
     lagd_configure_counters(CORE_TESTED);
@@ -49,14 +69,19 @@ int main(void) {
     lagd_configure_h_rdata(CORE_TESTED);
     lagd_configure_global_cfg_1(CORE_TESTED);
     lagd_configure_global_cfg_2(CORE_TESTED);
+    if (EM_BATCH) lagd_enable_em_batch(CORE_TESTED, EM_BATCH_TIMEOUT);
     // clear config valid
     lagd_clear_config_valid(CORE_TESTED);
+    LAGD_TIME_END(CORE_TESTED, LAGD_PHASE_CONFIG);
     // start analog onloading
+    LAGD_TIME_BEGIN(CORE_TESTED, LAGD_PHASE_ONLOAD);
     lagd_enable_analog_onloading(CORE_TESTED);
     // wait for analog onloading to finish
     lagd_wait_for_analog_onloading_done(CORE_TESTED);
+    LAGD_TIME_END(CORE_TESTED, LAGD_PHASE_ONLOAD);
 
     // start computation
+    LAGD_TIME_BEGIN(CORE_TESTED, LAGD_PHASE_COMPUTE);
     lagd_enable_energy_monitor_fifo(CORE_TESTED);
     lagd_enable_computation(CORE_TESTED);
     unsigned log_cnt;
@@ -67,16 +92,40 @@ int main(void) {
     }
     // wait for computation to finish
     lagd_wait_for_computation_done(CORE_TESTED);
-    // print final output
-    lagd_print_energy_fifo_data(CORE_TESTED);
+    LAGD_TIME_END(CORE_TESTED, LAGD_PHASE_COMPUTE);
 
-    if (ENERGY_MONITOR) {
-        // print energy monitor fifo debug register log
-        lagd_print_energy_fifo_dbg(CORE_TESTED, log_cnt, log_buf);
+    LAGD_TIME_BEGIN(CORE_TESTED, LAGD_PHASE_READOUT);
+    if (BINARY_STREAM) {
+        // send results and logs as binary frames (decode with sw/utils/lagd_stream.py)
+        lagd_stream_energy_fifo_data(CORE_TESTED, JOB_ID);
+        lagd_stream_spin_fifo_data(CORE_TESTED, JOB_ID);
+        lagd_stream_counters(CORE_TESTED, JOB_ID);
+        if (ENERGY_MONITOR) {
+            lagd_stream_energy_fifo_dbg(CORE_TESTED, JOB_ID, log_cnt, log_buf);
+        } else {
+            lagd_stream_cycle_per_iteration(CORE_TESTED, JOB_ID, log_cnt, log_buf);
+        }
+        lagd_stream_end(CORE_TESTED, JOB_ID);
     } else {
-        // print performance counter log
-        lagd_print_cycle_per_iteration(CORE_TESTED, log_cnt, log_buf);
+        // print final output
+        lagd_print_energy_fifo_data(CORE_TESTED);
+
+        if (ENERGY_MONITOR) {
+            // print energy monitor fifo debug register log
+            lagd_print_energy_fifo_dbg(CORE_TESTED, log_cnt, log_buf);
+        } else {
+            // print performance counter log
+            lagd_print_cycle_per_iteration(CORE_TESTED, log_cnt, log_buf);
+        }
+    }
+    LAGD_TIME_END(CORE_TESTED, LAGD_PHASE_READOUT);
+
+    if (LAGD_TIMING) {
+        // phase timing report and raw records (parse with sw/utils/lagd_timing.py)
+        lagd_timing_report(rtc_freq);
+        lagd_timing_dump(rtc_freq);
     }
+    if (BINARY_STREAM) return 0;
 
     printf("=== DONE ===\r\n");
     uart_write_flush(&__base_uart);
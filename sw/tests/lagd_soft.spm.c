@@ -0,0 +1,112 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Software annealing worker: while the core runs the computation of lagd_scompute, the CVA6 anneals
+// the same model (model_j_data, model_h_data) from initial spin set 0 with the acceptance rule
+// SOFT_MODE, instead of polling for the end of the computation. Afterwards the best spin vector of
+// the core is polished with a steepest descent (lagd_soft_polish). The test checks that the
+// software energy of the best hardware spin vector matches the energy FIFO and that polishing does
+// not increase it, and prints the hardware, polished and software best energies.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// Software search: acceptance rule (LAGD_ACCEPT_*, or LAGD_SOFT_TABU) and schedule
+#ifndef SOFT_MODE
+#define SOFT_MODE 2
+#endif
+
+#ifndef SOFT_CHUNK
+#define SOFT_CHUNK 64
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+#include "lagd_lagrange.h"
+#include "lagd_soft.h"
+
+int main(void) {
+    static lagd_soft_state_t st;
+    static uint32_t hw_best[NUM_SPIN / 32];
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // the job of the core, for the software worker
+    const lagd_soft_model_t model = {
+        .j = model_j_data,
+        .j_bits = MODEL_J_BITS,
+        .h = model_h_data,
+        .hscaling = GCFG2_DGT_HSCALING,
+    };
+    const lagd_soft_cfg_t cfg = {
+        .mode = SOFT_MODE,
+        .t_start = 64,
+        .t_min = 1,
+        .decay_shift = 4,
+        .interval = NUM_SPIN,
+        .seed = 0x2545f491,
+        .tenure = 16,
+    };
+
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+
+    // start computation, the CVA6 anneals meanwhile
+    lagd_soft_init(&model, &cfg, &st, spin_initial_0);
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    lagd_enable_computation(CORE_TESTED);
+    unsigned chunks = lagd_soft_anneal_while_busy(CORE_TESTED, &model, &cfg, &st, SOFT_CHUNK);
+    lagd_print_energy_fifo_data(CORE_TESTED);
+
+    // check the software energy model against the core, then polish the hardware result
+    int32_t hw_energy = lagd_read_best_spin(CORE_TESTED, hw_best);
+    int32_t sw_energy = lagd_soft_energy(&model, hw_best);
+    int32_t polished = lagd_soft_polish(&model, hw_best);
+    printf("Hardware best: 0x%08x (software 0x%08x), polished: 0x%08x\r\n", (uint32_t)hw_energy,
+           (uint32_t)sw_energy, (uint32_t)polished);
+    printf("Software best: 0x%08x after %u steps\r\n", (uint32_t)st.best_energy,
+           chunks * SOFT_CHUNK);
+
+    unsigned errors = (sw_energy != hw_energy) + (polished > hw_energy) +
+                      (lagd_soft_energy(&model, st.best) != st.best_energy);
+    if (errors) {
+        printf("Software worker check failed: %u errors\r\n", errors);
+    } else {
+        printf("Software worker check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
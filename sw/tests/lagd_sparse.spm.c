@@ -0,0 +1,105 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Zero-block skipping: the couplings and biases of the spins of the upper half of the J image are
+// cleared, so half of the J memory words are all-zero. The computation of lagd_scompute is run
+// twice from the same initial spins, first without and then with the non-zero block bitmap. Since
+// the skipped blocks contribute no energy, both runs must end with the same energy FIFO, and the
+// second one should take fewer cycles.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+// Run the computation from the initial spins and keep its energy FIFO
+static void lagd_sparse_run(unsigned core, int32_t *energy) {
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)core * IC_NUM_REGS);
+    lagd_configure_initial_spins(core);
+    lagd_write_global_cfg_2_config_valid_fm(core, 1);
+    lagd_write_global_cfg_2_config_valid_fm(core, 0);
+    lagd_enable_computation(core);
+    lagd_wait_for_computation_done(core);
+    lagd_write_global_cfg_2_cmpt_en(core, 0);
+    lagd_print_cycle_per_cmpt(core);
+    for (unsigned k = 0; k < SPIN_DEPTH; k++)
+        energy[k] = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]);
+}
+
+int main(void) {
+    static uint32_t h[NUM_SPIN * BIT_H / 32];
+    static uint32_t nz[NUM_SPIN / PARALLELISM / 32];
+    int32_t energy_dense[SPIN_DEPTH], energy_sparse[SPIN_DEPTH];
+    volatile uint64_t *j = (volatile uint64_t *)lagd_l1_j_mem_addr(CORE_TESTED, 0);
+    const unsigned words_per_row = NUM_SPIN * MODEL_J_BITS / 64;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+    // clear the rows and columns of the upper half of the J image (spin vector bits
+    // [0, NUM_SPIN / 2)) and their h
+    lagd_pack_mask_j(j, MODEL_J_BITS, 1);
+    for (unsigned w = NUM_SPIN / 2 * words_per_row; w < NUM_SPIN * words_per_row; w++) j[w] = 0;
+    fence();
+    for (unsigned i = 0; i < NUM_SPIN * BIT_H / 32; i++)
+        h[i] = (i < NUM_SPIN / 2 * BIT_H / 32) ? 0 : model_h_data[i];
+
+    // register configuration (flip detection on, which the skipping relies on)
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_load_h_rdata(CORE_TESTED, h);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_write_global_cfg_1_enable_flip_detection(CORE_TESTED, 1);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+
+    // dense run (the bitmap resets to all ones), then sparse run
+    lagd_sparse_run(CORE_TESTED, energy_dense);
+    lagd_compute_j_nz_bitmap(j, MODEL_J_BITS, h, nz);
+    lagd_load_j_nz_bitmap(CORE_TESTED, nz);
+    printf("Non-zero block bitmap:");
+    for (int i = NUM_SPIN / PARALLELISM / 32 - 1; i >= 0; i--) printf(" %08x", nz[i]);
+    printf("\r\n");
+    lagd_sparse_run(CORE_TESTED, energy_sparse);
+    lagd_print_energy_fifo_data(CORE_TESTED);
+
+    // check the energies
+    unsigned errors = 0;
+    for (unsigned k = 0; k < SPIN_DEPTH; k++) errors += energy_dense[k] != energy_sparse[k];
+    if (errors) {
+        printf("Zero-block skipping check failed: %u errors\r\n", errors);
+    } else {
+        printf("Zero-block skipping check passed\r\n");
+    }
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
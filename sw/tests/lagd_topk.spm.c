@@ -0,0 +1,111 @@
+// Copyright 2025 KU Leuven.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+// Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+//
+// Top-K solutions buffer: the computation of lagd_scompute is run with the top-K buffer enabled,
+// and the pool of the TOPK_K best distinct spin vectors is read out afterwards. The pool must be
+// sorted by energy, free of duplicates, and its best entry must not be worse than the final
+// energies in the energy FIFO.
+
+#ifndef CORE_TESTED
+#define CORE_TESTED 0
+#endif
+
+// Number of solutions to keep
+#ifndef TOPK_K
+#define TOPK_K 8
+#endif
+
+// cheshire headers
+#include "regs/cheshire.h"
+#include "dif/clint.h"
+#include "dif/uart.h"
+#include "params.h"
+#include "util.h"
+#include "printf.h"
+// lagd headers
+#include "model_j_data.h"
+#include "model_f_data.h"
+#include "lagd_reg_params.h"
+#include "lagd_common.h"
+#include "lagd_scompute.h"
+
+static int lagd_same_spin(const lagd_solution_t *a, const lagd_solution_t *b) {
+    for (int j = 0; j < NUM_SPIN / 32; j++)
+        if (a->spin[j] != b->spin[j]) return 0;
+    return 1;
+}
+
+int main(void) {
+    static lagd_solution_t pool[TOPK_K];
+    unsigned errors = 0;
+    // UART init
+    uint32_t rtc_freq = *reg32(&__base_regs, CHESHIRE_RTC_FREQ_REG_OFFSET);
+    uint64_t reset_freq = clint_get_core_freq(rtc_freq, 2500);
+    uart_init(&__base_uart, reset_freq, __BOOT_BAUDRATE);
+
+#if TOPK_DEPTH >= TOPK_K
+    void *base = (void *)((uintptr_t)IC_REGS_BASE_ADDR + (uintptr_t)CORE_TESTED * IC_NUM_REGS);
+    // register configuration
+    lagd_configure_initial_spins(CORE_TESTED);
+    lagd_configure_cmpt_max_num(CORE_TESTED);
+    lagd_configure_counters(CORE_TESTED);
+    lagd_configure_wwl_vdd_cfg(CORE_TESTED);
+    lagd_configure_wwl_vread_cfg(CORE_TESTED);
+    lagd_configure_spin_wwl_strobe(CORE_TESTED);
+    lagd_configure_spin_feedback(CORE_TESTED);
+    lagd_configure_h_rdata(CORE_TESTED);
+    lagd_configure_global_cfg_1(CORE_TESTED);
+    lagd_configure_global_cfg_2(CORE_TESTED);
+    // clear config valid
+    lagd_clear_config_valid(CORE_TESTED);
+    // start analog onloading
+    lagd_enable_analog_onloading(CORE_TESTED);
+    // wait for analog onloading to finish
+    lagd_wait_for_analog_onloading_done(CORE_TESTED);
+
+    // start computation with the top-K buffer collecting solutions
+    lagd_enable_topk(CORE_TESTED, TOPK_K);
+    lagd_enable_energy_monitor_fifo(CORE_TESTED);
+    lagd_enable_computation(CORE_TESTED);
+    lagd_wait_for_computation_done(CORE_TESTED);
+    lagd_disable_topk(CORE_TESTED);
+
+    // print the final output and the solution pool
+    lagd_print_energy_fifo_data(CORE_TESTED);
+    unsigned n = lagd_read_topk(CORE_TESTED, pool, TOPK_K);
+    printf("Top-%u solutions: %u\r\n", TOPK_K, n);
+    for (unsigned i = 0; i < n; i++) {
+        printf("Solution %u: energy 0x%08x, spin", i, (uint32_t)pool[i].energy);
+        for (int j = NUM_SPIN / 32 - 1; j >= 0; j--) printf(" %08x", pool[i].spin[j]);
+        printf("\r\n");
+    }
+
+    // check the pool
+    errors = (n == 0);
+    for (unsigned i = 1; i < n; i++) {
+        if (pool[i].energy < pool[i - 1].energy) errors++;
+        for (unsigned k = 0; k < i; k++) errors += lagd_same_spin(&pool[i], &pool[k]);
+    }
+    for (unsigned k = 0; k < SPIN_DEPTH && n > 0; k++) {
+        int32_t e = (int32_t)*reg32(base, lagd_energy_fifo_data_offset[k]);
+        if (pool[0].energy > e) errors++;
+    }
+    // an index past the last entry reads out 0 instead of aliasing to an entry
+    lagd_write_topk_cfg_topk_rd_idx(CORE_TESTED, 0xff);
+    errors += (*reg32(base, LAGD_CORE_TOPK_ENERGY_REG_OFFSET) != 0);
+    if (errors) {
+        printf("Top-K check failed: %u errors\r\n", errors);
+    } else {
+        printf("Top-K check passed\r\n");
+    }
+#else
+    (void)pool;
+    printf("Top-K test skipped: build with TOPK_DEPTH >= %u\r\n", TOPK_K);
+#endif
+
+    printf("=== DONE ===\r\n");
+    uart_write_flush(&__base_uart);
+    return errors ? 1 : 0;
+}
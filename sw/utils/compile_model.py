@@ -0,0 +1,386 @@
+#!/usr/bin/env python3
+# Copyright 2025 KU Leuven.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+#
+# Compiles a QUBO, Max-Cut or dense problem into the model file read by gen_model_data.py
+# (sw/tests/data/<folder>/model), choosing the J/h quantisation and the h scaling factor
+# (GCFG2_DGT_HSCALING) that minimise the rounding error.
+#
+# Input formats (--format):
+#   qubo  : "i j value" triplets (0-indexed), minimise sum_ij Q_ij x_i x_j with x in {0, 1};
+#           lines starting with 'c' or '#' and the qbsolv "p qubo ..." header are skipped
+#   gset  : Gset/Max-Cut edge list, first line "n m", then m lines "i j w" (1-indexed);
+#           maximise the cut, reported as the objective -cut
+#   dense : n rows of n numbers, a QUBO matrix (--dense-kind qubo) or an Ising J matrix with
+#           E = 1/2 sum_ij J_ij s_i s_j to be minimised (--dense-kind ising)
+#
+# Every problem is converted to the Ising form E = sum_{i<j} J_ij s_i s_j + sum_i h_i s_i + c
+# with s in {-1, +1} (spin bit 1 is +1, x = 1). The core is built with HIsNegative = 1 and
+# minimises E_hw = -(1/2 sum_ij w_ij s_i s_j + sf * sum_i hq_i s_i), so the model file holds
+# w = round(-alpha * J) and hq = round(-alpha * h / sf), and the objective is recovered as
+# E_hw * energy_scale + offset, both written to the model file. alpha is searched over the
+# rounding breakpoints of J (in parallel, --jobs) and sf over the powers of two that fit SF_BITS.
+# Problems of at most CHECK_MAX_SPINS variables are checked by brute force: the minimum of the
+# decoded E_hw must be the minimum of the problem (a warning if the quantisation loses it).
+# --self-test runs this check on built-in instances that quantise exactly, and fails otherwise.
+#
+# Block-diagonal packing: with several input files (at most PACK_BLOCKS, all of --format), the
+# problems are packed on the diagonal of J, one per block of NUM_SPIN / 2^n spins where 2^n is
+# the number of problems rounded up to a power of two (run with lagd_enable_pack(core, n)).
+# Variable i of problem b is spin vector bit b * NUM_SPIN / 2^n + i, so lagd_pack_unpack_spin
+# returns the variables in order. The problems share alpha and sf; they are rescaled to the
+# objective scale of the first one, so problem b is recovered as
+# E_block_b * energy_scale + pack_offset_b (the pack section of the model file).
+#
+# Usage: python3 compile_model.py problem.txt --format gset --folder maxcut [--j-bits 2]
+#        python3 compile_model.py a.txt b.txt c.txt --format gset --folder packed
+#        python3 compile_model.py --self-test
+
+import os
+import sys
+import argparse
+import itertools
+from collections import Counter
+from concurrent.futures import ProcessPoolExecutor
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+SW_DIR = os.path.join(SCRIPT_DIR, "..")
+
+# Same bit widths as gen_model_data.py
+NUM_SPIN = 256
+J_BITS = 4
+H_BITS = 4
+SF_BITS = 6
+PACK_BLOCKS = 4   # PACK_BLOCKS in lagd_define.svh
+
+H_Q_MIN = -(1 << (H_BITS - 1))
+H_Q_MAX = (1 << (H_BITS - 1)) - 1
+SF_CANDIDATES = [1 << k for k in range(SF_BITS)]  # power-of-two h scaling factors
+MAX_J_MAGNITUDES = 64   # distinct |J| values used to derive alpha breakpoints
+ALPHA_GRID = 64         # extra uniformly spaced alpha candidates
+CHECK_MAX_SPINS = 16    # largest problem checked by brute force
+
+
+class IsingProblem:
+    def __init__(self, n):
+        self.n = n
+        self.j = {}            # (i, j) with i < j -> J_ij
+        self.h = [0.0] * n
+        self.const = 0.0
+        self.scale = 1.0       # objective = scale * (Ising energy) + const
+
+    def add_j(self, i, j, v):
+        if i == j:
+            raise ValueError("Ising couplings need i != j")
+        key = (min(i, j), max(i, j))
+        self.j[key] = self.j.get(key, 0.0) + v
+
+
+def qubo_to_ising(n, q):
+    """q: dict (i, j) -> Q_ij, minimise sum Q_ij x_i x_j; returns the equivalent IsingProblem."""
+    p = IsingProblem(n)
+    for (i, j), v in q.items():
+        if i == j:
+            # Q_ii x_i = Q_ii/2 (1 + s_i)
+            p.h[i] += v / 2
+            p.const += v / 2
+        else:
+            # Q_ij x_i x_j = Q_ij/4 (1 + s_i + s_j + s_i s_j)
+            p.add_j(i, j, v / 4)
+            p.h[i] += v / 4
+            p.h[j] += v / 4
+            p.const += v / 4
+    return p
+
+
+def data_lines(path):
+    with open(path) as f:
+        for line in f:
+            tok = line.split()
+            if not tok or tok[0][0] in "c#%" or tok[0] == "p":
+                continue
+            yield tok
+
+
+def read_qubo(path):
+    q = {}
+    n = 0
+    for tok in data_lines(path):
+        i, j, v = int(tok[0]), int(tok[1]), float(tok[2])
+        q[(i, j)] = q.get((i, j), 0.0) + v
+        n = max(n, i + 1, j + 1)
+    return qubo_to_ising(n, q)
+
+
+def read_gset(path):
+    lines = data_lines(path)
+    n, m = (int(t) for t in next(lines)[:2])
+    p = IsingProblem(n)
+    total = 0.0
+    edges = 0
+    for tok in lines:
+        i, j = int(tok[0]) - 1, int(tok[1]) - 1
+        w = float(tok[2]) if len(tok) > 2 else 1.0
+        # cut = sum_{ij} w_ij (1 - s_i s_j) / 2, minimise -cut
+        p.add_j(i, j, w)
+        total += w
+        edges += 1
+    if edges != m:
+        print(f"Warning: header announces {m} edges, read {edges}")
+    p.scale = 0.5
+    p.const = -total / 2
+    return p
+
+
+def read_dense(path, kind):
+    rows = [[float(t) for t in tok] for tok in data_lines(path)]
+    n = len(rows)
+    if any(len(r) != n for r in rows):
+        raise ValueError(f"{path}: expected a {n}x{n} matrix")
+    if kind == "qubo":
+        return qubo_to_ising(n, {(i, j): rows[i][j] for i in range(n) for j in range(n)
+                                 if rows[i][j] != 0})
+    p = IsingProblem(n)
+    for i in range(n):
+        p.const += rows[i][i] / 2   # s_i^2 = 1
+        for j in range(i + 1, n):
+            v = (rows[i][j] + rows[j][i]) / 2
+            if v != 0:
+                p.add_j(i, j, v)
+    return p
+
+
+def pack_problems(problems):
+    """Pack the problems on the diagonal blocks; returns (IsingProblem, blocks_log2)."""
+    blocks_log2 = (len(problems) - 1).bit_length()
+    size = NUM_SPIN >> blocks_log2
+    p = IsingProblem(NUM_SPIN)
+    p.scale = problems[0].scale
+    for b, q in enumerate(problems):
+        if q.n > size:
+            raise ValueError(f"problem {b} has {q.n} variables, a block holds {size}")
+        # the model index of spin vector bit k is NUM_SPIN - 1 - k
+        base = NUM_SPIN - 1 - b * size
+        k = q.scale / p.scale
+        for (i, j), v in q.j.items():
+            p.add_j(base - i, base - j, v * k)
+        for i in range(q.n):
+            p.h[base - i] += q.h[i] * k
+    return p, blocks_log2
+
+
+def j_error(alpha, j_hist, j_q_max):
+    """Squared rounding error of J (in problem units) for one alpha."""
+    err = 0.0
+    for v, cnt in j_hist:
+        w = max(-j_q_max, min(j_q_max, round(alpha * v)))
+        err += cnt * (v - w / alpha) ** 2
+    return err
+
+
+def h_quantise(alpha, h):
+    """Best (error, sf, hq) for the h vector at one alpha."""
+    best = None
+    for sf in SF_CANDIDATES:
+        hq = [max(H_Q_MIN, min(H_Q_MAX, round(alpha * v / sf))) for v in h]
+        err = sum((v - sf * q / alpha) ** 2 for v, q in zip(h, hq))
+        if best is None or err < best[0]:
+            best = (err, sf, hq)
+    return best
+
+
+def evaluate(task):
+    alpha, j_hist, j_q_max, h = task
+    h_err, sf, _ = h_quantise(alpha, h)
+    return j_error(alpha, j_hist, j_q_max) + h_err, alpha, sf
+
+
+def alpha_candidates(j_hist, h, j_q_max):
+    j_max = max((abs(v) for v, _ in j_hist), default=0.0)
+    h_max = max((abs(v) for v in h), default=0.0)
+    if j_max > 0:
+        alpha_max = j_q_max / j_max
+    elif h_max > 0:
+        alpha_max = H_Q_MAX * SF_CANDIDATES[-1] / h_max
+    else:
+        return [1.0]
+    cands = {alpha_max}
+    # breakpoints where the most frequent magnitudes round to an exact level
+    mags = Counter()
+    for v, cnt in j_hist:
+        if v != 0:
+            mags[abs(v)] += cnt
+    for v, _ in mags.most_common(MAX_J_MAGNITUDES):
+        for m in range(1, j_q_max + 1):
+            if m / v <= alpha_max:
+                cands.add(m / v)
+    for k in range(1, ALPHA_GRID + 1):
+        cands.add(alpha_max * k / ALPHA_GRID)
+    return sorted(cands)
+
+
+def quantise(p, j_bits, jobs):
+    """Quantise -J and -h (HIsNegative = 1); returns (alpha, sf, w, hq, error, candidates)."""
+    j_q_max = (1 << (j_bits - 1)) - 1
+    j_hw = {k: -v for k, v in p.j.items()}
+    h_hw = [-v for v in p.h]
+    j_hist = sorted(Counter(j_hw.values()).items())
+    tasks = [(a, j_hist, j_q_max, h_hw) for a in alpha_candidates(j_hist, h_hw, j_q_max)]
+    with ProcessPoolExecutor(max_workers=jobs) as pool:
+        results = list(pool.map(evaluate, tasks, chunksize=max(1, len(tasks) // (4 * jobs))))
+    # lowest error; on ties the largest alpha (widest use of the J range)
+    err, alpha, sf = min(results, key=lambda r: (r[0], -r[1]))
+    w = {k: max(-j_q_max, min(j_q_max, round(alpha * v))) for k, v in j_hw.items()}
+    _, _, hq = h_quantise(alpha, h_hw)
+    return alpha, sf, w, hq, err, len(tasks)
+
+
+def brute_force_check(p, w, hq, sf, energy_scale):
+    """Minimum of the problem and of the decoded core energy over all spin vectors."""
+    best, best_hw = None, None
+    for s in itertools.product((-1, 1), repeat=p.n):
+        e = sum(v * s[i] * s[j] for (i, j), v in p.j.items()) + \
+            sum(p.h[i] * s[i] for i in range(p.n))
+        e_hw = -(sum(v * s[i] * s[j] for (i, j), v in w.items()) +
+                 sf * sum(hq[i] * s[i] for i in range(p.n)))
+        obj = e * p.scale + p.const
+        obj_hw = e_hw * energy_scale + p.const
+        if best is None or obj < best:
+            best = obj
+        if best_hw is None or obj_hw < best_hw[0] or (obj_hw == best_hw[0] and obj < best_hw[1]):
+            best_hw = (obj_hw, obj)
+    return best, best_hw[0], best_hw[1]
+
+
+def self_test(jobs):
+    """Compile tiny instances that quantise exactly and check them by brute force."""
+    cycle = IsingProblem(4)   # Max-Cut of a 4-node cycle, cut 4
+    for i in range(4):
+        cycle.add_j(i, (i + 1) % 4, 1.0)
+    cycle.scale = 0.5
+    cycle.const = -2.0
+    qubo = qubo_to_ising(3, {(0, 0): -1.0, (1, 1): -1.0, (2, 2): 2.0, (0, 1): 2.0, (1, 2): -3.0})
+    failed = 0
+    for name, p, expected in (("4-cycle Max-Cut", cycle, -4.0), ("3-variable QUBO", qubo, -2.0)):
+        alpha, sf, w, hq, _, _ = quantise(p, J_BITS, jobs)
+        best, best_hw, _ = brute_force_check(p, w, hq, sf, p.scale / alpha)
+        ok = abs(best - expected) < 1e-9 and abs(best_hw - expected) < 1e-9
+        print(f"  {name:16s}: minimum {best:g}, decoded core minimum {best_hw:g}"
+              f" ({'ok' if ok else 'FAILED'})")
+        failed += not ok
+    return failed
+
+
+def write_model(path, n, w, hq, sf, offset, energy_scale, pack_offsets=None):
+    def bits(v, width):
+        return format(v & ((1 << width) - 1), f"0{width}b")
+
+    rows = [[0] * NUM_SPIN for _ in range(NUM_SPIN)]
+    for (i, j), v in w.items():
+        rows[i][j] = v
+        rows[j][i] = v
+    with open(path, "w") as f:
+        f.write("# J matrix\n")
+        for row in rows:
+            f.write(" ".join(bits(v, J_BITS) for v in row) + "\n")
+        f.write("# h vector\n")
+        for i in range(NUM_SPIN):
+            f.write(bits(hq[i] if i < n else 0, H_BITS) + "\n")
+        f.write("# offset\n")
+        f.write(f"{offset!r}\n")
+        f.write("# scaling_factor\n")
+        f.write(f"{sf}\n")
+        f.write("# energy_scale\n")
+        f.write(f"{energy_scale!r}\n")
+        if pack_offsets:
+            f.write("# pack_blocks_log2\n")
+            f.write(f"{(len(pack_offsets) - 1).bit_length()}\n")
+            f.write("# pack_offset\n")
+            for c in pack_offsets:
+                f.write(f"{c!r}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile a QUBO/Max-Cut problem to a model.")
+    parser.add_argument("input", nargs="*",
+                        help="Problem file(s), several files are packed on the diagonal of J")
+    parser.add_argument("--format", choices=["qubo", "gset", "dense"])
+    parser.add_argument("--dense-kind", choices=["qubo", "ising"], default="qubo",
+                        help="Meaning of a dense matrix: a QUBO matrix, or Ising J with"
+                             " E = 1/2 sum_ij J_ij s_i s_j to minimise (default: qubo)")
+    parser.add_argument("--folder", type=str, default="compiled",
+                        help="Folder name under sw/tests/data/ to write model to"
+                             " (default: compiled)")
+    parser.add_argument("--j-bits", type=int, choices=[2, 4], default=J_BITS,
+                        help=f"J precision to quantise for, see gen_model_data.py"
+                             f" (default: {J_BITS})")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1,
+                        help="Worker processes for the quantisation search")
+    parser.add_argument("--self-test", action="store_true",
+                        help="Check the compiler on built-in instances by brute force and exit")
+    args = parser.parse_args()
+
+    if args.self_test:
+        print("Self test")
+        sys.exit(1 if self_test(args.jobs) else 0)
+    if not args.input or not args.format:
+        parser.error("input file(s) and --format are required")
+
+    problems = []
+    for path in args.input:
+        if args.format == "qubo":
+            problems.append(read_qubo(path))
+        elif args.format == "gset":
+            problems.append(read_gset(path))
+        else:
+            problems.append(read_dense(path, args.dense_kind))
+    pack_offsets = None
+    if len(problems) > PACK_BLOCKS:
+        print(f"{len(problems)} problems given, the core packs at most {PACK_BLOCKS}")
+        sys.exit(1)
+    elif len(problems) > 1:
+        try:
+            p, blocks_log2 = pack_problems(problems)
+        except ValueError as e:
+            print(f"Cannot pack: {e}")
+            sys.exit(1)
+        pack_offsets = [q.const for q in problems]
+        pack_offsets += [0.0] * ((1 << blocks_log2) - len(problems))
+        p.const = sum(pack_offsets)
+    else:
+        p = problems[0]
+    if p.n > NUM_SPIN:
+        print(f"Problem has {p.n} variables, the core supports at most {NUM_SPIN}")
+        sys.exit(1)
+
+    alpha, sf, w, hq, err, n_cand = quantise(p, args.j_bits, args.jobs)
+    energy_scale = p.scale / alpha
+    rms = (err / max(1, len(p.j) + p.n)) ** 0.5
+
+    out_dir = os.path.join(SW_DIR, "tests/data", args.folder)
+    os.makedirs(out_dir, exist_ok=True)
+    out = os.path.join(out_dir, "model")
+    write_model(out, p.n, w, hq, sf, p.const, energy_scale, pack_offsets)
+
+    print(f"Generated {out}")
+    print(f"  spins        : {p.n} ({len(p.j)} couplings)")
+    print(f"  alpha        : {alpha:.6g} (best of {n_cand} candidates)")
+    print(f"  scaling      : {sf}")
+    print(f"  rms error    : {rms:.6g} (problem units)")
+    print(f"  objective    : E_hw * {energy_scale:.6g} + {p.const:.6g}")
+    if p.n <= CHECK_MAX_SPINS:
+        best, best_hw, reached = brute_force_check(p, w, hq, sf, energy_scale)
+        print(f"  brute force  : minimum {best:.6g}, decoded E_hw minimum {best_hw:.6g}")
+        if abs(reached - best) > 1e-9 * max(1.0, abs(best)):
+            print(f"Warning: the core minimum reaches {reached:.6g}, the quantisation loses"
+                  f" the optimum")
+    if pack_offsets:
+        print(f"  packing      : {len(pack_offsets)} blocks of {NUM_SPIN // len(pack_offsets)} spins"
+              f" (lagd_enable_pack(core, {(len(pack_offsets) - 1).bit_length()}))")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+# Copyright 2025 KU Leuven.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+#
+# Generates the flip schedules clusters_1 and clusters_2 of a model from its J coupling graph,
+# so a new instance does not need the external cluster tool. Several folders are processed in
+# parallel (one worker process per instance).
+#
+# Each schedule has NUM_CLUSTERS flip icons. Icon bit k flips bit k of the spin vector, which is
+# model spin NUM_SPIN-1-k (character k of a line counted from the right, as gen_flip_data.py packs
+# it), so model spin i is character i of the line, as in the J layout. The number of flipped spins
+# follows an annealing curve from --start-frac to --end-frac of the spins (the shape of the
+# default schedules). Icons cycle through three cluster kinds, each grown to the target size:
+#   - neighbourhood clusters: breadth-first from a random seed spin, strongest couplings first
+#   - independent sets: one colour class of a greedy colouring of the J graph (spins that are
+#     not coupled to each other), completed from the next classes if it is too small
+#   - multi-scale clusters: a neighbourhood cluster of a random size between 1 and the target
+# clusters_1 and clusters_2 (spin FIFO entries 0 and 1) use different random streams.
+#
+# Output: sw/tests/data/<folder>/clusters_1 and clusters_2 (the layout gen_flip_data.py reads),
+# and with --bin <folder>/model_f_data.bin, the interleaved flip memory image (1024 x 256-bit,
+# little-endian) that can be copied into the flip memory as is.
+# Existing clusters_1/clusters_2 files (the golden schedules of the data folders) are only
+# overwritten with --force.
+# Usage: python3 gen_clusters.py --folder g1 [g2 ...] [--seed 1] [--bin] [--force]
+
+import os
+import math
+import random
+import argparse
+from concurrent.futures import ProcessPoolExecutor
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+SW_DIR = os.path.join(SCRIPT_DIR, "..")
+
+# Same constants as gen_model_data.py / gen_flip_data.py
+NUM_SPIN = 256
+J_BITS = 4
+NUM_CLUSTERS = 512
+NUM_SCHEDULES = 2
+
+
+def read_graph(path):
+    """Return the adjacency list (neighbour, |J|) of every spin, strongest first."""
+    with open(path) as f:
+        lines = f.readlines()
+    adj = [[] for _ in range(NUM_SPIN)]
+    for i in range(NUM_SPIN):
+        for j, tok in enumerate(lines[1 + i].split()):
+            v = int(tok, 2)
+            v = v - (1 << J_BITS) if v >= (1 << (J_BITS - 1)) else v
+            if v != 0 and i != j:
+                adj[i].append((j, abs(v)))
+    for a in adj:
+        a.sort(key=lambda e: -e[1])
+    return adj
+
+
+def greedy_colouring(adj):
+    """Colour classes of a largest-degree-first greedy colouring."""
+    colour = [-1] * NUM_SPIN
+    for i in sorted(range(NUM_SPIN), key=lambda i: -len(adj[i])):
+        used = {colour[j] for j, _ in adj[i]}
+        c = 0
+        while c in used:
+            c += 1
+        colour[i] = c
+    classes = [[] for _ in range(max(colour) + 1)]
+    for i, c in enumerate(colour):
+        classes[c].append(i)
+    return classes
+
+
+def neighbourhood_cluster(adj, size, rng):
+    cluster = set()
+    while len(cluster) < size:
+        seed = rng.choice([i for i in range(NUM_SPIN) if i not in cluster])
+        frontier = [seed]
+        cluster.add(seed)
+        while frontier and len(cluster) < size:
+            nxt = []
+            for i in frontier:
+                for j, _ in adj[i]:
+                    if j not in cluster and len(cluster) < size:
+                        cluster.add(j)
+                        nxt.append(j)
+            frontier = nxt
+    return cluster
+
+
+def independent_cluster(classes, size, rng, turn):
+    cluster = set()
+    for k in range(len(classes)):
+        members = classes[(turn + k) % len(classes)]
+        need = size - len(cluster)
+        cluster.update(members if len(members) <= need else rng.sample(members, need))
+        if len(cluster) >= size:
+            break
+    return cluster
+
+
+def flip_count(t, start, end):
+    """Annealing curve: exponential decay from start to end spins over the schedule."""
+    tau = NUM_CLUSTERS / 5
+    return max(1, round(end + (start - end) * math.exp(-t / tau)))
+
+
+def icon_of(cluster):
+    """Flip icon of a set of model spins: model spin i is spin vector bit NUM_SPIN-1-i."""
+    return sum(1 << (NUM_SPIN - 1 - i) for i in cluster)
+
+
+def spins_of(icon):
+    """Model spins flipped by an icon."""
+    return {NUM_SPIN - 1 - k for k in range(NUM_SPIN) if (icon >> k) & 1}
+
+
+def build_schedule(adj, classes, rng, start, end):
+    icons = []
+    for t in range(NUM_CLUSTERS):
+        size = flip_count(t, start, end)
+        kind = t % 3
+        if kind == 0:
+            cluster = neighbourhood_cluster(adj, size, rng)
+        elif kind == 1:
+            cluster = independent_cluster(classes, size, rng, t // 3)
+        else:
+            cluster = neighbourhood_cluster(adj, rng.randint(1, size), rng)
+        icon = icon_of(cluster)
+        assert spins_of(icon) == cluster, f"icon {t} does not decode to its cluster"
+        icons.append(icon)
+    return icons
+
+
+def write_clusters(path, icons):
+    with open(path, "w") as f:
+        f.write("0" * NUM_SPIN + "\n")   # line 1 is skipped by gen_flip_data.py
+        for v in icons:
+            f.write(format(v, f"0{NUM_SPIN}b") + "\n")
+
+
+def check_clusters(path, icons):
+    """Read a written schedule back: character i of a line is model spin i."""
+    with open(path) as f:
+        lines = f.readlines()[1:]
+    for t, (line, icon) in enumerate(zip(lines, icons)):
+        spins = {i for i, c in enumerate(line.strip()) if c == "1"}
+        assert spins == spins_of(icon), f"{path} line {t + 2}: spins do not match the icon"
+
+
+def write_bin(path, schedules):
+    with open(path, "wb") as f:
+        for t in range(NUM_CLUSTERS):
+            for s in schedules:
+                f.write(s[t].to_bytes(NUM_SPIN // 8, "little"))
+
+
+def generate(job):
+    folder, seed, start_frac, end_frac, write_binary, force = job
+    data_dir = os.path.join(SW_DIR, "tests/data", folder)
+    for k in range(NUM_SCHEDULES):
+        path = os.path.join(data_dir, f"clusters_{k + 1}")
+        if os.path.exists(path) and not force:
+            raise SystemExit(f"{path} exists, use --force to overwrite it")
+    adj = read_graph(os.path.join(data_dir, "model"))
+    classes = greedy_colouring(adj)
+    start = round(start_frac * NUM_SPIN)
+    end = round(end_frac * NUM_SPIN)
+    schedules = []
+    for k in range(NUM_SCHEDULES):
+        rng = random.Random(f"{seed}/{folder}/{k}")
+        schedules.append(build_schedule(adj, classes, rng, start, end))
+        path = os.path.join(data_dir, f"clusters_{k + 1}")
+        write_clusters(path, schedules[-1])
+        check_clusters(path, schedules[-1])
+    if write_binary:
+        write_bin(os.path.join(data_dir, "model_f_data.bin"), schedules)
+    edges = sum(len(a) for a in adj) // 2
+    return f"{folder}: {edges} couplings, {len(classes)} colours, {start} -> {end} flips/icon"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate flip schedules from the J graph.")
+    parser.add_argument("--folder", nargs="+", required=True,
+                        help="Folder names under sw/tests/data/ containing model")
+    parser.add_argument("--seed", type=int, default=1, help="Random seed (default: 1)")
+    parser.add_argument("--start-frac", type=float, default=0.8,
+                        help="Fraction of spins flipped by the first icon (default: 0.8)")
+    parser.add_argument("--end-frac", type=float, default=0.0625,
+                        help="Fraction of spins flipped by the last icons (default: 0.0625)")
+    parser.add_argument("--bin", action="store_true",
+                        help="Also write the flip memory image model_f_data.bin")
+    parser.add_argument("--force", action="store_true",
+                        help="Overwrite existing clusters_1/clusters_2 files")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1,
+                        help="Worker processes (one instance each)")
+    args = parser.parse_args()
+
+    jobs = [(f, args.seed, args.start_frac, args.end_frac, args.bin, args.force)
+            for f in args.folder]
+    with ProcessPoolExecutor(max_workers=min(args.jobs, len(jobs))) as pool:
+        for line in pool.map(generate, jobs):
+            print(f"Generated {line}")
+
+
+if __name__ == "__main__":
+    main()
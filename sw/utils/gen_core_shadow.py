@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+# Copyright 2025 KU Leuven.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+#
+# Generate the shadowed register driver (lagd_core_shadow.h) from lagd_core_regs.hjson.
+#
+# Every software-writable configuration register (swaccess rw, hwaccess hro) gets a per-core
+# shadow copy in the host memory, so that updating a field never reads the register back over the
+# bus. For each register <reg> and field <field>, the header provides:
+#   lagd_stage_<reg>_<field>(core, v)  update the field in the shadow only (no bus access)
+#   lagd_commit_<reg>(core)            write the shadow to the register (one store)
+#   lagd_write_<reg>_<field>(core, v)  stage + commit
+#   lagd_write_<reg>(core, v)          write the whole register (shadow + one store)
+#   lagd_shadow_<reg>(core)            shadow value
+# Multiregs take an extra index after core. Several fields of one register are batched into a
+# single store by staging them and committing once. All functions are static inline with constant
+# masks and offsets, so with a constant core index a commit is a single store to a fixed address.
+# The shadow starts at the reset values; lagd_sync_shadow(core) reloads it from the registers.
+# The shadow array is declared extern and defined in the one translation unit of a program that
+# defines LAGD_SHADOW_IMPL before including the header (sw/Makefile sets it for the test sources,
+# each test program being a single translation unit), so all files share the same shadow.
+#
+# Usage:
+#   python3 gen_core_shadow.py <lagd_core_regs.hjson> <lagd_core_shadow.h>
+
+import sys
+import hjson
+
+PREFIX = "LAGD_CORE"
+
+
+def parse_int(s):
+    return int(str(s), 0)
+
+
+def field_range(bits):
+    msb, _, lsb = str(bits).partition(":")
+    msb = int(msb)
+    lsb = int(lsb) if lsb else msb
+    return lsb, msb - lsb + 1
+
+
+def shadowed_registers(regs):
+    """(name, count, desc, fields) of every rw/hro register; count is None for single registers."""
+    out = []
+    for entry in regs:
+        count = None
+        if "multireg" in entry:
+            entry = entry["multireg"]
+            count = parse_int(entry["count"])
+        if "name" not in entry:
+            continue
+        if entry.get("swaccess") != "rw" or entry.get("hwaccess") != "hro":
+            continue
+        fields = []
+        resval = 0
+        for f in entry["fields"]:
+            lsb, width = field_range(f["bits"])
+            mask = (1 << width) - 1
+            resval |= (parse_int(f.get("resval", "0")) & mask) << lsb
+            fields.append((f["name"].lower(), lsb, mask, f.get("desc", "")))
+        out.append((entry["name"].lower(), count, entry.get("desc", ""), fields, resval))
+    return out
+
+
+def reg_offset(name, count):
+    # regtool names the first register of a multireg <name>_0
+    return f"{PREFIX}_{name.upper()}{'_0' if count else ''}_REG_OFFSET"
+
+
+def emit(regs):
+    lines = []
+    w = lines.append
+    w("// Generated by sw/utils/gen_core_shadow.py from lagd_core_regs.hjson, do not edit.")
+    w("//")
+    w("// Shadowed configuration registers, see gen_core_shadow.py for the interface.")
+    w("")
+    w("#pragma once")
+    w("")
+    w("#include <stdint.h>")
+    w('#include "lagd_define.h"')
+    w('#include "lagd_core_reg.h"')
+    w("")
+    w("#define LAGD_CORE_REG(core, offset) \\")
+    w("    (*(volatile uint32_t *)((uintptr_t)IC_REGS_BASE_ADDR + \\")
+    w("                            (uintptr_t)(core) * IC_NUM_REGS + (offset)))")
+    w("")
+    w("typedef struct {")
+    for name, count, _, _, _ in regs:
+        w(f"    uint32_t {name}{f'[{count}]' if count else ''};")
+    w("} lagd_core_shadow_t;")
+    w("")
+    w("#define LAGD_CORE_SHADOW_RESVAL \\")
+    w("    { \\")
+    for name, count, _, _, resval in regs:
+        val = f"0x{resval:08x}"
+        init = f"{{[0 ... {count - 1}] = {val}}}" if count else val
+        w(f"        .{name} = {init}, \\")
+    w("    }")
+    w("")
+    w("// One shadow per program, defined where LAGD_SHADOW_IMPL is set")
+    w("extern lagd_core_shadow_t lagd_core_shadow[NUM_ISING_CORES];")
+    w("#ifdef LAGD_SHADOW_IMPL")
+    w("lagd_core_shadow_t lagd_core_shadow[NUM_ISING_CORES] = {")
+    w("    [0 ... NUM_ISING_CORES - 1] = LAGD_CORE_SHADOW_RESVAL};")
+    w("#endif")
+    w("")
+    w("// Reload the shadow of a core from its registers")
+    w("static inline void lagd_sync_shadow(unsigned core) {")
+    for name, count, _, _, _ in regs:
+        off = reg_offset(name, count)
+        if count:
+            w(f"    for (unsigned i = 0; i < {count}; i++)")
+            w(f"        lagd_core_shadow[core].{name}[i] = LAGD_CORE_REG(core, {off} + 4 * i);")
+        else:
+            w(f"    lagd_core_shadow[core].{name} = LAGD_CORE_REG(core, {off});")
+    w("}")
+    for name, count, desc, fields, _ in regs:
+        off = reg_offset(name, count)
+        idx_arg = ", unsigned idx" if count else ""
+        idx_use = ", idx" if count else ""
+        sh = f"lagd_core_shadow[core].{name}{'[idx]' if count else ''}"
+        addr = f"{off} + 4 * idx" if count else off
+        w("")
+        w(f"// {name}: {desc}")
+        w(f"static inline uint32_t lagd_shadow_{name}(unsigned core{idx_arg}) {{ return {sh}; }}")
+        w(f"static inline void lagd_commit_{name}(unsigned core{idx_arg}) {{")
+        w(f"    LAGD_CORE_REG(core, {addr}) = {sh};")
+        w("}")
+        w(f"static inline void lagd_write_{name}(unsigned core{idx_arg}, uint32_t v) {{")
+        w(f"    {sh} = v;")
+        w(f"    lagd_commit_{name}(core{idx_use});")
+        w("}")
+        if len(fields) == 1 and fields[0][2] == 0xFFFFFFFF:
+            continue
+        for fname, lsb, mask, _ in fields:
+            w(f"static inline void lagd_stage_{name}_{fname}(unsigned core{idx_arg}, uint32_t v) {{")
+            w(f"    {sh} = ({sh} & ~(0x{mask:x}u << {lsb})) | ((v & 0x{mask:x}u) << {lsb});")
+            w("}")
+            w(f"static inline void lagd_write_{name}_{fname}(unsigned core{idx_arg}, uint32_t v) {{")
+            w(f"    lagd_stage_{name}_{fname}(core{idx_use}, v);")
+            w(f"    lagd_commit_{name}(core{idx_use});")
+            w("}")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(f"Usage: {sys.argv[0]} <lagd_core_regs.hjson> <lagd_core_shadow.h>")
+        sys.exit(1)
+    with open(sys.argv[1]) as f:
+        top = hjson.load(f)
+    regs = shadowed_registers(top["registers"])
+    with open(sys.argv[2], "w") as f:
+        f.write(emit(regs))
+    print(f"Generated {sys.argv[2]} ({len(regs)} shadowed registers)")
+
+
+if __name__ == "__main__":
+    main()
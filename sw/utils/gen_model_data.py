@@ -9,10 +9,19 @@
 # Output: sw/include/model_j_data{args.suffix}.h
 #   - model_j_data{args.suffix}[4096]    : J coupling matrix, 256x256 J_BITS-bit signed integers
 #                             packed MSB-first into uint64_t, groups in reversed column order
+#                             (2048 words when --j-bits 2, read with j_precision_2b set; a J
+#                             that does not fit is rescaled, and h, the scaling factor and the
+#                             energy scale follow so the model solves the same problem)
+#   - MODEL_J_BITS{SUFFIX}               : precision J is packed at (2 or 4)
+#   - the MODEL_* macros carry the upper-case suffix, so headers of different precision can be
+#     included together (e.g. MODEL_J_LEN_2B of model_j_data_2b.h)
 #   - model_h_data{args.suffix}[32]      : h bias vector, 256 H_BITS-bit signed integers,
 #                             packed MSB-first into uint32_t
 #   - model_offset{args.suffix}          : offset (double)
 #   - model_scaling_factor{args.suffix}  : SF_BITS-bit positive integer, stored as uint8_t
+#   - model_energy_scale{args.suffix}    : objective = energy * energy_scale + offset (double)
+#   - MODEL_PACK_BLOCKS_LOG2, model_pack_offset{args.suffix}[] : packed models only, problem b =
+#                             block energy b * energy_scale + pack_offset[b] (double)
 
 import argparse
 import os
@@ -29,9 +38,15 @@ SW_DIR = os.path.join(SCRIPT_DIR, "..")
 #   Line 516      : offset value (decimal float)
 #   Line 517      : "# scaling_factor"
 #   Line 518      : scaling factor value (SF_BITS-bit positive integer)
+#   Line 519      : "# energy_scale" (optional, written by compile_model.py)
+#   Line 520      : energy scale value (decimal float, default: 1.0)
+#   Line 521      : "# pack_blocks_log2" (optional, packed models of compile_model.py)
+#   Line 522      : log2 of the number of packed blocks n
+#   Line 523      : "# pack_offset"
+#   Lines 524-    : 2^n per-block offsets (decimal float)
 
 # --- Global bitwidth parameters (change here to adapt all derived constants) ---
-J_BITS = 4   # bit width of each J element
+J_BITS = 4   # bit width of each J element in the model file
 H_BITS = 4   # bit width of each h element
 SF_BITS = 6   # bit width of scaling factor
 
@@ -58,6 +73,13 @@ def parse_args() -> argparse.Namespace:
         default="",
         help="Output name suffix (default: "").",
     )
+    parser.add_argument(
+        "--j-bits",
+        type=int,
+        choices=[2, 4],
+        default=J_BITS,
+        help=f"Precision J is quantised and packed at (default: {J_BITS}).",
+    )
     return parser.parse_args()
 
 
@@ -65,11 +87,13 @@ args = parse_args()
 core_onload = args.core_onload
 INPUT_FILE = os.path.join(SW_DIR, "tests/data", args.folder, "model")
 OUTPUT_FILE = os.path.join(SW_DIR, "include", f"model_j_data{args.suffix}.h")
+SUFFIX = args.suffix.upper()
 
 # --- Derived constants ---
 J_ROWS = 256
 J_COLS = 256
-J_ELEMS_PER_U64 = 64 // J_BITS                  # elements packed per uint64_t word
+J_PACK_BITS = args.j_bits                    # bit width of each packed J element
+J_ELEMS_PER_U64 = 64 // J_PACK_BITS             # elements packed per uint64_t word
 U64_PER_ROW = J_COLS // J_ELEMS_PER_U64     # uint64_t words per J row
 J_LEN = J_ROWS * U64_PER_ROW          # total uint64_t words for J
 
@@ -81,6 +105,40 @@ SF_MAX = (1 << SF_BITS) - 1            # max valid scaling factor value
 H_SIGN_THRESH = 1 << (H_BITS - 1)             # sign bit threshold for h
 H_NEG_OFFSET = 1 << H_BITS                   # subtracted to sign-extend h
 H_MASK = (1 << H_BITS) - 1             # mask to recover H_BITS bit pattern
+J_SIGN_THRESH = 1 << (J_BITS - 1)             # sign bit threshold for J
+J_PACK_MAX = (1 << (J_PACK_BITS - 1)) - 1     # largest packed J magnitude (symmetric range)
+J_PACK_MASK = (1 << J_PACK_BITS) - 1          # mask to recover J_PACK_BITS bit pattern
+
+
+def quantise_j(rows):
+    """Quantise signed J values to J_PACK_BITS bits; returns (rows, ratio).
+
+    Models that already fit the packed range are kept as is (ratio 1). Otherwise J is rescaled
+    by its largest magnitude to the symmetric range [-J_PACK_MAX, J_PACK_MAX] and rounded, and
+    the caller scales the h term and the energy scale by the same ratio (see rescale_h).
+    """
+    j_max = max(abs(v) for row in rows for v in row)
+    if all(-J_PACK_MAX - 1 <= v <= J_PACK_MAX for row in rows for v in row):
+        return rows, 1.0
+    ratio = J_PACK_MAX / j_max
+    print(f"Warning: J range exceeds {J_PACK_BITS} bits, rescaling J, h and the energy scale"
+          f" by {J_PACK_MAX}/{j_max}")
+    return [[int(round(v * ratio)) for v in row] for row in rows], ratio
+
+
+def rescale_h(h, sf, ratio):
+    """Scale the h term sf * h by ratio; returns (h, sf).
+
+    The scaling factor takes the ratio first; when it cannot go lower than 1, the rest is
+    applied to h, rounded and clamped to H_BITS bits.
+    """
+    if ratio == 1.0 or sf == 0:
+        return h, sf
+    new_sf = max(1, round(sf * ratio))
+    k = sf * ratio / new_sf
+    h_min, h_max = -H_SIGN_THRESH, H_SIGN_THRESH - 1
+    return [max(h_min, min(h_max, int(round(v * k)))) for v in h], new_sf
+
 
 with open(INPUT_FILE, 'r') as f:
     lines = f.readlines()
@@ -89,19 +147,29 @@ with open(INPUT_FILE, 'r') as f:
 # Groups within each row are stored in reversed column order:
 # the last J_ELEMS_PER_U64 elements become word[0], the second-to-last become word[1], etc.
 # Within each group the MSB-first packing is preserved.
-j_u64 = []
+# At 2-bit precision each row takes half the space, so one 4096-bit L1 word holds 8 rows.
+j_rows = []
 for row_idx in range(J_ROWS):
     line = lines[1 + row_idx]
-    elems = [int(tok, 2) for tok in line.split()]
-    assert len(elems) == J_COLS, \
-        f"J row {row_idx}: expected {J_COLS} elements, got {len(elems)}"
+    raw = [int(tok, 2) for tok in line.split()]
+    assert len(raw) == J_COLS, \
+        f"J row {row_idx}: expected {J_COLS} elements, got {len(raw)}"
+    j_rows.append([v if v < J_SIGN_THRESH else v - (1 << J_BITS) for v in raw])
+
+j_ratio = 1.0
+if J_PACK_BITS != J_BITS:
+    j_rows, j_ratio = quantise_j(j_rows)
+
+j_u64 = []
+for row in j_rows:
+    elems = [v & J_PACK_MASK for v in row]
     groups = [elems[i:i + J_ELEMS_PER_U64]
               for i in range(0, J_COLS, J_ELEMS_PER_U64)]
     groups = groups[::-1]   # reverse group order
     for group in groups:
         word = 0
         for n in group:
-            word = (word << J_BITS) | n
+            word = (word << J_PACK_BITS) | n
         j_u64.append(word)
 
 assert len(j_u64) == J_LEN, f"Expected {J_LEN} uint64_t, got {len(j_u64)}"
@@ -117,6 +185,22 @@ for i in range(H_LEN):
 
 assert len(h_vals) == H_LEN
 
+# --- Parse offset (line 516, 0-indexed 515) ---
+offset = float(lines[515].strip())
+
+# --- Parse scaling factor (line 518, 0-indexed 517) ---
+scaling_factor = int(lines[517].strip())
+assert 0 <= scaling_factor <= SF_MAX, \
+    f"Scaling factor {scaling_factor} out of {SF_BITS}-bit range (0-{SF_MAX})"
+
+# --- Parse optional energy scale (line 520, 0-indexed 519) ---
+energy_scale = float(lines[519].strip()) if len(lines) > 519 else 1.0
+
+# A rescaled J keeps the same problem: the h term follows J, and the energies are ratio times
+# the ones of the model (the objective is unchanged through energy_scale)
+h_vals, scaling_factor = rescale_h(h_vals, scaling_factor, j_ratio)
+energy_scale /= j_ratio
+
 h_u32 = []
 for i in range(H_LEN-H_ELEMS_PER_U32, -1, -H_ELEMS_PER_U32):
     word = 0
@@ -126,13 +210,11 @@ for i in range(H_LEN-H_ELEMS_PER_U32, -1, -H_ELEMS_PER_U32):
 
 assert len(h_u32) == H_U32_LEN
 
-# --- Parse offset (line 516, 0-indexed 515) ---
-offset = float(lines[515].strip())
-
-# --- Parse scaling factor (line 518, 0-indexed 517) ---
-scaling_factor = int(lines[517].strip())
-assert 0 <= scaling_factor <= SF_MAX, \
-    f"Scaling factor {scaling_factor} out of {SF_BITS}-bit range (0-{SF_MAX})"
+# --- Parse optional pack section (line 522 and lines 524-, 0-indexed 521 and 523-) ---
+pack_blocks_log2 = int(lines[521].strip()) if len(lines) > 521 else None
+pack_offset = []
+if pack_blocks_log2 is not None:
+    pack_offset = [float(lines[523 + b].strip()) for b in range(1 << pack_blocks_log2)]
 
 # --- Compute XOR checksums ---
 j_xor = 0
@@ -156,14 +238,15 @@ with open(OUTPUT_FILE, 'w') as f:
     f.write("\n")
 
     # J matrix
-    f.write(f"// J coupling matrix: {J_ROWS}x{J_COLS} {J_BITS}-bit signed integers,\n")
+    f.write(f"// J coupling matrix: {J_ROWS}x{J_COLS} {J_PACK_BITS}-bit signed integers,\n")
     f.write(f"// packed MSB-first into uint64_t ({J_ELEMS_PER_U64} elements per word),\n")
     f.write("// groups stored in reversed column order\n")
-    f.write(f"#define MODEL_J_ROWS {J_ROWS}\n")
-    f.write(f"#define MODEL_J_COLS {J_COLS}\n")
-    f.write(f"#define MODEL_J_LEN  {J_LEN}"
+    f.write(f"#define MODEL_J_ROWS{SUFFIX} {J_ROWS}\n")
+    f.write(f"#define MODEL_J_COLS{SUFFIX} {J_COLS}\n")
+    f.write(f"#define MODEL_J_BITS{SUFFIX} {J_PACK_BITS}\n")
+    f.write(f"#define MODEL_J_LEN{SUFFIX}  {J_LEN}"
             f"  // {J_ROWS}*{U64_PER_ROW} uint64_t = {J_LEN * 8 // 1024}KB\n")
-    f.write(f"static const uint64_t model_j_data{args.suffix}[MODEL_J_LEN]"
+    f.write(f"static const uint64_t model_j_data{args.suffix}[MODEL_J_LEN{SUFFIX}]"
             f" __attribute__((used, section(\".l1j_data_c{core_onload}\"))) = {{\n")
     for i, v in enumerate(j_u64):
         if i % 8 == 0:
@@ -180,10 +263,10 @@ with open(OUTPUT_FILE, 'w') as f:
             f" (range {-H_SIGN_THRESH} to {H_SIGN_THRESH - 1}),\n")
     f.write(f"// packed with first element at LSB into uint32_t"
             f" ({H_ELEMS_PER_U32} elements per word)\n")
-    f.write(f"#define MODEL_H_LEN     {H_LEN}      // total number of h elements\n")
-    f.write(f"#define MODEL_H_U32_LEN {H_U32_LEN:3d}"
+    f.write(f"#define MODEL_H_LEN{SUFFIX}     {H_LEN}      // total number of h elements\n")
+    f.write(f"#define MODEL_H_U32_LEN{SUFFIX} {H_U32_LEN:3d}"
             f"      // number of uint32_t words ({H_LEN}/{H_ELEMS_PER_U32})\n")
-    f.write(f"static const uint32_t model_h_data{args.suffix}[MODEL_H_U32_LEN] = {{\n")
+    f.write(f"static const uint32_t model_h_data{args.suffix}[MODEL_H_U32_LEN{SUFFIX}] = {{\n")
     for i, v in enumerate(h_u32):
         if i % 8 == 0:
             f.write("    ")
@@ -200,11 +283,24 @@ with open(OUTPUT_FILE, 'w') as f:
     f.write(f"// Scaling factor: {SF_BITS}-bit positive integer"
             f" (range 0-{SF_MAX}), stored as uint8_t\n")
     f.write(f"static const uint8_t  model_scaling_factor{args.suffix} = {scaling_factor};\n")
+    f.write("// Objective of the original problem = energy * energy_scale + offset\n")
+    f.write(f"static const double   model_energy_scale{args.suffix}   = {energy_scale};\n")
+
+    # Block-diagonal packing
+    if pack_offset:
+        f.write("\n// Packed model: problem b = block energy b * energy_scale + pack_offset[b]\n")
+        f.write(f"#define MODEL_PACK_BLOCKS_LOG2{SUFFIX} {pack_blocks_log2}\n")
+        f.write(f"static const double   model_pack_offset{args.suffix}[{len(pack_offset)}] = {{"
+                + ", ".join(repr(c) for c in pack_offset) + "};\n")
 
 print(f"Generated {OUTPUT_FILE}")
-print(f"  J matrix : {J_LEN} uint64_t ({J_LEN * 8} bytes = {J_LEN * 8 // 1024} KB)")
+print(f"  J matrix : {J_LEN} uint64_t ({J_LEN * 8} bytes = {J_LEN * 8 // 1024} KB,"
+      f" {J_PACK_BITS}-bit)")
 print(f"  h vector : {H_U32_LEN} uint32_t ({H_LEN} x {H_BITS}-bit elements)")
 print(f"  offset   : {offset}")
 print(f"  scaling  : {scaling_factor}")
+print(f"  e. scale : {energy_scale}")
+if pack_offset:
+    print(f"  packing  : {len(pack_offset)} blocks")
 print(f"  J XOR    : 0x{j_xor:016x}")
 print(f"  h XOR    : 0x{h_xor:08x}")
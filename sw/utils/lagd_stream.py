@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+# Copyright 2025 KU Leuven.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+#
+# Host-side decoder for the binary result stream emitted by sw/include/lagd_stream.h.
+# Accepts either a raw UART capture or a simulation log with '@'-prefixed hex frames
+# (LAGD_STREAM_HEX=1). Can be imported as a library or run to dump the decoded records.
+# Usage: python3 lagd_stream.py [logfile]
+
+import re
+import sys
+import argparse
+import struct
+from dataclasses import dataclass
+
+# Frame constants (keep in sync with sw/include/lagd_stream.h)
+SYNC = b"\xa5\x5a"
+HDR_LEN = 8  # sync(2) + type(1) + core(1) + job_id(2) + len(2)
+CRC_LEN = 2
+
+REC_ENERGY = 0x01
+REC_SPINS = 0x02
+REC_COUNTERS = 0x03
+REC_CYCLE_LOG = 0x04
+REC_ENERGY_DBG_LOG = 0x05
+REC_END = 0x0F
+
+REC_NAMES = {
+    REC_ENERGY: "energy",
+    REC_SPINS: "spins",
+    REC_COUNTERS: "counters",
+    REC_CYCLE_LOG: "cycle_log",
+    REC_ENERGY_DBG_LOG: "energy_dbg_log",
+    REC_END: "end",
+}
+
+HEX_FRAME = re.compile(r"@([0-9a-fA-F]+)")
+
+
+@dataclass
+class Record:
+    type: int
+    core: int
+    job_id: int
+    payload: bytes
+
+    @property
+    def name(self):
+        return REC_NAMES.get(self.type, f"unknown_{self.type:#x}")
+
+    def words(self, offset=0):
+        n = (len(self.payload) - offset) // 4
+        return list(struct.unpack_from(f"<{n}I", self.payload, offset))
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, identical to lagd_stream_crc16()."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def to_signed(val, bits):
+    return val - (1 << bits) if val & (1 << (bits - 1)) else val
+
+
+def _read_stream(path):
+    """Return the byte stream from a raw capture or from '@' hex lines of a text log."""
+    with open(path, "rb") as f:
+        raw = f.read()
+    text = raw.decode("latin-1")
+    hex_frames = HEX_FRAME.findall(text)
+    if hex_frames:
+        return b"".join(bytes.fromhex(h) for h in hex_frames if len(h) % 2 == 0)
+    return raw
+
+
+def decode_bytes(data, strict=False):
+    """Yield Records from a byte stream, resynchronising on sync bytes after errors."""
+    pos = 0
+    bad = 0
+    while True:
+        pos = data.find(SYNC, pos)
+        if pos < 0 or pos + HDR_LEN > len(data):
+            break
+        rtype, core, job_id, length = struct.unpack_from("<BBHH", data, pos + 2)
+        end = pos + HDR_LEN + length
+        if end + CRC_LEN > len(data):
+            break
+        (crc,) = struct.unpack_from("<H", data, end)
+        if crc16(data[pos + 2:end]) != crc:
+            bad += 1
+            if strict:
+                raise ValueError(f"CRC mismatch in frame at byte {pos}")
+            pos += 1
+            continue
+        yield Record(rtype, core, job_id, bytes(data[pos + HDR_LEN:end]))
+        pos = end + CRC_LEN
+    if bad:
+        print(f"Warning: dropped {bad} frame(s) with bad CRC", file=sys.stderr)
+
+
+def decode_file(path, strict=False):
+    return list(decode_bytes(_read_stream(path), strict))
+
+
+# Register field decoding (see hw/rtl/lagd_core_reg/lagd_core_regs.hjson)
+def decode_cycle_per_cmpt_and_iter(val):
+    return {
+        "cmpt_idle": val & 0x1,
+        "fm_rx_cnt_l7b": (val >> 1) & 0x7F,
+        "cc_iter": (val >> 8) & 0x7F,
+        "cc_cmpt": (val >> 15) & 0x1FFFF,
+    }
+
+
+def decode_energy_fifo_dbg(val):
+    return {
+        "cmpt_idle": val & 0x1,
+        "energy_fifo_update": (val >> 1) & 0x1,
+        "flip_q_valid": (val >> 2) & 0x1,
+        "fm_rx_cnt": (val >> 3) & 0x3FF,
+        "energy_fifo_data_sel": to_signed((val >> 13) & 0xFFFF, 16),
+    }
+
+
+def log_samples(records, rtype, core=None, job_id=None):
+    """Reassemble the (idx, raw_word) samples of chunked log records."""
+    samples = []
+    for rec in records:
+        if rec.type != rtype:
+            continue
+        if core is not None and rec.core != core:
+            continue
+        if job_id is not None and rec.job_id != job_id:
+            continue
+        (first,) = struct.unpack_from("<H", rec.payload, 0)
+        for i, word in enumerate(rec.words(2)):
+            samples.append((first + i, word))
+    return samples
+
+
+def cycle_log(records, core=None, job_id=None):
+    return [
+        dict(idx=i, **decode_cycle_per_cmpt_and_iter(w))
+        for i, w in log_samples(records, REC_CYCLE_LOG, core, job_id)
+    ]
+
+
+def energy_dbg_log(records, core=None, job_id=None):
+    return [
+        dict(idx=i, **decode_energy_fifo_dbg(w))
+        for i, w in log_samples(records, REC_ENERGY_DBG_LOG, core, job_id)
+    ]
+
+
+def spins_hex(words):
+    """Format spin words MSB-first, like lagd_print_spin_fifo_data()."""
+    return "".join(f"{w:08x}" for w in reversed(words))
+
+
+def describe(rec):
+    if rec.type == REC_ENERGY:
+        e = rec.words()
+        return f"energy_fifo_data_0/1: 0x{e[0]:08x} 0x{e[1]:08x}"
+    if rec.type == REC_SPINS:
+        w = rec.words()
+        half = len(w) // 2
+        return (
+            f"spin_fifo_data_0: {spins_hex(w[:half])}\n"
+            f"    spin_fifo_data_1: {spins_hex(w[half:])}"
+        )
+    if rec.type == REC_COUNTERS:
+        w = rec.words()
+        cc = decode_cycle_per_cmpt_and_iter(w[1])
+        return f"cmpt_idx: {w[0]}, cc_cmpt: {cc['cc_cmpt']}, cycle_all_cmpt: {(w[3] << 32) | w[2]}"
+    if rec.type in (REC_CYCLE_LOG, REC_ENERGY_DBG_LOG):
+        (first,) = struct.unpack_from("<H", rec.payload, 0)
+        return f"samples {first}..{first + len(rec.words(2)) - 1}"
+    return ""
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a LAGD binary result stream.")
+    parser.add_argument("logfile", nargs="?", default="sim1.log", help="Log/capture file to decode")
+    parser.add_argument("--strict", action="store_true", help="Abort on CRC errors")
+    args = parser.parse_args()
+
+    records = decode_file(args.logfile, args.strict)
+    if not records:
+        print(f"No frames found in {args.logfile}")
+        sys.exit(1)
+    for rec in records:
+        print(f"[job {rec.job_id} core {rec.core}] {rec.name}: {describe(rec)}")
+
+
+if __name__ == "__main__":
+    main()
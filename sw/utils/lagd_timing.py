@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+# Copyright 2025 KU Leuven.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+#
+# Host-side parser for the phase timing records printed by lagd_timing_dump()
+# (sw/include/lagd_timing.h, built with LAGD_TIMING=1). The records of one or more UART/simulation
+# logs are aggregated per core and phase (count, min, mean, p50, p99, max in us), so runs before
+# and after an optimisation can be compared.
+# Usage: python3 lagd_timing.py sim1.log [sim2.log ...] [--by-job] [--csv out.csv]
+
+import re
+import sys
+import csv
+import argparse
+from collections import defaultdict
+
+# Phases in job order (keep in sync with lagd_phase_name in sw/include/lagd_timing.h)
+PHASES = ["config", "onload", "compute", "readout"]
+
+RTC_LINE = re.compile(r"TIMING_RTC (\d+)")
+REC_LINE = re.compile(r"TIMING (\d+) (\d+) (\w+) (\d+) (\d+)")
+
+
+def parse_log(path):
+    """Return the records (job, core, phase, start, us) of a log."""
+    rtc_freq = None
+    records = []
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = RTC_LINE.search(line)
+            if m:
+                rtc_freq = int(m.group(1))
+                continue
+            m = REC_LINE.search(line)
+            if not m:
+                continue
+            if rtc_freq is None:
+                raise ValueError(f"{path}: TIMING record before TIMING_RTC")
+            job, core, phase, start, ticks = m.groups()
+            records.append((int(job), int(core), phase, int(start), int(ticks) * 1e6 / rtc_freq))
+    return records
+
+
+def percentile(sorted_vals, p):
+    """Nearest-rank percentile, the same definition as lagd_timing_report()."""
+    idx = max(0, -(-p * len(sorted_vals) // 100) - 1)
+    return sorted_vals[idx]
+
+
+def summarise(records, by_job=False):
+    groups = defaultdict(list)
+    for job, core, phase, _, us in records:
+        groups[(job if by_job else None, core, phase)].append(us)
+    rows = []
+    order = {p: i for i, p in enumerate(PHASES)}
+    for (job, core, phase), vals in sorted(groups.items(),
+                                           key=lambda kv: (kv[0][0] or 0, kv[0][1],
+                                                           order.get(kv[0][2], len(PHASES)))):
+        vals.sort()
+        rows.append({
+            "job": job, "core": core, "phase": phase, "n": len(vals),
+            "min_us": vals[0], "mean_us": sum(vals) / len(vals),
+            "p50_us": percentile(vals, 50), "p99_us": percentile(vals, 99), "max_us": vals[-1],
+        })
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Aggregate LAGD phase timing records.")
+    parser.add_argument("logfile", nargs="+", help="Log files with TIMING lines")
+    parser.add_argument("--by-job", action="store_true", help="Report every job separately")
+    parser.add_argument("--csv", type=str, help="Also write the summary to a CSV file")
+    args = parser.parse_args()
+
+    records = []
+    for path in args.logfile:
+        records += parse_log(path)
+    if not records:
+        print("No TIMING records found (build with LAGD_TIMING=1)")
+        sys.exit(1)
+
+    rows = summarise(records, args.by_job)
+    fields = ["n", "min_us", "mean_us", "p50_us", "p99_us", "max_us"]
+    print(f"{'job':>5} {'core':>4} {'phase':<8} " + " ".join(f"{f:>10}" for f in fields))
+    for r in rows:
+        job = "-" if r["job"] is None else str(r["job"])
+        print(f"{job:>5} {r['core']:>4} {r['phase']:<8} {r['n']:>10} " +
+              " ".join(f"{r[f]:>10.1f}" for f in fields[1:]))
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=["job", "core", "phase"] + fields)
+            writer.writeheader()
+            writer.writerows(rows)
+        print(f"Generated {args.csv}")
+
+
+if __name__ == "__main__":
+    main()
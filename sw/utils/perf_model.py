@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+# Copyright 2025 KU Leuven.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Author: Jiacong Sun <jiacong.sun@kuleuven.be>
+#
+# Cycle-approximate model of the digital_macro + analog_macro_wrap compute loop, for what-if
+# studies on SPIN_DEPTH, PARALLELISM, pipeline cuts and timing CSRs without RTL simulation.
+#
+# Each spin FIFO entry circulates flip_manager -> (analog macro) -> (flip_filter) ->
+# energy_monitor -> flip_manager. Every stage is a single server with an occupancy (cycles
+# before it accepts the next spin) and a latency (cycles until its output handshake), taken
+# from the module READMEs:
+#   flip_manager   : flip icon read 1 cycle, 3 cycles from energy handshake to next spin
+#   analog         : cycle_per_spin_compute + synchronizer_pipe_num + 1
+#   energy_monitor : NUM_SPIN/PARALLELISM + PIPESMID + 1 (+ PIPESINTF)
+#   flip_filter    : 4 + PIPESFLIPFILTER without change, 9 + PIPESFLIPFILTER + #addr otherwise
+# An iteration ends at each flip_manager upstream (energy) handshake, which is what
+# cycle_per_cmpt_and_iter.cc_iter measures on chip. The model can be calibrated against such a
+# log: --calibrate fits the remaining per-iteration offset (and, with flip detection, the
+# average number of J addresses per iteration) to the measured mean.
+# Usage: python3 perf_model.py [--spin-depth 2] [--parallelism 4] ... [--calibrate sim1.log]
+
+import re
+import sys
+import argparse
+from collections import deque
+from dataclasses import dataclass, fields, replace
+
+import lagd_stream
+
+# Same pattern as plot_cycle_per_iter.py
+CYCLE_LOG_PATTERN = re.compile(
+    r"idx/cmpt_idle/fm_rx_cnt_l7b/cc_iter/cc_cmpt for core \d+:\s+"
+    r"(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)"
+)
+
+FM_FLIP_READ_CYCLES = 1  # flip memory latency before spin_pop_valid_o
+FM_UPDATE_CYCLES = 3     # energy handshake to next spin out of flip_manager
+CMPT_START_CYCLES = 2    # cmpt_en to first spin FIFO valid
+CMPT_END_CYCLES = 2      # last energy handshake to cmpt_idle
+
+
+@dataclass
+class Config:
+    # design-time parameters (defaults as in lagd_pkg::IsingLogicCfg)
+    num_spin: int = 256
+    parallelism: int = 4
+    spin_depth: int = 2
+    pipes_intf: int = 1
+    pipes_mid: int = 1
+    pipes_flip_filter: int = 1
+    # runtime configuration (defaults as in sw/include/lagd_reg_params.h)
+    en_analog_loop: int = 1
+    enable_flip_detection: int = 1
+    cycle_per_spin_compute: int = 5
+    synchronizer_pipe_num: int = 3
+    icon_last_raddr_plus_one: int = 1024
+    cmpt_num: int = 1
+    # schedule/data dependent terms (fitted by --calibrate)
+    addr_per_iter: float = 8.0
+    iter_offset: float = 0.0
+
+
+def analog_latency(cfg):
+    return cfg.cycle_per_spin_compute + cfg.synchronizer_pipe_num + 1
+
+
+def energy_stage(cfg):
+    """Return (occupancy, latency) of the energy path for one spin."""
+    em_words = cfg.num_spin // cfg.parallelism
+    if cfg.enable_flip_detection:
+        if cfg.addr_per_iter <= 0:
+            lat = 4 + cfg.pipes_flip_filter
+        else:
+            lat = 9 + cfg.pipes_flip_filter + cfg.addr_per_iter
+        occ = max(1.0, cfg.addr_per_iter) + 1
+    else:
+        lat = em_words + cfg.pipes_mid + 1 + cfg.pipes_intf
+        occ = em_words + 1
+    return occ, lat + cfg.iter_offset
+
+
+def simulate(cfg):
+    """Run one or more computations; return (per-iteration cycles, cycles per computation)."""
+    e_occ, e_lat = energy_stage(cfg)
+    a_lat = analog_latency(cfg)
+    iter_cycles = []
+    cmpt_cycles = []
+    t0 = 0.0
+    last_hs = None
+    for _ in range(cfg.cmpt_num):
+        ready = deque([t0 + CMPT_START_CYCLES] * cfg.spin_depth)
+        pop_free = analog_free = energy_free = t0
+        hs_times = []
+        for _ in range(cfg.icon_last_raddr_plus_one):
+            t = max(ready.popleft(), pop_free) + FM_FLIP_READ_CYCLES
+            pop_free = t
+            if cfg.en_analog_loop:
+                t = max(t, analog_free)
+                analog_free = t + a_lat
+                t += a_lat
+            t = max(t, energy_free)
+            energy_free = t + e_occ
+            t += e_lat
+            hs_times.append(t)
+            ready.append(t + FM_UPDATE_CYCLES)
+        for hs in hs_times:
+            if last_hs is not None:
+                iter_cycles.append(hs - last_hs)
+            last_hs = hs
+        t_end = max(hs_times) + CMPT_END_CYCLES
+        cmpt_cycles.append(t_end - t0)
+        t0 = t_end
+    return iter_cycles, cmpt_cycles
+
+
+def mean(values):
+    return sum(values) / len(values) if values else 0.0
+
+
+def read_cycle_log(path, binary):
+    """Return (cc_iter, cc_cmpt) samples from a lagd_scompute log."""
+    samples = []
+    if binary:
+        for s in lagd_stream.cycle_log(lagd_stream.decode_file(path)):
+            samples.append((s["cc_iter"], s["cc_cmpt"]))
+    else:
+        with open(path) as f:
+            for line in f:
+                m = CYCLE_LOG_PATTERN.search(line)
+                if m:
+                    samples.append((int(m.group(4)), int(m.group(5))))
+    return samples
+
+
+def fit(cfg, target, name, lo, hi, steps=40):
+    """Bisect Config.<name> in [lo, hi] so that the mean cycles per iteration hits target."""
+    for _ in range(steps):
+        mid = (lo + hi) / 2
+        if mean(simulate(replace(cfg, **{name: mid}))[0]) < target:
+            lo = mid
+        else:
+            hi = mid
+    return replace(cfg, **{name: (lo + hi) / 2})
+
+
+def calibrate(cfg, path, binary):
+    samples = read_cycle_log(path, binary)
+    # drop zero/idle samples, the 7-bit iteration counter may also have saturated
+    cc_iter = [it for it, _ in samples if 0 < it < 127]
+    if not cc_iter:
+        print(f"No cycle_per_cmpt_and_iter samples found in {path}")
+        sys.exit(1)
+    target = mean(cc_iter)
+    print(f"Measured {len(cc_iter)} samples from {path}: {target:.2f} cycles/iteration")
+    if cfg.enable_flip_detection:
+        cfg = fit(cfg, target, "addr_per_iter", 0.0, float(cfg.num_spin // cfg.parallelism))
+    cfg = fit(cfg, target, "iter_offset", -target, target)
+    return cfg
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Cycle-approximate LAGD core pipeline model.")
+    for f in fields(Config):
+        parser.add_argument(
+            "--" + f.name.replace("_", "-"),
+            type=type(f.default),
+            default=f.default,
+            help=f"(default: {f.default})",
+        )
+    parser.add_argument("--calibrate", metavar="LOG", help="Fit the model to a cycle log")
+    parser.add_argument(
+        "--binary",
+        action="store_true",
+        help="The calibration log is a binary result stream (lagd_stream.h)",
+    )
+    args = parser.parse_args()
+    cfg = Config(**{f.name: getattr(args, f.name) for f in fields(Config)})
+
+    if args.calibrate:
+        cfg = calibrate(cfg, args.calibrate, args.binary)
+        print(f"Calibrated: --addr-per-iter {cfg.addr_per_iter:.2f}"
+              f" --iter-offset {cfg.iter_offset:.2f}")
+
+    iter_cycles, cmpt_cycles = simulate(cfg)
+    print(f"cycles/iteration : {mean(iter_cycles):.2f}"
+          f" (min {min(iter_cycles, default=0):.0f}, max {max(iter_cycles, default=0):.0f})")
+    print(f"cycles/cmpt      : {mean(cmpt_cycles):.0f}")
+    print(f"cycles total     : {sum(cmpt_cycles):.0f}")
+
+
+if __name__ == "__main__":
+    main()
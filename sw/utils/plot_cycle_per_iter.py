@@ -6,14 +6,25 @@
 # Author: Jiacong Sun <jiacong.sun@kuleuven.be>
 #
 # Parse a simulation/UART log file and plot cc_iter and cc_cmpt vs fm_rx_cnt_l7b.
-# Usage: python3 plot_cycle_per_iter.py [logfile]
+# Usage: python3 plot_cycle_per_iter.py [logfile] [--binary]
 
 import re
 import sys
+import argparse
 import matplotlib.pyplot as plt
 
+import lagd_stream
+
 # config
-LOG_FILE = sys.argv[1] if len(sys.argv) > 1 else "sim1.log"
+parser = argparse.ArgumentParser(description="Plot cc_iter and cc_cmpt vs fm_rx_cnt_l7b.")
+parser.add_argument("logfile", nargs="?", default="sim1.log", help="Log file to parse")
+parser.add_argument(
+    "--binary",
+    action="store_true",
+    help="Decode the binary result stream (lagd_stream.h) instead of printf text",
+)
+args = parser.parse_args()
+LOG_FILE = args.logfile
 
 # Matches lines like:
 #   # [UART] idx/cmpt_idle/fm_rx_cnt_l7b/cc_iter/cc_cmpt for core 1: 572 0 127 16 25043
@@ -25,20 +36,27 @@ PATTERN = re.compile(
 # parse
 fm_rx, cc_iter, cc_cmpt = [], [], []
 
+samples = []  # (fm_rx_cnt_l7b, cc_iter, cc_cmpt)
+if args.binary:
+    for s in lagd_stream.cycle_log(lagd_stream.decode_file(LOG_FILE)):
+        samples.append((s["fm_rx_cnt_l7b"], s["cc_iter"], s["cc_cmpt"]))
+else:
+    with open(LOG_FILE) as f:
+        for line in f:
+            m = PATTERN.search(line)
+            if m:
+                # idx, cmpt_idle, fm_rx_cnt_l7b, cc_iter, cc_cmpt
+                samples.append((int(m.group(3)), int(m.group(4)), int(m.group(5))))
+
 fm_offset = 0
 prev_fm_rx = 0
-with open(LOG_FILE) as f:
-    for line in f:
-        m = PATTERN.search(line)
-        if m:
-            curr_fm_rx = int(m.group(3))
-            if curr_fm_rx < prev_fm_rx:
-                fm_offset += 128  # fm_rx_cnt_l7b is 7-bit, so it wraps around after 127
-            prev_fm_rx = curr_fm_rx
-            # idx, cmpt_idle, fm_rx_cnt_l7b, cc_iter, cc_cmpt
-            fm_rx.append(curr_fm_rx + fm_offset)
-            cc_iter.append(int(m.group(4)))
-            cc_cmpt.append(int(m.group(5)))
+for curr_fm_rx, curr_cc_iter, curr_cc_cmpt in samples:
+    if curr_fm_rx < prev_fm_rx:
+        fm_offset += 128  # fm_rx_cnt_l7b is 7-bit, so it wraps around after 127
+    prev_fm_rx = curr_fm_rx
+    fm_rx.append(curr_fm_rx + fm_offset)
+    cc_iter.append(curr_cc_iter)
+    cc_cmpt.append(curr_cc_cmpt)
 
 if not fm_rx:
     print(f"No data found in {LOG_FILE}")
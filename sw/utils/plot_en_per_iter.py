@@ -6,7 +6,7 @@
 # Author: Jiacong Sun <jiacong.sun@kuleuven.be>
 #
 # Parse a simulation/UART log file and plot energy_fifo_data_sel vs fm_rx_cnt.
-# Usage: python3 plot_en_per_iter.py [logfile] [--parity odd|even]
+# Usage: python3 plot_en_per_iter.py [logfile] [--parity odd|even] [--binary]
 
 import re
 import sys
@@ -14,6 +14,8 @@ import argparse
 import math
 import matplotlib.pyplot as plt
 
+import lagd_stream
+
 # config
 parser = argparse.ArgumentParser(description="Plot energy_fifo_data_sel vs fm_rx_cnt.")
 parser.add_argument("logfile", nargs="?", default="sim1.log", help="Log file to parse")
@@ -23,6 +25,11 @@ parser.add_argument(
     default=None,
     help="Only plot samples where fm_rx_cnt is odd or even (default: plot all)",
 )
+parser.add_argument(
+    "--binary",
+    action="store_true",
+    help="Decode the binary result stream (lagd_stream.h) instead of printf text",
+)
 args = parser.parse_args()
 LOG_FILE = args.logfile
 
@@ -36,19 +43,26 @@ PATTERN = re.compile(
 # parse
 fm_rx, energy_fifo_data_sel = [], []
 
-with open(LOG_FILE) as f:
-    for line in f:
-        m = PATTERN.search(line)
-        if m:
-            curr_fm_rx = int(m.group(3))
-            if args.parity == "odd" and curr_fm_rx % 2 == 0:
-                continue
-            if args.parity == "even" and curr_fm_rx % 2 != 0:
-                continue
-            # idx, cmpt_idle, fm_rx_cnt, energy_fifo_data_sel
-            fm_rx.append(math.ceil(curr_fm_rx / 2) if args.parity else curr_fm_rx)
-            hex_val = int(m.group(4), 16)
-            energy_fifo_data_sel.append(hex_val if hex_val < 0x8000 else hex_val - 0x10000)
+samples = []  # (fm_rx_cnt, energy_fifo_data_sel)
+if args.binary:
+    for s in lagd_stream.energy_dbg_log(lagd_stream.decode_file(LOG_FILE)):
+        samples.append((s["fm_rx_cnt"], s["energy_fifo_data_sel"]))
+else:
+    with open(LOG_FILE) as f:
+        for line in f:
+            m = PATTERN.search(line)
+            if m:
+                # idx, cmpt_idle, fm_rx_cnt, energy_fifo_data_sel
+                hex_val = int(m.group(4), 16)
+                samples.append((int(m.group(3)), lagd_stream.to_signed(hex_val, 16)))
+
+for curr_fm_rx, energy in samples:
+    if args.parity == "odd" and curr_fm_rx % 2 == 0:
+        continue
+    if args.parity == "even" and curr_fm_rx % 2 != 0:
+        continue
+    fm_rx.append(math.ceil(curr_fm_rx / 2) if args.parity else curr_fm_rx)
+    energy_fifo_data_sel.append(energy)
 
 if not fm_rx:
     print(f"No data found in {LOG_FILE}")
@@ -24,6 +24,9 @@ def simulate_digital_macro_tb(
         FlipDisable: int = 1,
         EnableAnalogLoop: int = 1,
         MultiCmptModeEn: int = 1,
+        PipesMid: int = 1,
+        PipesJRead: int = 0,
+        PipesFlipEngine: int = 0,
         ) -> str:
     command = [
         "./ci/ut-run.sh",
@@ -31,7 +34,8 @@ def simulate_digital_macro_tb(
         "--clean",
         f"--defines=\"DataFromFile={DataFromFile} EnComparison={EnComparison} "
         f"EnableFlipDetection={EnableFlipDetection} FlipDisable={FlipDisable} "
-        f"EnableAnalogLoop={EnableAnalogLoop} MultiCmptModeEn={MultiCmptModeEn}\"",
+        f"EnableAnalogLoop={EnableAnalogLoop} MultiCmptModeEn={MultiCmptModeEn} "
+        f"PipesMid={PipesMid} PipesJRead={PipesJRead} PipesFlipEngine={PipesFlipEngine}\"",
         ]
     if show_terminal_output:
         print(f"Running command: {' '.join(command)} 2>&1 | tee {log_file}")
@@ -97,6 +101,9 @@ if __name__ == "__main__":
     FlipDisable_pool = [0, 1]
     EnableAnalogLoop_pool = [0, 1]
     MULTI_CMPT_MODE_EN_pool = [0, 1]
+    PipesMid_pool = [1, 3]
+    PipesJRead_pool = [0, 2]
+    PipesFlipEngine_pool = [0, 1]
     #############################
 
     msg_pool = []
@@ -107,6 +114,9 @@ if __name__ == "__main__":
         * len(FlipDisable_pool)
         * len(EnableAnalogLoop_pool)
         * len(MULTI_CMPT_MODE_EN_pool)
+        * len(PipesMid_pool)
+        * len(PipesJRead_pool)
+        * len(PipesFlipEngine_pool)
     )
     error_cases = 0
     pass_cases = 0
@@ -125,6 +135,9 @@ if __name__ == "__main__":
         FlipDisable,
         EnableAnalogLoop,
         MultiCmptModeEn,
+        PipesMid,
+        PipesJRead,
+        PipesFlipEngine,
     ) in itertools.product(
         DataFromFile_pool,
         EnComparison_pool,
@@ -132,10 +145,14 @@ if __name__ == "__main__":
         FlipDisable_pool,
         EnableAnalogLoop_pool,
         MULTI_CMPT_MODE_EN_pool,
+        PipesMid_pool,
+        PipesJRead_pool,
+        PipesFlipEngine_pool,
     ):
         test_mode_for_log = str(
             f"DF{DataFromFile}_EC{EnComparison}_EFD{EnableFlipDetection}"
             f"_FD{FlipDisable}_EAL{EnableAnalogLoop}_MCM{MultiCmptModeEn}"
+            f"_PM{PipesMid}_PJR{PipesJRead}_PFE{PipesFlipEngine}"
         )
         log_file_path = (
             f"{log_folder}/autotest_digital_macro_{test_mode_for_log}.log"
@@ -150,6 +167,9 @@ if __name__ == "__main__":
             FlipDisable=FlipDisable,
             EnableAnalogLoop=EnableAnalogLoop,
             MultiCmptModeEn=MultiCmptModeEn,
+            PipesMid=PipesMid,
+            PipesJRead=PipesJRead,
+            PipesFlipEngine=PipesFlipEngine,
         )
 
         (tests_passed, total_tests,
@@ -161,7 +181,8 @@ if __name__ == "__main__":
                     f"Error, case: DataFromFile={DataFromFile}, "
                     f"EnComparison={EnComparison}, EnableFlipDetection={EnableFlipDetection}, "
                     f"FlipDisable={FlipDisable}, EnableAnalogLoop={EnableAnalogLoop},"
-                    f"MultiCmptModeEn={MultiCmptModeEn}. "
+                    f"MultiCmptModeEn={MultiCmptModeEn}, PipesMid={PipesMid}, "
+                    f"PipesJRead={PipesJRead}, PipesFlipEngine={PipesFlipEngine}. "
                     f"Scoreboard: {tests_passed}/{total_tests} correct, "
                     f"{tests_failed}/{total_tests} errors. "
                     f"Check log file: {log_file_path}"
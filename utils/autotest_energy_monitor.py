@@ -76,8 +76,8 @@ if __name__ == "__main__":
         "'b101",
         "'b110",
     ]
-    pipesintf_pool = [1]
-    pipesmid_pool = [1]
+    pipesintf_pool = [0, 1, 2]
+    pipesmid_pool = [0, 1, 2, 4]
     num_tests_pool = [100]
     random_test_num = 10000
     #############################